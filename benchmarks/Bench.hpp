@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/*
+    Tiny helpers shared by the benchmarks. Every benchmark pits the previous implementation of a hot path
+    against the current one. Where the current one builds on its own, the real source from src/ is compiled, see CMakeLists.txt.
+    The rest is mirrored over stand-in types, so it builds without the compositor's dependencies.
+    When changing the mirrored code in src/, change the benchmark's copy too.
+*/
+namespace Bench {
+    // results go through here so the compiler can't drop the work that produced them
+    inline volatile uint64_t sink = 0;
+
+    template <typename T>
+    void keep(const T& value) {
+        sink = sink + (uint64_t)(int64_t)value;
+    }
+
+    // runs fn over and over for at least minTime, returns ns per call, best of a few rounds
+    template <typename F>
+    double nsPerCall(F&& fn, std::chrono::milliseconds minTime = std::chrono::milliseconds(200)) {
+        double best = 0;
+
+        for (int round = 0; round < 5; ++round) {
+            uint64_t   calls = 0;
+            const auto BEGIN = std::chrono::steady_clock::now();
+            auto       now   = BEGIN;
+
+            while (now - BEGIN < minTime / 5) {
+                for (int i = 0; i < 64; ++i) {
+                    fn();
+                }
+
+                calls += 64;
+                now = std::chrono::steady_clock::now();
+            }
+
+            const double NS = std::chrono::duration_cast<std::chrono::nanoseconds>(now - BEGIN).count() / (double)calls;
+            if (round == 0 || NS < best)
+                best = NS;
+        }
+
+        return best;
+    }
+
+    // for work that can't simply be repeated: setup runs untimed before each of the runs of fn. Returns the best ns per run.
+    template <typename S, typename F>
+    double nsPerRun(S&& setup, F&& fn, int runs = 50) {
+        double best = 0;
+
+        for (int run = 0; run < runs; ++run) {
+            setup();
+
+            const auto BEGIN = std::chrono::steady_clock::now();
+            fn();
+            const double NS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - BEGIN).count();
+
+            if (run == 0 || NS < best)
+                best = NS;
+        }
+
+        return best;
+    }
+
+    inline void row(const std::string& name, double before, double after) {
+        std::printf("%-40s %12.1f ns %12.1f ns %8.2fx\n", name.c_str(), before, after, before / after);
+    }
+
+    inline void header(const std::string& name) {
+        std::printf("%-40s %15s %15s %9s\n", name.c_str(), "before", "after", "speedup");
+    }
+};
@@ -0,0 +1,764 @@
+#include "Bench.hpp"
+#include "helpers/BezierCurve.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/*
+    CAnimationManager::tick (src/managers/AnimationManager.cpp), before and after ticking typed lanes with pre-resolved beziers.
+    Times a tick with about 1k variables animating at once, and a tick where all of them end.
+    Damage, decorations and monitors are stand-ins that only count calls, the same in both versions,
+    so what's left is the manager's own work: the active list, clocks, bezier lookups, type dispatch and walking workspace windows.
+    The curves and vectors are the real ones, built from src/helpers.
+*/
+
+struct CColor {
+    float r = 0, g = 0, b = 0, a = 0;
+
+    CColor operator+(const CColor& other) const {
+        return {r + other.r, g + other.g, b + other.b, a + other.a};
+    }
+    CColor operator-(const CColor& other) const {
+        return {r - other.r, g - other.g, b - other.b, a - other.a};
+    }
+    CColor operator*(float scale) const {
+        return {r * scale, g * scale, b * scale, a * scale};
+    }
+    bool operator==(const CColor& other) const {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+};
+
+enum ANIMATEDVARTYPE {
+    AVARTYPE_FLOAT,
+    AVARTYPE_VECTOR,
+    AVARTYPE_COLOR
+};
+
+template <class T>
+constexpr ANIMATEDVARTYPE typeToANIMATEDVARTYPE = std::is_same_v<T, float> ? AVARTYPE_FLOAT : (std::is_same_v<T, Vector2D> ? AVARTYPE_VECTOR : AVARTYPE_COLOR);
+
+enum AVARDAMAGEPOLICY {
+    AVARDAMAGE_ENTIRE = 0,
+    AVARDAMAGE_BORDER,
+    AVARDAMAGE_SHADOW
+};
+
+struct SAnimationPropertyConfig {
+    std::string               internalBezier      = "";
+    float                     internalSpeed       = 0.f;
+    int                       internalEnabled     = 1;
+    SAnimationPropertyConfig* pValues             = this;
+    size_t                    internalBezierIndex = 0;
+};
+
+// calls into the rest of the compositor, counted instead of done
+inline uint64_t g_iCalls = 0;
+
+class CWorkspace {
+  public:
+    int64_t m_iID                 = 0;
+    bool    m_bIsSpecialWorkspace = false;
+};
+
+class CBaseAnimatedVariable;
+
+class CWindow {
+  public:
+    std::shared_ptr<CWorkspace> m_pWorkspace;
+    bool                        m_bIsMapped   = true;
+    bool                        m_bIsFloating = false;
+    bool                        m_bPinned     = false;
+    int                         m_iMonitorID  = 0;
+
+    bool isHidden() {
+        return false;
+    }
+    void updateWindowDecos() {
+        g_iCalls++;
+    }
+};
+
+typedef std::shared_ptr<CWindow>    PHLWINDOW;
+typedef std::weak_ptr<CWindow>      PHLWINDOWREF;
+typedef std::shared_ptr<CWorkspace> PHLWORKSPACE;
+
+static bool validMapped(const PHLWINDOW& w) {
+    return w && w->m_bIsMapped;
+}
+
+static void damageWindow(const PHLWINDOW& w, bool forceFull = false) {
+    g_iCalls++;
+}
+
+static void damageWindows(const std::vector<PHLWINDOW>& windows, bool forceFull = false) {
+    g_iCalls += windows.size();
+}
+
+static void damageDecoration(const PHLWINDOW& w) {
+    g_iCalls++;
+}
+
+struct CMonitor {
+    int m_iID = 0;
+};
+
+class CAnimationManagerBase {
+  public:
+    virtual ~CAnimationManagerBase() = default;
+    virtual void addActiveVariable(CBaseAnimatedVariable*)    = 0;
+    virtual void removeActiveVariable(CBaseAnimatedVariable*) = 0;
+};
+
+class CBaseAnimatedVariable {
+  public:
+    CBaseAnimatedVariable(ANIMATEDVARTYPE type) : m_Type(type) {
+        ;
+    }
+    virtual ~CBaseAnimatedVariable() = default;
+
+    void create(CAnimationManagerBase* pManager, SAnimationPropertyConfig* pAnimConfig, PHLWINDOW pWindow, AVARDAMAGEPOLICY policy) {
+        m_pManager      = pManager;
+        m_pConfig       = pAnimConfig;
+        m_pWindow       = pWindow;
+        m_eDamagePolicy = policy;
+    }
+
+    void create(CAnimationManagerBase* pManager, SAnimationPropertyConfig* pAnimConfig, PHLWORKSPACE pWorkspace, AVARDAMAGEPOLICY policy) {
+        m_pManager      = pManager;
+        m_pConfig       = pAnimConfig;
+        m_pWorkspace    = pWorkspace;
+        m_eDamagePolicy = policy;
+    }
+
+    virtual void warp(bool endCallback = true) = 0;
+
+    float getPercent() {
+        return getPercent(std::chrono::system_clock::now());
+    }
+
+    float getPercent(const std::chrono::system_clock::time_point& now) {
+        const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(now - animationBegin).count();
+        return std::clamp((DURATIONPASSED / 100.f) / m_pConfig->pValues->internalSpeed, 0.f, 1.f);
+    }
+
+    bool isBeingAnimated() {
+        return m_bIsBeingAnimated;
+    }
+
+    void onAnimationEnd() {
+        m_bIsBeingAnimated = false;
+        disconnectFromActive();
+    }
+
+    void connectToActive() {
+        if (!m_bIsConnectedToActive)
+            m_pManager->addActiveVariable(this);
+
+        m_bIsConnectedToActive = true;
+    }
+
+    void disconnectFromActive() {
+        if (m_bIsConnectedToActive)
+            m_pManager->removeActiveVariable(this);
+
+        m_bIsConnectedToActive = false;
+    }
+
+    ANIMATEDVARTYPE                       m_Type;
+    AVARDAMAGEPOLICY                      m_eDamagePolicy = AVARDAMAGE_ENTIRE;
+    SAnimationPropertyConfig*             m_pConfig       = nullptr;
+    CAnimationManagerBase*                m_pManager      = nullptr;
+    PHLWINDOWREF                          m_pWindow;
+    std::weak_ptr<CWorkspace>             m_pWorkspace;
+    std::chrono::system_clock::time_point animationBegin;
+    bool                                  m_bIsBeingAnimated     = false;
+    bool                                  m_bIsConnectedToActive = false;
+    size_t                                m_iActiveIndex         = 0;
+};
+
+template <class VarType>
+class CAnimatedVariable : public CBaseAnimatedVariable {
+  public:
+    CAnimatedVariable() : CBaseAnimatedVariable(typeToANIMATEDVARTYPE<VarType>) {
+        ;
+    }
+
+    void warp(bool endCallback = true) override {
+        if (!m_bIsBeingAnimated)
+            return;
+
+        m_Value            = m_Goal;
+        m_bIsBeingAnimated = false;
+
+        if (endCallback)
+            onAnimationEnd();
+    }
+
+    void animateTo(const VarType& goal, const std::chrono::system_clock::time_point& begin) {
+        m_Begun            = m_Value;
+        m_Goal             = goal;
+        animationBegin     = begin;
+        m_bIsBeingAnimated = true;
+        connectToActive();
+    }
+
+    VarType m_Value{};
+    VarType m_Goal{};
+    VarType m_Begun{};
+};
+
+// what a window and a workspace animate
+struct SWindowVars {
+    CAnimatedVariable<Vector2D> realPosition, realSize;
+    CAnimatedVariable<float>    alpha;
+    CAnimatedVariable<CColor>   borderColor, shadowColor;
+};
+
+struct SWorkspaceVars {
+    CAnimatedVariable<Vector2D> renderOffset;
+    CAnimatedVariable<float>    alpha;
+};
+
+// the compositor's windows and workspaces, with its window index by workspace
+struct SWorld {
+    std::vector<PHLWINDOW>                                 m_vWindows;
+    std::vector<PHLWORKSPACE>                              m_vWorkspaces;
+    std::unordered_map<int64_t, std::vector<PHLWINDOWREF>> m_mWindowsByWorkspace;
+    CMonitor                                               m_monitor;
+
+    CMonitor* getMonitorFromID(int id) {
+        return &m_monitor;
+    }
+
+    bool isWorkspaceVisible(const PHLWORKSPACE& ws) {
+        return ws->m_iID == 1;
+    }
+
+    const std::vector<PHLWINDOWREF>& getWindowsOnWorkspaceID(int64_t id) {
+        static const std::vector<PHLWINDOWREF> EMPTY;
+
+        const auto                             IT = m_mWindowsByWorkspace.find(id);
+        return IT == m_mWindowsByWorkspace.end() ? EMPTY : IT->second;
+    }
+
+    void scheduleFrameForMonitor(CMonitor* pMonitor) {
+        g_iCalls++;
+    }
+};
+
+// one list of active variables, a bezier looked up by name per variable and step
+class CBaselineAnimationManager : public CAnimationManagerBase {
+  public:
+    CBaselineAnimationManager(SWorld* world) : m_pWorld(world) {
+        ;
+    }
+
+    void addBezierWithName(std::string name, const Vector2D& p1, const Vector2D& p2) {
+        std::vector points = {p1, p2};
+        m_mBezierCurves[name].setup(&points);
+    }
+
+    void addActiveVariable(CBaseAnimatedVariable* av) override {
+        m_vActiveAnimatedVariables.push_back(av);
+    }
+
+    void removeActiveVariable(CBaseAnimatedVariable* av) override {
+        std::erase_if(m_vActiveAnimatedVariables, [&](const auto& other) { return other == av; });
+    }
+
+    size_t activeCount() {
+        return m_vActiveAnimatedVariables.size();
+    }
+
+    void tick() {
+        if (m_vActiveAnimatedVariables.empty())
+            return;
+
+        bool                                animGlobalDisabled = false;
+
+        const auto                          DEFAULTBEZIER = m_mBezierCurves.find("default");
+
+        std::vector<CBaseAnimatedVariable*> animationEndedVars;
+
+        for (auto& av : m_vActiveAnimatedVariables) {
+            const float  SPENT = av->getPercent();
+
+            PHLWINDOW    PWINDOW            = av->m_pWindow.lock();
+            PHLWORKSPACE PWORKSPACE         = av->m_pWorkspace.lock();
+            CMonitor*    PMONITOR           = nullptr;
+            bool         animationsDisabled = animGlobalDisabled;
+
+            if (PWINDOW) {
+                if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
+                    damageWindow(PWINDOW);
+                else
+                    damageDecoration(PWINDOW);
+
+                PMONITOR = m_pWorld->getMonitorFromID(PWINDOW->m_iMonitorID);
+                if (!PMONITOR)
+                    continue;
+            } else if (PWORKSPACE) {
+                PMONITOR = m_pWorld->getMonitorFromID(0);
+                if (!PMONITOR)
+                    continue;
+
+                for (auto& w : m_pWorld->m_vWindows) {
+                    if (!w->m_bIsMapped || w->isHidden() || w->m_pWorkspace != PWORKSPACE)
+                        continue;
+
+                    if (w->m_bIsFloating && !w->m_bPinned)
+                        damageWindow(w, true);
+
+                    if (PWORKSPACE->m_bIsSpecialWorkspace)
+                        damageWindow(w, true);
+                }
+
+                for (auto& w : m_pWorld->m_vWindows) {
+                    if (!validMapped(w) || w->m_pWorkspace != PWORKSPACE || w->m_bPinned)
+                        continue;
+
+                    damageWindow(w);
+                }
+            }
+
+            const bool VISIBLE = PWINDOW && PWINDOW->m_pWorkspace ? m_pWorld->isWorkspaceVisible(PWINDOW->m_pWorkspace) : true;
+
+            auto       updateVariable = [&]<class T>(CAnimatedVariable<T>& av) {
+                if (av.m_pConfig->pValues->internalEnabled == 0 || animationsDisabled) {
+                    av.warp(false);
+                    return;
+                }
+
+                if (SPENT >= 1.f || av.m_Begun == av.m_Goal) {
+                    av.warp(false);
+                    return;
+                }
+
+                const auto DELTA  = av.m_Goal - av.m_Begun;
+                const auto BEZIER = m_mBezierCurves.find(av.m_pConfig->pValues->internalBezier);
+
+                if (BEZIER != m_mBezierCurves.end())
+                    av.m_Value = av.m_Begun + DELTA * BEZIER->second.getYForPoint(SPENT);
+                else
+                    av.m_Value = av.m_Begun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
+            };
+
+            switch (av->m_Type) {
+                case AVARTYPE_FLOAT: updateVariable(*static_cast<CAnimatedVariable<float>*>(av)); break;
+                case AVARTYPE_VECTOR: updateVariable(*static_cast<CAnimatedVariable<Vector2D>*>(av)); break;
+                case AVARTYPE_COLOR: updateVariable(*static_cast<CAnimatedVariable<CColor>*>(av)); break;
+            }
+
+            if (validMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
+                g_iCalls++; // setWindowSize
+
+            if (!av->isBeingAnimated())
+                animationEndedVars.push_back(av);
+
+            if (!VISIBLE)
+                continue;
+
+            if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE) {
+                if (PWINDOW) {
+                    PWINDOW->updateWindowDecos();
+                    damageWindow(PWINDOW);
+                } else if (PWORKSPACE) {
+                    for (auto& w : m_pWorld->m_vWindows) {
+                        if (!validMapped(w) || w->m_pWorkspace != PWORKSPACE)
+                            continue;
+
+                        w->updateWindowDecos();
+
+                        if (!w->m_bPinned)
+                            damageWindow(w);
+                    }
+                }
+            } else
+                damageDecoration(PWINDOW);
+
+            if (PMONITOR)
+                m_pWorld->scheduleFrameForMonitor(PMONITOR);
+        }
+
+        for (auto& ave : animationEndedVars) {
+            ave->onAnimationEnd();
+        }
+    }
+
+  private:
+    SWorld*                                       m_pWorld = nullptr;
+    std::vector<CBaseAnimatedVariable*>           m_vActiveAnimatedVariables;
+    std::unordered_map<std::string, CBezierCurve> m_mBezierCurves;
+};
+
+// one lane per type with swap-removal, beziers by index, workspaces damaged once per tick
+class CAnimationManager : public CAnimationManagerBase {
+  public:
+    CAnimationManager(SWorld* world) : m_pWorld(world) {
+        ;
+    }
+
+    void addBezierWithName(std::string name, const Vector2D& p1, const Vector2D& p2) {
+        std::vector points = {p1, p2};
+
+        const auto  IT = m_mBezierIndices.find(name);
+        if (IT != m_mBezierIndices.end()) {
+            m_vBezierCurves[IT->second].setup(&points);
+            return;
+        }
+
+        m_mBezierIndices[name] = m_vBezierCurves.size();
+        m_vBezierCurves.emplace_back().setup(&points);
+    }
+
+    size_t getBezierIndex(const std::string& name) {
+        const auto IT = m_mBezierIndices.find(name);
+        return IT == m_mBezierIndices.end() ? 0 : IT->second;
+    }
+
+    void addActiveVariable(CBaseAnimatedVariable* av) override {
+        auto& lane         = getActiveLane(av->m_Type);
+        av->m_iActiveIndex = lane.size();
+        lane.push_back(av);
+    }
+
+    void removeActiveVariable(CBaseAnimatedVariable* av) override {
+        auto& lane = getActiveLane(av->m_Type);
+
+        lane[av->m_iActiveIndex]                 = lane.back();
+        lane[av->m_iActiveIndex]->m_iActiveIndex = av->m_iActiveIndex;
+        lane.pop_back();
+    }
+
+    size_t activeCount() {
+        return m_sActiveAnimatedVariables.floats.size() + m_sActiveAnimatedVariables.vectors.size() + m_sActiveAnimatedVariables.colors.size();
+    }
+
+    void tick() {
+        if (activeCount() == 0)
+            return;
+
+        bool       animGlobalDisabled = false;
+
+        const auto NOW = std::chrono::system_clock::now();
+
+        m_vTickData.clear();
+        m_vTickEndedVars.clear();
+        m_vTickPreDamagedWorkspaces.clear();
+        m_vTickUpdatedWorkspaces.clear();
+
+        size_t laneBegin[3], laneEnd[3];
+        size_t lane = 0;
+        for (auto* vars : {&m_sActiveAnimatedVariables.floats, &m_sActiveAnimatedVariables.vectors, &m_sActiveAnimatedVariables.colors}) {
+            laneBegin[lane] = m_vTickData.size();
+
+            const size_t COUNT = vars->size();
+            for (size_t i = 0; i < COUNT && i < vars->size(); ++i) {
+                prepareVariable(vars->at(i), NOW, animGlobalDisabled);
+            }
+
+            laneEnd[lane++] = m_vTickData.size();
+        }
+
+        updateVariables<float>(laneBegin[0], laneEnd[0]);
+        updateVariables<Vector2D>(laneBegin[1], laneEnd[1]);
+        updateVariables<CColor>(laneBegin[2], laneEnd[2]);
+
+        for (auto& data : m_vTickData) {
+            finishVariable(data);
+        }
+
+        for (auto& ws : m_vTickUpdatedWorkspaces) {
+            updateWorkspace(ws);
+        }
+
+        for (auto& ave : m_vTickEndedVars) {
+            ave->onAnimationEnd();
+        }
+
+        m_vTickData.clear();
+        m_vTickPreDamagedWorkspaces.clear();
+        m_vTickUpdatedWorkspaces.clear();
+    }
+
+  private:
+    struct SAnimationTickData {
+        CBaseAnimatedVariable* av = nullptr;
+        PHLWINDOW              window;
+        PHLWORKSPACE           workspace;
+        CMonitor*              monitor            = nullptr;
+        bool                   animationsDisabled = false;
+        bool                   visible            = true;
+        float                  spent              = 0.f;
+    };
+
+    std::vector<CBaseAnimatedVariable*>& getActiveLane(ANIMATEDVARTYPE type) {
+        switch (type) {
+            case AVARTYPE_FLOAT: return m_sActiveAnimatedVariables.floats;
+            case AVARTYPE_VECTOR: return m_sActiveAnimatedVariables.vectors;
+            case AVARTYPE_COLOR: return m_sActiveAnimatedVariables.colors;
+        }
+
+        return m_sActiveAnimatedVariables.floats;
+    }
+
+    void prepareVariable(CBaseAnimatedVariable* av, const std::chrono::system_clock::time_point& now, bool animGlobalDisabled) {
+        SAnimationTickData data;
+        data.av                 = av;
+        data.animationsDisabled = animGlobalDisabled;
+        data.spent              = av->getPercent(now);
+
+        if ((data.window = av->m_pWindow.lock())) {
+            const auto PWINDOW = data.window;
+
+            if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
+                damageWindow(PWINDOW);
+            else
+                damageDecoration(PWINDOW);
+
+            data.monitor = m_pWorld->getMonitorFromID(PWINDOW->m_iMonitorID);
+            if (!data.monitor)
+                return;
+            data.visible = PWINDOW->m_pWorkspace ? m_pWorld->isWorkspaceVisible(PWINDOW->m_pWorkspace) : true;
+        } else if ((data.workspace = av->m_pWorkspace.lock())) {
+            const auto PWORKSPACE = data.workspace;
+
+            data.monitor = m_pWorld->getMonitorFromID(0);
+            if (!data.monitor)
+                return;
+
+            if (std::ranges::find(m_vTickPreDamagedWorkspaces, PWORKSPACE) == m_vTickPreDamagedWorkspaces.end()) {
+                m_vTickPreDamagedWorkspaces.emplace_back(PWORKSPACE);
+                preDamageWorkspace(PWORKSPACE, data.monitor);
+            }
+        }
+
+        m_vTickData.emplace_back(std::move(data));
+    }
+
+    void preDamageWorkspace(PHLWORKSPACE pWorkspace, CMonitor* pMonitor) {
+        std::vector<PHLWINDOW> forceDamage;
+        std::vector<PHLWINDOW> damage;
+
+        for (auto& ref : std::vector<PHLWINDOWREF>{m_pWorld->getWindowsOnWorkspaceID(pWorkspace->m_iID)}) {
+            const auto w = ref.lock();
+
+            if (!validMapped(w) || w->m_pWorkspace != pWorkspace)
+                continue;
+
+            if (!w->isHidden()) {
+                if (w->m_bIsFloating && !w->m_bPinned)
+                    forceDamage.emplace_back(w);
+
+                if (pWorkspace->m_bIsSpecialWorkspace)
+                    forceDamage.emplace_back(w);
+            }
+
+            if (!w->m_bPinned)
+                damage.emplace_back(w);
+        }
+
+        damageWindows(forceDamage, true);
+        damageWindows(damage);
+    }
+
+    void updateWorkspace(PHLWORKSPACE pWorkspace) {
+        std::vector<PHLWINDOW> damage;
+
+        for (auto& ref : std::vector<PHLWINDOWREF>{m_pWorld->getWindowsOnWorkspaceID(pWorkspace->m_iID)}) {
+            const auto w = ref.lock();
+
+            if (!validMapped(w) || w->m_pWorkspace != pWorkspace)
+                continue;
+
+            w->updateWindowDecos();
+
+            if (!w->m_bPinned)
+                damage.emplace_back(w);
+        }
+
+        damageWindows(damage);
+    }
+
+    template <class VarType>
+    void updateVariables(size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& DATA = m_vTickData[i];
+            auto&       av   = *static_cast<CAnimatedVariable<VarType>*>(DATA.av);
+
+            if (av.m_pConfig->pValues->internalEnabled == 0 || DATA.animationsDisabled) {
+                av.warp(false);
+                continue;
+            }
+
+            if (DATA.spent >= 1.f || av.m_Begun == av.m_Goal) {
+                av.warp(false);
+                continue;
+            }
+
+            const auto  BEZIERINDEX = av.m_pConfig->pValues->internalBezierIndex;
+            auto&       BEZIER      = BEZIERINDEX < m_vBezierCurves.size() ? m_vBezierCurves[BEZIERINDEX] : m_vBezierCurves[0];
+
+            const auto  DELTA = av.m_Goal - av.m_Begun;
+            av.m_Value        = av.m_Begun + DELTA * BEZIER.getYForPoint(DATA.spent);
+        }
+    }
+
+    void finishVariable(SAnimationTickData& data) {
+        const auto av         = data.av;
+        const auto PWINDOW    = data.window;
+        const auto PWORKSPACE = data.workspace;
+
+        if (validMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
+            g_iCalls++; // setWindowSize
+
+        if (!av->isBeingAnimated())
+            m_vTickEndedVars.push_back(av);
+
+        if (!data.visible)
+            return;
+
+        if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE) {
+            if (PWINDOW) {
+                PWINDOW->updateWindowDecos();
+                damageWindow(PWINDOW);
+            } else if (PWORKSPACE) {
+                if (std::ranges::find(m_vTickUpdatedWorkspaces, PWORKSPACE) == m_vTickUpdatedWorkspaces.end())
+                    m_vTickUpdatedWorkspaces.emplace_back(PWORKSPACE);
+            }
+        } else
+            damageDecoration(PWINDOW);
+
+        if (data.monitor)
+            m_pWorld->scheduleFrameForMonitor(data.monitor);
+    }
+
+    SWorld* m_pWorld = nullptr;
+
+    struct {
+        std::vector<CBaseAnimatedVariable*> floats;
+        std::vector<CBaseAnimatedVariable*> vectors;
+        std::vector<CBaseAnimatedVariable*> colors;
+    } m_sActiveAnimatedVariables;
+
+    std::vector<CBezierCurve>               m_vBezierCurves;
+    std::unordered_map<std::string, size_t> m_mBezierIndices;
+
+    std::vector<SAnimationTickData>         m_vTickData;
+    std::vector<CBaseAnimatedVariable*>     m_vTickEndedVars;
+    std::vector<PHLWORKSPACE>               m_vTickPreDamagedWorkspaces;
+    std::vector<PHLWORKSPACE>               m_vTickUpdatedWorkspaces;
+};
+
+constexpr int WORKSPACES = 10, WINDOWSPERWORKSPACE = 20;
+
+// 200 windows with five variables each and 10 workspaces with two, 1020 variables
+template <class Manager>
+struct SScene {
+    SWorld                                       world;
+    Manager                                      manager{&world};
+
+    std::vector<SAnimationPropertyConfig>        configs;
+    std::vector<std::unique_ptr<SWindowVars>>    windowVars;
+    std::vector<std::unique_ptr<SWorkspaceVars>> workspaceVars;
+
+    SScene() {
+        manager.addBezierWithName("default", {0, 0.75}, {0.15, 1});
+        manager.addBezierWithName("overshot", {0.05, 0.9}, {0.1, 1.1});
+        manager.addBezierWithName("smoothOut", {0.36, 0}, {0.66, -0.56});
+        manager.addBezierWithName("smoothIn", {0.25, 1}, {0.5, 1});
+
+        // windows, fade, border, workspaces. Unknown curve names go to the default one.
+        configs = {{.internalBezier = "overshot"}, {.internalBezier = "smoothIn"}, {.internalBezier = "linear"}, {.internalBezier = "default"}};
+        for (auto& c : configs) {
+            c.pValues = &c;
+            if constexpr (std::is_same_v<Manager, CAnimationManager>)
+                c.internalBezierIndex = manager.getBezierIndex(c.internalBezier);
+        }
+
+        for (int ws = 1; ws <= WORKSPACES; ++ws) {
+            const auto PWORKSPACE = world.m_vWorkspaces.emplace_back(std::make_shared<CWorkspace>(ws));
+            auto&      vars       = workspaceVars.emplace_back(std::make_unique<SWorkspaceVars>());
+            vars->renderOffset.create(&manager, &configs[3], PWORKSPACE, AVARDAMAGE_ENTIRE);
+            vars->alpha.create(&manager, &configs[1], PWORKSPACE, AVARDAMAGE_ENTIRE);
+
+            for (int i = 0; i < WINDOWSPERWORKSPACE; ++i) {
+                const auto PWINDOW = world.m_vWindows.emplace_back(std::make_shared<CWindow>(PWORKSPACE));
+                world.m_mWindowsByWorkspace[ws].emplace_back(PWINDOW);
+
+                auto& w = windowVars.emplace_back(std::make_unique<SWindowVars>());
+                w->realPosition.create(&manager, &configs[0], PWINDOW, AVARDAMAGE_ENTIRE);
+                w->realSize.create(&manager, &configs[0], PWINDOW, AVARDAMAGE_ENTIRE);
+                w->alpha.create(&manager, &configs[1], PWINDOW, AVARDAMAGE_ENTIRE);
+                w->borderColor.create(&manager, &configs[2], PWINDOW, AVARDAMAGE_BORDER);
+                w->shadowColor.create(&manager, &configs[1], PWINDOW, AVARDAMAGE_SHADOW);
+            }
+        }
+    }
+
+    // starts everything, speed in 100ms like the config, begin that far in the past
+    void animateAll(float speed, std::chrono::milliseconds ago) {
+        for (auto& c : configs) {
+            c.internalSpeed = speed;
+        }
+
+        const auto BEGIN = std::chrono::system_clock::now() - ago;
+        const auto FLIP  = windowVars[0]->alpha.m_Value == 0.f;
+
+        for (auto& w : windowVars) {
+            w->realPosition.animateTo(FLIP ? Vector2D{100, 100} : Vector2D{}, BEGIN);
+            w->realSize.animateTo(FLIP ? Vector2D{800, 600} : Vector2D{}, BEGIN);
+            w->alpha.animateTo(FLIP ? 1.f : 0.f, BEGIN);
+            w->borderColor.animateTo(FLIP ? CColor{1, 1, 1, 1} : CColor{}, BEGIN);
+            w->shadowColor.animateTo(FLIP ? CColor{0, 0, 0, 1} : CColor{}, BEGIN);
+        }
+
+        for (auto& ws : workspaceVars) {
+            ws->renderOffset.animateTo(FLIP ? Vector2D{1920, 0} : Vector2D{}, BEGIN);
+            ws->alpha.animateTo(FLIP ? 1.f : 0.f, BEGIN);
+        }
+    }
+
+    bool allAtGoal() {
+        for (auto& w : windowVars) {
+            if (!(w->realPosition.m_Value == w->realPosition.m_Goal) || w->alpha.m_Value != w->alpha.m_Goal || !(w->borderColor.m_Value == w->borderColor.m_Goal))
+                return false;
+        }
+
+        return manager.activeCount() == 0;
+    }
+};
+
+int main() {
+    SScene<CBaselineAnimationManager> baseline;
+    SScene<CAnimationManager>         current;
+
+    const size_t                      VARS = WORKSPACES * (2 + WINDOWSPERWORKSPACE * 5);
+
+    Bench::header("tick, " + std::to_string(VARS) + " variables");
+
+    // halfway through an animation that's long enough not to end while measuring
+    baseline.animateAll(100000, std::chrono::milliseconds(5000000));
+    current.animateAll(100000, std::chrono::milliseconds(5000000));
+
+    Bench::row("animating", Bench::nsPerCall([&] { baseline.manager.tick(); }), Bench::nsPerCall([&] { current.manager.tick(); }));
+
+    // all of them ended by the time of the tick, they warp and leave the active list
+    const auto BEFORE = Bench::nsPerRun([&] { baseline.animateAll(7, std::chrono::milliseconds(1000)); }, [&] { baseline.manager.tick(); });
+    const auto AFTER  = Bench::nsPerRun([&] { current.animateAll(7, std::chrono::milliseconds(1000)); }, [&] { current.manager.tick(); });
+
+    if (!baseline.allAtGoal() || !current.allAtGoal()) {
+        std::printf("animations didn't end in a single tick!\n");
+        return 1;
+    }
+
+    Bench::row("all ending", BEFORE, AFTER);
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "Bench.hpp"
+#include "helpers/BezierCurve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+/*
+    CBezierCurve::getYForPoint (src/helpers/BezierCurve.cpp), before and after the uniform x table with newton refinement.
+    The current version is the real one, built from src/helpers.
+    Reports the max error of both against a double precision reference, and the time per evaluation.
+*/
+
+// binary search over (x, y) baked at even t, linear interpolation in between
+class CBaselineBezierCurve {
+  public:
+    void setup(const Vector2D& p1, const Vector2D& p2) {
+        m_dPoints = {Vector2D(0, 0), p1, p2, Vector2D(1, 1)};
+
+        for (int i = 0; i < BAKEDPOINTS; ++i) {
+            m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
+        }
+    }
+
+    float getYForT(float t) {
+        return 3 * t * pow(1 - t, 2) * m_dPoints[1].y + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].y + pow(t, 3);
+    }
+
+    float getXForT(float t) {
+        return 3 * t * pow(1 - t, 2) * m_dPoints[1].x + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].x + pow(t, 3);
+    }
+
+    float getYForPoint(float x) {
+        if (x >= 1.f)
+            return 1.f;
+
+        int  index = 0;
+        bool below = true;
+        for (int step = (BAKEDPOINTS + 1) / 2; step > 0; step /= 2) {
+            if (below)
+                index += step;
+            else
+                index -= step;
+
+            below = m_aPointsBaked[index].x < x;
+        }
+
+        int        lowerIndex = index - (!below || index == BAKEDPOINTS - 1);
+
+        const auto LOWERPOINT = &m_aPointsBaked[lowerIndex];
+        const auto UPPERPOINT = &m_aPointsBaked[lowerIndex + 1];
+
+        const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+
+        if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA))
+            return 0.f;
+
+        return LOWERPOINT->y + (UPPERPOINT->y - LOWERPOINT->y) * PERCINDELTA;
+    }
+
+  private:
+    std::deque<Vector2D>              m_dPoints;
+    std::array<Vector2D, BAKEDPOINTS> m_aPointsBaked;
+};
+
+// y for x in double precision, bisecting the first crossing
+static double referenceYForX(const Vector2D& p1, const Vector2D& p2, double x) {
+    const auto AT = [](double a, double b, double t) { return 3 * t * (1 - t) * (1 - t) * a + 3 * t * t * (1 - t) * b + t * t * t; };
+
+    double     lower = 0, upper = 1;
+    for (int i = 0; i < 100; ++i) {
+        const double MID = (lower + upper) / 2;
+        if (AT(p1.x, p2.x, MID) < x)
+            lower = MID;
+        else
+            upper = MID;
+    }
+
+    return AT(p1.y, p2.y, (lower + upper) / 2);
+}
+
+struct SCurve {
+    const char* name;
+    Vector2D    p1, p2;
+};
+
+int main() {
+    // the default curve, then a few common ones from configs, overshooting ones included
+    const std::vector<SCurve> CURVES = {
+        {"default", {0, 0.75}, {0.15, 1}},         {"linear", {0, 0}, {1, 1}},          {"easeOutQuint", {0.23, 1}, {0.32, 1}},
+        {"easeInOutCubic", {0.65, 0.05}, {0.36, 1}}, {"overshot", {0.05, 0.9}, {0.1, 1.1}}, {"easeInBack", {0.36, 0}, {0.66, -0.56}},
+        {"easeInOutBack", {0.68, -0.6}, {0.32, 1.6}},
+    };
+
+    constexpr int             POINTS = 4096;
+
+    // the same pseudo random x values for everything, so the branch predictor can't learn the table walk
+    std::vector<float> xs(POINTS);
+    uint32_t           seed = 1;
+    for (auto& x : xs) {
+        seed = seed * 1664525 + 1013904223;
+        x    = (seed >> 8) / (float)(1 << 24);
+    }
+
+    std::printf("%-20s %14s %14s\n", "max error", "before", "after");
+
+    std::vector<CBaselineBezierCurve> baseline(CURVES.size());
+    std::vector<CBezierCurve>         current(CURVES.size());
+
+    for (size_t i = 0; i < CURVES.size(); ++i) {
+        baseline[i].setup(CURVES[i].p1, CURVES[i].p2);
+        std::vector points = {CURVES[i].p1, CURVES[i].p2};
+        current[i].setup(&points);
+
+        double errBefore = 0, errAfter = 0;
+        for (int j = 1; j < 100000; ++j) {
+            const float  X   = j / 100000.f;
+            const double REF = referenceYForX(CURVES[i].p1, CURVES[i].p2, X);
+            errBefore        = std::max(errBefore, std::abs(baseline[i].getYForPoint(X) - REF));
+            errAfter         = std::max(errAfter, std::abs(current[i].getYForPoint(X) - REF));
+        }
+
+        std::printf("%-20s %14.2e %14.2e\n", CURVES[i].name, errBefore, errAfter);
+    }
+
+    std::printf("\n");
+    Bench::header("getYForPoint, per evaluation");
+
+    for (size_t i = 0; i < CURVES.size(); ++i) {
+        size_t     next   = 0;
+        const auto BEFORE = Bench::nsPerCall([&] {
+            Bench::keep(baseline[i].getYForPoint(xs[next++ % POINTS]) * 1000);
+        });
+        next              = 0;
+        const auto AFTER  = Bench::nsPerCall([&] {
+            Bench::keep(current[i].getYForPoint(xs[next++ % POINTS]) * 1000);
+        });
+
+        Bench::row(CURVES[i].name, BEFORE, AFTER);
+    }
+
+    return 0;
+}
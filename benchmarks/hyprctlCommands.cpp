@@ -0,0 +1,335 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+    CHyprCtl::getReply and dispatchBatch (src/debug/HyprCtl.cpp), before and after indexing the registered commands:
+    exact ones in a hash map, prefix ones in a trie. Times a mix of 10k requests, batches included.
+    The commands only return their name, so what's timed is finding them, the same flag parsing in both versions included.
+*/
+
+enum eHyprCtlOutputFormat {
+    FORMAT_NORMAL = 0,
+    FORMAT_JSON
+};
+
+struct SHyprCtlCommand {
+    std::string                                                   name  = "";
+    bool                                                          exact = true;
+    std::function<std::string(eHyprCtlOutputFormat, std::string)> fn;
+};
+
+static std::string removeBeginEndSpacesTabs(std::string str) {
+    if (str.empty())
+        return str;
+
+    int countBefore = 0;
+    while (str[countBefore] == ' ' || str[countBefore] == '\t') {
+        countBefore++;
+    }
+
+    int countAfter = 0;
+    while ((int)str.length() - countAfter - 1 >= 0 && (str[str.length() - countAfter - 1] == ' ' || str[str.length() - 1 - countAfter] == '\t')) {
+        countAfter++;
+    }
+
+    str = str.substr(countBefore, str.length() - countBefore - countAfter);
+
+    return str;
+}
+
+class CHyprCtl {
+  public:
+    CHyprCtl(bool indexed) : m_bIndexed(indexed) {
+        ;
+    }
+
+    std::shared_ptr<SHyprCtlCommand> registerCommand(SHyprCtlCommand cmd) {
+        const auto PCMD = m_vCommands.emplace_back(std::make_shared<SHyprCtlCommand>(cmd));
+        rebuildCommandIndex();
+        return PCMD;
+    }
+
+    std::string getReply(std::string request) {
+        auto format = eHyprCtlOutputFormat::FORMAT_NORMAL;
+
+        if (!request.starts_with("[[BATCH]]") && request.contains("/")) {
+            long unsigned int sepIndex = 0;
+            for (const auto& c : request) {
+                if (c == '/')
+                    break;
+
+                if (c == ' ') {
+                    sepIndex = request.size();
+                    break;
+                }
+
+                sepIndex++;
+
+                if (c == 'j')
+                    format = eHyprCtlOutputFormat::FORMAT_JSON;
+            }
+
+            if (sepIndex < request.size())
+                request = request.substr(sepIndex + 1);
+        }
+
+        std::string result = "";
+
+        if (m_bIndexed) {
+            if (const auto EXACT = findExactCommand(request); EXACT)
+                result = EXACT->fn(format, request);
+
+            if (result.empty()) {
+                if (const auto PREFIX = findPrefixCommand(request); PREFIX)
+                    result = PREFIX->fn(format, request);
+            }
+        } else {
+            // the two scans over every command
+            for (auto& cmd : m_vCommands) {
+                if (!cmd->exact)
+                    continue;
+
+                if (cmd->name == request) {
+                    result = cmd->fn(format, request);
+                    break;
+                }
+            }
+
+            if (result.empty())
+                for (auto& cmd : m_vCommands) {
+                    if (cmd->exact)
+                        continue;
+
+                    if (request.starts_with(cmd->name)) {
+                        result = cmd->fn(format, request);
+                        break;
+                    }
+                }
+        }
+
+        if (result.empty())
+            return "unknown request";
+
+        return result;
+    }
+
+    std::string dispatchBatchBaseline(std::string request) {
+        request             = request.substr(9);
+        std::string curitem = "";
+        std::string reply   = "";
+
+        auto        nextItem = [&]() {
+            auto idx = request.find_first_of(';');
+
+            if (idx != std::string::npos) {
+                curitem = request.substr(0, idx);
+                request = request.substr(idx + 1);
+            } else {
+                curitem = request;
+                request = "";
+            }
+
+            curitem = removeBeginEndSpacesTabs(curitem);
+        };
+
+        nextItem();
+
+        while (curitem != "" || request != "") {
+            reply += getReply(curitem);
+
+            nextItem();
+        }
+
+        return reply;
+    }
+
+    std::string dispatchBatch(const std::string& request) {
+        std::string_view payload = std::string_view{request}.substr(9);
+        std::string      reply   = "";
+
+        while (!payload.empty()) {
+            const auto       IDX  = payload.find(';');
+            std::string_view item = payload.substr(0, IDX);
+            payload               = IDX == std::string_view::npos ? std::string_view{} : payload.substr(IDX + 1);
+
+            const auto       BEGIN = item.find_first_not_of(" \t");
+            if (BEGIN == std::string_view::npos) {
+                // like they always did, empty items only get a reply when more follows them
+                if (!payload.empty())
+                    reply += getReply("");
+                continue;
+            }
+
+            item = item.substr(BEGIN, item.find_last_not_of(" \t") - BEGIN + 1);
+
+            reply += getReply(std::string{item});
+        }
+
+        return reply;
+    }
+
+  private:
+    struct SCommandTrieNode {
+        std::unordered_map<char, std::unique_ptr<SCommandTrieNode>> children;
+        std::shared_ptr<SHyprCtlCommand>                            command;
+        size_t                                                      order = 0;
+    };
+
+    void rebuildCommandIndex() {
+        m_mExactCommands.clear();
+        m_sPrefixTrie = {};
+
+        for (size_t i = 0; i < m_vCommands.size(); ++i) {
+            const auto& CMD = m_vCommands[i];
+
+            if (CMD->exact) {
+                m_mExactCommands.emplace(CMD->name, CMD);
+                continue;
+            }
+
+            SCommandTrieNode* node = &m_sPrefixTrie;
+            for (const auto& c : CMD->name) {
+                auto& child = node->children[c];
+                if (!child)
+                    child = std::make_unique<SCommandTrieNode>();
+                node = child.get();
+            }
+
+            if (!node->command) {
+                node->command = CMD;
+                node->order   = i;
+            }
+        }
+    }
+
+    std::shared_ptr<SHyprCtlCommand> findExactCommand(const std::string& request) {
+        const auto IT = m_mExactCommands.find(request);
+        return IT == m_mExactCommands.end() ? nullptr : IT->second;
+    }
+
+    std::shared_ptr<SHyprCtlCommand> findPrefixCommand(const std::string& request) {
+        const SCommandTrieNode*          node      = &m_sPrefixTrie;
+        std::shared_ptr<SHyprCtlCommand> best      = node->command;
+        size_t                           bestOrder = node->command ? node->order : SIZE_MAX;
+
+        for (const auto& c : request) {
+            const auto IT = node->children.find(c);
+
+            if (IT == node->children.end())
+                break;
+
+            node = IT->second.get();
+
+            if (node->command && node->order < bestOrder) {
+                best      = node->command;
+                bestOrder = node->order;
+            }
+        }
+
+        return best;
+    }
+
+    bool                                                              m_bIndexed = false;
+    std::vector<std::shared_ptr<SHyprCtlCommand>>                     m_vCommands;
+    std::unordered_map<std::string, std::shared_ptr<SHyprCtlCommand>> m_mExactCommands;
+    SCommandTrieNode                                                  m_sPrefixTrie;
+};
+
+// the commands CHyprCtl registers, in the same order
+static const std::vector<std::pair<std::string, bool>> COMMANDS = {
+    {"workspaces", true},     {"workspacerules", true}, {"activeworkspace", true}, {"clients", true},       {"kill", true},          {"activewindow", true},
+    {"layers", true},         {"version", true},        {"devices", true},         {"splash", true},        {"cursorpos", true},     {"binds", true},
+    {"globalshortcuts", true}, {"systeminfo", true},    {"animations", true},      {"rollinglog", true},    {"layouts", true},       {"configerrors", true},
+    {"eventstats", true},     {"frametiming", true},    {"groupbarcache", true},   {"gpumemory", true},     {"reloadstats", true},   {"renderpass", true},
+    {"monitors", false},      {"reload", false},        {"plugin", false},         {"notify", false},       {"dismissnotify", false}, {"setprop", false},
+    {"seterror", false},      {"switchxkblayout", false}, {"output", false},       {"dispatch", false},     {"keyword", false},      {"setcursor", false},
+    {"getoption", false},     {"decorations", false},
+};
+
+static void registerCommands(CHyprCtl& ctl, bool indexed, size_t pluginCommands) {
+    for (auto& [name, exact] : COMMANDS) {
+        ctl.registerCommand(SHyprCtlCommand{name, exact, [name](eHyprCtlOutputFormat, std::string) { return name; }});
+    }
+
+    ctl.registerCommand(SHyprCtlCommand{"[[BATCH]]", false, [&ctl, indexed](eHyprCtlOutputFormat, std::string request) {
+                                            return indexed ? ctl.dispatchBatch(request) : ctl.dispatchBatchBaseline(request);
+                                        }});
+
+    // plugins register theirs after the builtin ones
+    for (size_t i = 0; i < pluginCommands; ++i) {
+        const auto NAME = "plugin" + std::to_string(i) + (i % 2 ? "cmd" : "query");
+        ctl.registerCommand(SHyprCtlCommand{NAME, i % 2 == 0, [NAME](eHyprCtlOutputFormat, std::string) { return NAME; }});
+    }
+}
+
+// what scripts and bars send: queries, often as json, dispatches and keywords, batches of them and the odd typo
+static std::vector<std::string> makeRequests(size_t count) {
+    static const std::vector<std::string> MIX = {
+        "j/clients",
+        "j/activewindow",
+        "j/workspaces",
+        "activeworkspace",
+        "j/monitors",
+        "monitors all",
+        "dispatch workspace 3",
+        "dispatch movefocus l",
+        "keyword general:gaps_in 5",
+        "getoption decoration:rounding",
+        "[[BATCH]]dispatch workspace 2; dispatch focuswindow class:kitty ; keyword animations:enabled 0",
+        "[[BATCH]]j/activewindow;j/activeworkspace;j/monitors",
+        "setprop active alpha 0.9",
+        "j/devices",
+        "notify 1 5000 0 hello",
+        "clinets",
+    };
+
+    std::vector<std::string> requests;
+    for (size_t i = 0; i < count; ++i) {
+        requests.emplace_back(MIX[(i * 7) % MIX.size()]);
+    }
+
+    return requests;
+}
+
+int main() {
+    Bench::header("getReply, 10k requests");
+
+    const auto REQUESTS = makeRequests(10000);
+
+    for (size_t plugins : {0, 50}) {
+        CHyprCtl baseline(false), indexed(true);
+        registerCommands(baseline, false, plugins);
+        registerCommands(indexed, true, plugins);
+
+        // both have to pick the same commands
+        for (auto& r : REQUESTS) {
+            if (baseline.getReply(r) != indexed.getReply(r)) {
+                std::printf("the two versions replied differently to %s!\n", r.c_str());
+                return 1;
+            }
+        }
+
+        const auto BEFORE = Bench::nsPerCall([&] {
+            for (auto& r : REQUESTS) {
+                Bench::keep(baseline.getReply(r).size());
+            }
+        });
+        const auto AFTER  = Bench::nsPerCall([&] {
+            for (auto& r : REQUESTS) {
+                Bench::keep(indexed.getReply(r).size());
+            }
+        });
+
+        Bench::row(std::to_string(COMMANDS.size() + 1 + plugins) + " commands", BEFORE, AFTER);
+    }
+
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <xkbcommon/xkbcommon.h>
+
+/*
+    CKeybindManager::handleKeybinds (src/managers/KeybindManager.cpp), before and after looking binds up by submap, mods and key.
+    Times a press and release of a mix of bound and unbound keys, with the dispatchers left out,
+    and checks that both versions pick the same binds.
+*/
+
+constexpr uint32_t MOD_SHIFT = 1 << 0, MOD_CTRL = 1 << 2, MOD_ALT = 1 << 3, MOD_LOGO = 1 << 6;
+
+struct SKeybind {
+    std::string  key          = "";
+    uint32_t     keycode      = 0;
+    bool         catchAll     = false;
+    uint32_t     modmask      = 0;
+    std::string  handler      = "";
+    std::string  arg          = "";
+    bool         locked       = false;
+    std::string  submap       = "";
+    bool         release      = false;
+    bool         nonConsuming = false;
+    bool         ignoreMods   = false;
+
+    bool         shadowed    = false;
+    xkb_keysym_t keysym      = 0;
+    xkb_keysym_t keysymUpper = 0;
+    uint64_t     order       = 0;
+};
+
+struct SPressedKeyWithMods {
+    std::string  keyName            = "";
+    xkb_keysym_t keysym             = 0;
+    uint32_t     keycode            = 0;
+    uint32_t     modmaskAtPressTime = 0;
+};
+
+// what a dispatcher call would have been, to compare the two versions
+struct SDispatch {
+    const SKeybind* bind;
+    bool            pressed;
+
+    bool            operator==(const SDispatch&) const = default;
+};
+
+class CKeybinds {
+  public:
+    void addKeybind(SKeybind kb) {
+        kb.order = m_iNextKeybindOrder++;
+
+        if (!kb.key.empty()) {
+            kb.keysym      = xkb_keysym_from_name(kb.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            kb.keysymUpper = xkb_keysym_to_upper(kb.keysym);
+        }
+
+        m_lKeybinds.push_back(kb);
+        m_bKeybindIndexDirty = true;
+    }
+
+    std::string            m_szCurrentSelectedSubmap = "";
+    std::vector<SDispatch> m_vDispatched;
+
+    // walks every bind, resolving each one's keysym on the way
+    bool handleKeybindsBaseline(const uint32_t modmask, const SPressedKeyWithMods& key, bool pressed) {
+        bool found = false;
+
+        for (auto& k : m_lKeybinds) {
+            const bool SPECIALDISPATCHER = k.handler == "global" || k.handler == "pass" || k.handler == "mouse";
+            const bool SPECIALTRIGGERED =
+                std::find_if(m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end(), [&](const auto& other) { return other == &k; }) != m_vPressedSpecialBinds.end();
+            const bool IGNORECONDITIONS = SPECIALDISPATCHER && !pressed && SPECIALTRIGGERED;
+
+            if (!IGNORECONDITIONS && ((modmask != k.modmask && !k.ignoreMods) || k.submap != m_szCurrentSelectedSubmap || k.shadowed))
+                continue;
+
+            if (!key.keyName.empty()) {
+                if (key.keyName != k.key)
+                    continue;
+            } else if (k.keycode != 0) {
+                if (key.keycode != k.keycode)
+                    continue;
+            } else if (k.catchAll) {
+                if (found)
+                    continue;
+            } else {
+                const auto KBKEY = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+
+                if (KBKEY == 0)
+                    continue;
+
+                const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
+
+                if (key.keysym != KBKEY && key.keysym != KBKEYUPPER)
+                    continue;
+            }
+
+            if (dispatch(k, modmask, key, pressed, SPECIALDISPATCHER, SPECIALTRIGGERED, found))
+                break;
+        }
+
+        return found;
+    }
+
+    // only the binds that can match, from the index
+    bool handleKeybinds(const uint32_t modmask, const SPressedKeyWithMods& key, bool pressed) {
+        bool found = false;
+
+        if (m_bKeybindIndexDirty)
+            rebuildKeybindIndex();
+
+        std::vector<SKeybind*> candidates;
+        if (const auto IT = m_mKeybindIndex.find(m_szCurrentSelectedSubmap); IT != m_mKeybindIndex.end()) {
+            if (const auto MODSIT = IT->second.mods.find(modmask); MODSIT != IT->second.mods.end())
+                collectKeybinds(MODSIT->second, key, candidates);
+
+            collectKeybinds(IT->second.ignoreMods, key, candidates);
+        }
+
+        if (!pressed)
+            candidates.insert(candidates.end(), m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end());
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a->order < b->order; });
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (auto& pKeybind : candidates) {
+            auto&      k                 = *pKeybind;
+            const bool SPECIALDISPATCHER = k.handler == "global" || k.handler == "pass" || k.handler == "mouse";
+            const bool SPECIALTRIGGERED =
+                std::find_if(m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end(), [&](const auto& other) { return other == &k; }) != m_vPressedSpecialBinds.end();
+            const bool IGNORECONDITIONS = SPECIALDISPATCHER && !pressed && SPECIALTRIGGERED;
+
+            if (!IGNORECONDITIONS && ((modmask != k.modmask && !k.ignoreMods) || k.submap != m_szCurrentSelectedSubmap || k.shadowed))
+                continue;
+
+            if (!key.keyName.empty()) {
+                if (key.keyName != k.key)
+                    continue;
+            } else if (k.keycode != 0) {
+                if (key.keycode != k.keycode)
+                    continue;
+            } else if (k.catchAll) {
+                if (found)
+                    continue;
+            } else {
+                if (k.keysym == 0)
+                    continue;
+
+                if (key.keysym != k.keysym && key.keysym != k.keysymUpper)
+                    continue;
+            }
+
+            if (dispatch(k, modmask, key, pressed, SPECIALDISPATCHER, SPECIALTRIGGERED, found))
+                break;
+        }
+
+        return found;
+    }
+
+  private:
+    static uint32_t keycodeToModifier(uint32_t keycode) {
+        switch (keycode - 8) {
+            case 125:
+            case 126: return MOD_LOGO;
+            case 42:
+            case 54: return MOD_SHIFT;
+            case 29:
+            case 97: return MOD_CTRL;
+            case 56:
+            case 100: return MOD_ALT;
+            default: return 0;
+        }
+    }
+
+    // the part after a bind matched, the same in both versions. Returns whether to stop looking.
+    bool dispatch(SKeybind& k, const uint32_t modmask, const SPressedKeyWithMods& key, bool pressed, bool specialDispatcher, bool specialTriggered, bool& found) {
+        if (pressed && k.release && !specialDispatcher) {
+            if (!k.nonConsuming)
+                found = true;
+            return false;
+        }
+
+        if (!pressed) {
+            if (key.modmaskAtPressTime != modmask && !k.ignoreMods) {
+                if (keycodeToModifier(key.keycode) == key.modmaskAtPressTime)
+                    return false;
+            } else if (!k.release && !specialDispatcher) {
+                if (!k.nonConsuming)
+                    found = true;
+                return false;
+            }
+        }
+
+        if (specialTriggered && !pressed)
+            std::erase_if(m_vPressedSpecialBinds, [&](const auto& other) { return other == &k; });
+        else if (specialDispatcher && pressed)
+            m_vPressedSpecialBinds.push_back(&k);
+
+        m_vDispatched.push_back({&k, pressed});
+
+        if (k.handler == "submap") {
+            m_szCurrentSelectedSubmap = k.arg == "reset" ? "" : k.arg;
+            found                     = true;
+            return true;
+        }
+
+        if (!k.nonConsuming)
+            found = true;
+
+        return false;
+    }
+
+    struct SKeybindLookup {
+        std::unordered_map<std::string, std::vector<SKeybind*>>  names;
+        std::unordered_map<xkb_keysym_t, std::vector<SKeybind*>> keysyms;
+        std::unordered_map<uint32_t, std::vector<SKeybind*>>     keycodes;
+        std::vector<SKeybind*>                                   catchAll;
+    };
+
+    struct SSubmapKeybinds {
+        std::unordered_map<uint32_t, SKeybindLookup> mods;
+        SKeybindLookup                               ignoreMods;
+    };
+
+    void rebuildKeybindIndex() {
+        m_mKeybindIndex.clear();
+
+        for (auto& k : m_lKeybinds) {
+            auto& submap = m_mKeybindIndex[k.submap];
+            auto& lookup = k.ignoreMods ? submap.ignoreMods : submap.mods[k.modmask];
+
+            if (k.keycode != 0)
+                lookup.keycodes[k.keycode].push_back(&k);
+            else if (k.catchAll)
+                lookup.catchAll.push_back(&k);
+            else {
+                lookup.names[k.key].push_back(&k);
+
+                if (k.keysym != 0) {
+                    lookup.keysyms[k.keysym].push_back(&k);
+                    if (k.keysymUpper != k.keysym)
+                        lookup.keysyms[k.keysymUpper].push_back(&k);
+                }
+            }
+        }
+
+        m_bKeybindIndexDirty = false;
+    }
+
+    void collectKeybinds(const SKeybindLookup& lookup, const SPressedKeyWithMods& key, std::vector<SKeybind*>& out) {
+        const auto APPEND = [&out](const auto& map, const auto& value) {
+            if (const auto IT = map.find(value); IT != map.end())
+                out.insert(out.end(), IT->second.begin(), IT->second.end());
+        };
+
+        if (!key.keyName.empty()) {
+            APPEND(lookup.names, key.keyName);
+            return;
+        }
+
+        APPEND(lookup.keycodes, key.keycode);
+        APPEND(lookup.keysyms, key.keysym);
+        out.insert(out.end(), lookup.catchAll.begin(), lookup.catchAll.end());
+    }
+
+    std::list<SKeybind>                              m_lKeybinds;
+    std::vector<SKeybind*>                           m_vPressedSpecialBinds;
+    std::unordered_map<std::string, SSubmapKeybinds> m_mKeybindIndex;
+    bool                                             m_bKeybindIndexDirty = true;
+    uint64_t                                         m_iNextKeybindOrder  = 0;
+};
+
+struct SEvent {
+    uint32_t            modmask;
+    SPressedKeyWithMods key;
+};
+
+// a typical config: workspaces, window management, media keys, mouse binds and a resize submap. Padded up to count with binds in other submaps.
+static void addConfigBinds(CKeybinds& binds, size_t count) {
+    const std::string LETTERS = "QWERTYUIOPASDFGHJKLZXCVBNM";
+    size_t            added   = 0;
+    const auto        ADD     = [&](SKeybind kb) {
+        binds.addKeybind(kb);
+        added++;
+    };
+
+    for (int i = 0; i <= 9; ++i) {
+        ADD({.key = std::to_string(i), .modmask = MOD_LOGO, .handler = "workspace", .arg = std::to_string(i)});
+        ADD({.key = std::to_string(i), .modmask = MOD_LOGO | MOD_SHIFT, .handler = "movetoworkspace", .arg = std::to_string(i)});
+    }
+
+    for (auto c : LETTERS) {
+        ADD({.key = std::string{c}, .modmask = MOD_LOGO, .handler = "exec", .arg = "app"});
+    }
+
+    for (auto dir : {"left", "right", "up", "down"}) {
+        ADD({.key = dir, .modmask = MOD_LOGO, .handler = "movefocus", .arg = dir});
+        ADD({.key = dir, .modmask = MOD_LOGO | MOD_SHIFT, .handler = "movewindow", .arg = dir});
+        ADD({.key = dir, .handler = "resizeactive", .arg = "10 10", .submap = "resize"});
+    }
+
+    for (auto media : {"XF86AudioRaiseVolume", "XF86AudioLowerVolume", "XF86AudioMute", "XF86AudioPlay", "XF86AudioNext", "XF86AudioPrev", "XF86MonBrightnessUp",
+                       "XF86MonBrightnessDown"}) {
+        ADD({.key = media, .handler = "exec", .arg = "media", .locked = true});
+    }
+
+    ADD({.key = "mouse:272", .modmask = MOD_LOGO, .handler = "mouse", .arg = "movewindow"});
+    ADD({.key = "mouse:273", .modmask = MOD_LOGO, .handler = "mouse", .arg = "resizewindow"});
+    ADD({.key = "mouse_down", .modmask = MOD_LOGO, .handler = "workspace", .arg = "e+1"});
+    ADD({.key = "mouse_up", .modmask = MOD_LOGO, .handler = "workspace", .arg = "e-1"});
+    ADD({.key = "switch:on:Lid Switch", .handler = "exec", .arg = "lock", .locked = true});
+    ADD({.key = "F10", .modmask = MOD_CTRL | MOD_SHIFT, .handler = "pass", .arg = "obs"});
+    ADD({.key = "Super_L", .modmask = MOD_LOGO, .handler = "exec", .arg = "launcher", .release = true});
+    ADD({.key = "R", .modmask = MOD_LOGO | MOD_ALT, .handler = "submap", .arg = "resize"});
+    ADD({.key = "escape", .handler = "submap", .arg = "reset", .submap = "resize"});
+
+    for (size_t i = 0; added < count; ++i) {
+        ADD({.key = std::string{LETTERS[i % LETTERS.size()]}, .handler = "exec", .arg = "padding", .submap = "padding" + std::to_string(i / LETTERS.size())});
+    }
+}
+
+// presses and releases, about a third of them hitting a bind
+static std::vector<SEvent> makeEvents() {
+    std::vector<SEvent> events;
+    const auto          KEY = [](const char* name) { return xkb_keysym_from_name(name, XKB_KEYSYM_CASE_INSENSITIVE); };
+
+    for (int i = 0; i < 64; ++i) {
+        const std::string TYPED = std::string{(char)('a' + i % 26)};
+        events.push_back({0, {.keysym = KEY(TYPED.c_str()), .keycode = (uint32_t)(30 + i % 26)}});
+        events.push_back({MOD_SHIFT, {.keysym = KEY(std::string{(char)('A' + i % 26)}.c_str()), .keycode = (uint32_t)(30 + i % 26)}});
+
+        if (i % 3 == 0)
+            events.push_back({MOD_LOGO, {.keysym = KEY(std::to_string(i % 10).c_str()), .keycode = (uint32_t)(2 + i % 10), .modmaskAtPressTime = MOD_LOGO}});
+        if (i % 4 == 0)
+            events.push_back({MOD_LOGO, {.keysym = KEY(TYPED.c_str()), .keycode = (uint32_t)(30 + i % 26), .modmaskAtPressTime = MOD_LOGO}});
+        if (i % 8 == 0)
+            events.push_back({MOD_LOGO, {.keyName = "mouse_down", .modmaskAtPressTime = MOD_LOGO}});
+        if (i % 16 == 0)
+            events.push_back({0, {.keysym = KEY("XF86AudioRaiseVolume"), .keycode = 123}});
+    }
+
+    return events;
+}
+
+int main() {
+    Bench::header("press + release");
+
+    for (size_t count : {100, 300, 1000}) {
+        CKeybinds baseline, current;
+        addConfigBinds(baseline, count);
+        addConfigBinds(current, count);
+
+        const auto EVENTS = makeEvents();
+
+        // both have to make the same dispatcher calls, the binds are added in the same order so they compare by position
+        for (auto& e : EVENTS) {
+            baseline.handleKeybindsBaseline(e.modmask, e.key, true);
+            baseline.handleKeybindsBaseline(e.modmask, e.key, false);
+            current.handleKeybinds(e.modmask, e.key, true);
+            current.handleKeybinds(e.modmask, e.key, false);
+        }
+
+        bool same = baseline.m_vDispatched.size() == current.m_vDispatched.size();
+        for (size_t i = 0; same && i < baseline.m_vDispatched.size(); ++i) {
+            same = baseline.m_vDispatched[i].bind->order == current.m_vDispatched[i].bind->order && baseline.m_vDispatched[i].pressed == current.m_vDispatched[i].pressed;
+        }
+
+        if (!same) {
+            std::printf("the two versions dispatched different binds with %zu binds!\n", count);
+            return 1;
+        }
+
+        size_t     next   = 0;
+        const auto BEFORE = Bench::nsPerCall([&] {
+            const auto& E = EVENTS[next++ % EVENTS.size()];
+            Bench::keep(baseline.handleKeybindsBaseline(E.modmask, E.key, true));
+            Bench::keep(baseline.handleKeybindsBaseline(E.modmask, E.key, false));
+            baseline.m_vDispatched.clear();
+        });
+        next              = 0;
+        const auto AFTER  = Bench::nsPerCall([&] {
+            const auto& E = EVENTS[next++ % EVENTS.size()];
+            Bench::keep(current.handleKeybinds(E.modmask, E.key, true));
+            Bench::keep(current.handleKeybinds(E.modmask, E.key, false));
+            current.m_vDispatched.clear();
+        });
+
+        Bench::row(std::to_string(count) + " binds", BEFORE, AFTER);
+    }
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+    The window passes of a frame in CHyprRenderer (src/render/Renderer.cpp), before and after walking only windows
+    of workspaces that can be on screen: collecting what renderWorkspaceWindows draws and sendFrameEventsToWorkspace.
+    Times a frame of two monitors with 20 visible windows, as the number of windows parked on hidden workspaces grows.
+    Drawing and frame events are stand-ins that only count calls, the same in both versions.
+*/
+
+inline uint64_t g_iCalls = 0;
+
+struct CBox {
+    double x = 0, y = 0, w = 0, h = 0;
+
+    bool   intersects(const CBox& other) const {
+        return x < other.x + other.w && other.x < x + w && y < other.y + other.h && other.y < y + h;
+    }
+};
+
+struct SWindowDecorationExtents {
+    double top = 0, left = 0, bottom = 0, right = 0;
+};
+
+class CWorkspace {
+  public:
+    int64_t m_iID                   = 0;
+    int     m_iMonitorID            = 0;
+    bool    m_bVisible              = false;
+    bool    m_bForceRendering       = false;
+    bool    m_bIsSpecialWorkspace   = false;
+    bool    m_bHasFullscreenWindow  = false;
+    bool    m_bRenderOffsetAnimated = false;
+    bool    m_bAlphaAnimated        = false;
+};
+
+typedef std::shared_ptr<CWorkspace> PHLWORKSPACE;
+
+class CWindow {
+  public:
+    PHLWORKSPACE                          m_pWorkspace;
+    int                                   m_iMonitorID = 0;
+    CBox                                  m_vRealBox;
+    std::vector<SWindowDecorationExtents> m_vDecorations           = {{2, 2, 2, 2}, {12, 12, 18, 12}}; // border, shadow
+    bool                                  m_bIsMapped              = true;
+    bool                                  m_bFadingOut             = false;
+    bool                                  m_bIsFloating            = false;
+    bool                                  m_bPinned                = false;
+    bool                                  m_bIsFullscreen          = false;
+    bool                                  m_bCreatedOverFullscreen = false;
+    float                                 m_fAlpha                 = 1.f;
+
+    bool                                  isHidden() {
+        return false;
+    }
+
+    bool onSpecialWorkspace() {
+        return m_pWorkspace && m_pWorkspace->m_bIsSpecialWorkspace;
+    }
+
+    int64_t workspaceID() {
+        return m_pWorkspace ? m_pWorkspace->m_iID : 0;
+    }
+
+    CBox getFullWindowBoundingBox() {
+        SWindowDecorationExtents max;
+        for (auto& e : m_vDecorations) {
+            max.top    = std::max(max.top, e.top);
+            max.left   = std::max(max.left, e.left);
+            max.bottom = std::max(max.bottom, e.bottom);
+            max.right  = std::max(max.right, e.right);
+        }
+
+        return {m_vRealBox.x - max.left, m_vRealBox.y - max.top, m_vRealBox.w + max.left + max.right, m_vRealBox.h + max.top + max.bottom};
+    }
+};
+
+typedef std::shared_ptr<CWindow> PHLWINDOW;
+typedef std::weak_ptr<CWindow>   PHLWINDOWREF;
+
+struct CMonitor {
+    int          ID = 0;
+    CBox         box;
+    PHLWORKSPACE activeWorkspace;
+    PHLWORKSPACE activeSpecialWorkspace;
+
+    int64_t      activeWorkspaceID() {
+        return activeWorkspace ? activeWorkspace->m_iID : 0;
+    }
+};
+
+enum eRenderPassMode {
+    RENDER_PASS_ALL = 0,
+    RENDER_PASS_MAIN,
+    RENDER_PASS_POPUP
+};
+
+struct SWindowDraw {
+    PHLWINDOW       window;
+    eRenderPassMode mode     = RENDER_PASS_ALL;
+    bool            decorate = true;
+};
+
+struct SIndexedWindows {
+    std::vector<PHLWINDOWREF> windows;
+    std::vector<size_t>       z;
+};
+
+// the compositor's windows, workspaces and monitors, with the window index
+class CScene {
+  public:
+    std::vector<PHLWINDOW>                       m_vWindows;
+    std::vector<PHLWORKSPACE>                    m_vWorkspaces;
+    std::vector<std::unique_ptr<CMonitor>>       m_vMonitors;
+    PHLWINDOW                                    m_pLastWindow;
+
+    std::unordered_map<int64_t, SIndexedWindows> m_mByWorkspace;
+    SIndexedWindows                              m_sPinned;
+
+    bool                                         isWorkspaceVisible(const PHLWORKSPACE& w) {
+        return w && w->m_bVisible;
+    }
+
+    void rebuildWindowIndex() {
+        m_mByWorkspace.clear();
+        m_sPinned = {};
+
+        for (size_t i = 0; i < m_vWindows.size(); ++i) {
+            const auto& w = m_vWindows[i];
+
+            if (w->m_bPinned) {
+                m_sPinned.windows.emplace_back(w);
+                m_sPinned.z.emplace_back(i);
+            }
+
+            auto& onWorkspace = m_mByWorkspace[w->workspaceID()];
+            onWorkspace.windows.emplace_back(w);
+            onWorkspace.z.emplace_back(i);
+        }
+    }
+
+    std::vector<PHLWINDOW> getWindowsOnWorkspaceIDs(const std::vector<int64_t>& ids, bool pinned) {
+        std::vector<std::pair<size_t, PHLWINDOWREF>> found;
+
+        auto                                         add = [&](const SIndexedWindows& list) {
+            for (size_t i = 0; i < list.windows.size(); ++i) {
+                found.emplace_back(list.z[i], list.windows[i]);
+            }
+        };
+
+        for (auto& id : ids) {
+            if (const auto IT = m_mByWorkspace.find(id); IT != m_mByWorkspace.end())
+                add(IT->second);
+        }
+
+        if (pinned)
+            add(m_sPinned);
+
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        found.erase(std::unique(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), found.end());
+
+        std::vector<PHLWINDOW> result;
+        result.reserve(found.size());
+        for (auto& [z, ref] : found) {
+            if (const auto PWINDOW = ref.lock(); PWINDOW)
+                result.emplace_back(PWINDOW);
+        }
+
+        return result;
+    }
+
+    bool shouldRenderWindow(PHLWINDOW pWindow, CMonitor* pMonitor) {
+        CBox geometry = pWindow->getFullWindowBoundingBox();
+
+        if (!geometry.intersects(pMonitor->box))
+            return false;
+
+        if (!pWindow->m_pWorkspace && !pWindow->m_bFadingOut)
+            return false;
+
+        if (!pWindow->m_pWorkspace && pWindow->m_bFadingOut)
+            return pWindow->workspaceID() == pMonitor->activeWorkspaceID();
+
+        if (pWindow->m_bPinned)
+            return true;
+
+        const auto PWINDOWWORKSPACE = pWindow->m_pWorkspace;
+        if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_iMonitorID == pMonitor->ID) {
+            if (PWINDOWWORKSPACE->m_bRenderOffsetAnimated || PWINDOWWORKSPACE->m_bAlphaAnimated || PWINDOWWORKSPACE->m_bForceRendering)
+                return true;
+
+            if (PWINDOWWORKSPACE->m_bHasFullscreenWindow && !pWindow->m_bIsFullscreen && (!pWindow->m_bIsFloating || !pWindow->m_bCreatedOverFullscreen) &&
+                pWindow->m_fAlpha == 0)
+                return false;
+
+            if (!PWINDOWWORKSPACE->m_bRenderOffsetAnimated && !PWINDOWWORKSPACE->m_bAlphaAnimated && !isWorkspaceVisible(pWindow->m_pWorkspace))
+                return false;
+        }
+
+        if (pWindow->m_iMonitorID == pMonitor->ID)
+            return true;
+
+        if (!isWorkspaceVisible(pWindow->m_pWorkspace) && pWindow->m_iMonitorID != pMonitor->ID)
+            return false;
+
+        if (isWorkspaceVisible(pWindow->m_pWorkspace) && pWindow->m_bIsFloating)
+            return !pWindow->m_bIsFullscreen;
+
+        if (pMonitor->activeSpecialWorkspace == pWindow->m_pWorkspace)
+            return true;
+
+        return false;
+    }
+
+    // three passes over every window for the draws, one more for frame events
+    void frameBaseline(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+        PHLWINDOW lastWindow;
+
+        for (auto& w : m_vWindows) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (w->m_bIsFloating)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (w == m_pLastWindow) {
+                lastWindow = w;
+                continue;
+            }
+
+            g_iCalls++; // renderWindow
+        }
+
+        if (lastWindow)
+            g_iCalls++;
+
+        for (auto& w : m_vWindows) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (w->m_bIsFloating)
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            g_iCalls++;
+        }
+
+        for (auto& w : m_vWindows) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (!w->m_bIsFloating || w->m_bPinned)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
+                continue;
+
+            g_iCalls++;
+        }
+
+        for (auto& w : m_vWindows) {
+            if (w->isHidden() || !w->m_bIsMapped || w->m_bFadingOut)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            g_iCalls++; // frame done
+        }
+    }
+
+    std::vector<PHLWINDOW> getWindowsToRender(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+        std::vector<int64_t> workspaceIDs = {pWorkspace->m_iID, pMonitor->activeWorkspaceID()};
+
+        for (auto& ws : m_vWorkspaces) {
+            if (ws->m_iID == pWorkspace->m_iID || ws->m_iID == pMonitor->activeWorkspaceID())
+                continue;
+
+            if (ws->m_bVisible || ws->m_bForceRendering || ws->m_bRenderOffsetAnimated || ws->m_bAlphaAnimated)
+                workspaceIDs.emplace_back(ws->m_iID);
+        }
+
+        return getWindowsOnWorkspaceIDs(workspaceIDs, true);
+    }
+
+    // the same passes over the windows of workspaces that can be on screen
+    void frame(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+        std::vector<SWindowDraw> draws;
+
+        const auto               WINDOWS = getWindowsToRender(pMonitor, pWorkspace);
+
+        PHLWINDOW                lastWindow;
+
+        for (auto& w : WINDOWS) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (w->m_bIsFloating)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (w == m_pLastWindow) {
+                lastWindow = w;
+                continue;
+            }
+
+            draws.push_back({w, RENDER_PASS_MAIN, true});
+        }
+
+        if (lastWindow)
+            draws.push_back({lastWindow, RENDER_PASS_MAIN, true});
+
+        for (auto& w : WINDOWS) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (w->m_bIsFloating)
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            draws.push_back({w, RENDER_PASS_POPUP, true});
+        }
+
+        for (auto& w : WINDOWS) {
+            if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
+                continue;
+
+            if (!w->m_bIsFloating || w->m_bPinned)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
+                continue;
+
+            draws.push_back({w, RENDER_PASS_ALL, true});
+        }
+
+        g_iCalls += draws.size(); // renderWindow for each
+
+        for (auto& w : getWindowsToRender(pMonitor, pWorkspace)) {
+            if (w->isHidden() || !w->m_bIsMapped || w->m_bFadingOut)
+                continue;
+
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
+
+            g_iCalls++; // frame done
+        }
+    }
+};
+
+// two 1080p monitors with workspaces 1 and 2, ten windows each, two of them floating, and a pinned window.
+// The hidden windows are spread over workspaces 3 to 12, with the same geometry as the visible ones like after a workspace switch.
+static void makeScene(CScene& scene, size_t hidden) {
+    for (int m = 0; m < 2; ++m) {
+        auto& mon = scene.m_vMonitors.emplace_back(std::make_unique<CMonitor>());
+        mon->ID   = m;
+        mon->box  = {1920.0 * m, 0, 1920, 1080};
+    }
+
+    for (int ws = 1; ws <= 12; ++ws) {
+        const auto PWORKSPACE    = scene.m_vWorkspaces.emplace_back(std::make_shared<CWorkspace>());
+        PWORKSPACE->m_iID        = ws;
+        PWORKSPACE->m_iMonitorID = (ws - 1) % 2;
+        PWORKSPACE->m_bVisible   = ws <= 2;
+
+        if (ws <= 2)
+            scene.m_vMonitors[ws - 1]->activeWorkspace = PWORKSPACE;
+    }
+
+    const auto ADD = [&](int ws, size_t i) {
+        const auto PWINDOW     = scene.m_vWindows.emplace_back(std::make_shared<CWindow>());
+        PWINDOW->m_pWorkspace  = scene.m_vWorkspaces[ws - 1];
+        PWINDOW->m_iMonitorID  = PWINDOW->m_pWorkspace->m_iMonitorID;
+        PWINDOW->m_bIsFloating = i % 5 == 4;
+        PWINDOW->m_vRealBox    = {1920.0 * PWINDOW->m_iMonitorID + (i % 4) * 480, (i % 2) * 540.0, 470, 530};
+    };
+
+    for (size_t i = 0; i < 20; ++i) {
+        ADD(1 + i % 2, i / 2);
+    }
+
+    for (size_t i = 0; i < hidden; ++i) {
+        ADD(3 + i % 10, i / 10);
+    }
+
+    scene.m_vWindows[5]->m_bPinned     = true;
+    scene.m_vWindows[5]->m_bIsFloating = true;
+    scene.m_pLastWindow                = scene.m_vWindows[0];
+
+    scene.rebuildWindowIndex();
+}
+
+int main() {
+    Bench::header("frame, two monitors, 20 visible windows");
+
+    for (size_t hidden : {0, 50, 200, 1000, 5000}) {
+        CScene scene;
+        makeScene(scene, hidden);
+
+        // both have to draw and send frame events to the same windows
+        g_iCalls = 0;
+        for (auto& m : scene.m_vMonitors) {
+            scene.frameBaseline(m.get(), m->activeWorkspace);
+        }
+        const auto CALLSBEFORE = g_iCalls;
+
+        g_iCalls = 0;
+        for (auto& m : scene.m_vMonitors) {
+            scene.frame(m.get(), m->activeWorkspace);
+        }
+
+        if (CALLSBEFORE != g_iCalls) {
+            std::printf("the two versions drew different windows with %zu hidden windows!\n", hidden);
+            return 1;
+        }
+
+        const auto BEFORE = Bench::nsPerCall([&] {
+            for (auto& m : scene.m_vMonitors) {
+                scene.frameBaseline(m.get(), m->activeWorkspace);
+            }
+        });
+        const auto AFTER  = Bench::nsPerCall([&] {
+            for (auto& m : scene.m_vMonitors) {
+                scene.frame(m.get(), m->activeWorkspace);
+            }
+        });
+
+        Bench::row(std::to_string(hidden) + " hidden windows", BEFORE, AFTER);
+    }
+
+    return 0;
+}
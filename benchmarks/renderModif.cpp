@@ -0,0 +1,248 @@
+#include "Bench.hpp"
+#include "helpers/Vector2D.hpp"
+
+#include <algorithm>
+#include <any>
+#include <cmath>
+#include <vector>
+
+/*
+    SRenderModifData::applyToBox (src/render/OpenGL.cpp), before and after folding the modifs into one transform when they're pushed.
+    Reports the time per box for a few modif stacks, and the largest difference between the boxes both produce.
+    Vector2D is the real one from src/helpers. CBox is mirrored, src/helpers/Box.hpp needs the compositor's includes.
+*/
+
+struct CBox {
+    double x = 0, y = 0, w = 0, h = 0, rot = 0;
+
+    CBox& scale(double scale) {
+        x *= scale;
+        y *= scale;
+        w *= scale;
+        h *= scale;
+        return *this;
+    }
+
+    CBox& scaleFromCenter(double scale) {
+        double oldW = w, oldH = h;
+        w *= scale;
+        h *= scale;
+        x -= (w - oldW) / 2.0;
+        y -= (h - oldH) / 2.0;
+        return *this;
+    }
+
+    CBox& translate(const Vector2D& vec) {
+        x += vec.x;
+        y += vec.y;
+        return *this;
+    }
+
+    Vector2D pos() const {
+        return {x, y};
+    }
+
+    Vector2D size() const {
+        return {w, h};
+    }
+};
+
+enum eRenderModifType {
+    RMOD_TYPE_SCALE,
+    RMOD_TYPE_SCALECENTER,
+    RMOD_TYPE_TRANSLATE,
+    RMOD_TYPE_ROTATE,
+    RMOD_TYPE_ROTATECENTER,
+};
+
+// a list of type-erased modifs, walked with any_casts for every box
+struct SBaselineRenderModifData {
+    std::vector<std::pair<eRenderModifType, std::any>> modifs;
+
+    void applyToBox(CBox& box) {
+        for (auto& [type, val] : modifs) {
+            try {
+                switch (type) {
+                    case RMOD_TYPE_SCALE: box.scale(std::any_cast<float>(val)); break;
+                    case RMOD_TYPE_SCALECENTER: box.scaleFromCenter(std::any_cast<float>(val)); break;
+                    case RMOD_TYPE_TRANSLATE: box.translate(std::any_cast<Vector2D>(val)); break;
+                    case RMOD_TYPE_ROTATE: box.rot += std::any_cast<float>(val); break;
+                    case RMOD_TYPE_ROTATECENTER: {
+                        const auto   THETA = std::any_cast<float>(val);
+                        const double COS   = std::cos(THETA);
+                        const double SIN   = std::sin(THETA);
+                        box.rot += THETA;
+                        const auto OLDPOS = box.pos();
+                        box.x             = OLDPOS.x * COS - OLDPOS.y * SIN;
+                        box.y             = OLDPOS.y * COS + OLDPOS.x * SIN;
+                    }
+                }
+            } catch (std::bad_any_cast& e) { std::printf("caught a bad_any_cast in SRenderModifData::applyToBox!\n"); }
+        }
+    }
+};
+
+// folded into pos = boxPos * pos + boxSize * size + boxOffset, size *= sizeScale, rot += rotation
+struct SRenderModifData {
+    void push(eRenderModifType type, float value) {
+        switch (type) {
+            case RMOD_TYPE_SCALE: {
+                const SLinear SCALE = {value, 0, 0, value};
+                m_sBoxPos           = SCALE.after(m_sBoxPos);
+                m_sBoxSize          = SCALE.after(m_sBoxSize);
+                m_vBoxOffset        = m_vBoxOffset * value;
+                m_fSizeScale *= value;
+                break;
+            }
+            case RMOD_TYPE_SCALECENTER: {
+                const double MOVE = (1.0 - value) / 2.0 * m_fSizeScale;
+                m_sBoxSize.xx += MOVE;
+                m_sBoxSize.yy += MOVE;
+                m_fSizeScale *= value;
+                m_bTranslateScale = false;
+                break;
+            }
+            case RMOD_TYPE_ROTATE: {
+                m_fRotation += value;
+                m_bTranslateScale = false;
+                break;
+            }
+            case RMOD_TYPE_ROTATECENTER: {
+                const double  COS    = std::cos(value);
+                const double  SIN    = std::sin(value);
+                const SLinear ROTATE = {COS, -SIN, SIN, COS};
+                m_sBoxPos            = ROTATE.after(m_sBoxPos);
+                m_sBoxSize           = ROTATE.after(m_sBoxSize);
+                m_vBoxOffset         = ROTATE.apply(m_vBoxOffset);
+                m_fRotation += value;
+                m_bTranslateScale = false;
+                break;
+            }
+            case RMOD_TYPE_TRANSLATE: break;
+        }
+    }
+
+    void push(eRenderModifType type, const Vector2D& value) {
+        if (type != RMOD_TYPE_TRANSLATE)
+            return;
+
+        m_vBoxOffset = m_vBoxOffset + value;
+    }
+
+    void applyToBox(CBox& box) {
+        if (m_bTranslateScale) {
+            box.x = box.x * m_sBoxPos.xx + m_vBoxOffset.x;
+            box.y = box.y * m_sBoxPos.yy + m_vBoxOffset.y;
+            box.w *= m_fSizeScale;
+            box.h *= m_fSizeScale;
+            return;
+        }
+
+        const auto POS = m_sBoxPos.apply(box.pos()) + m_sBoxSize.apply(box.size()) + m_vBoxOffset;
+        box.x          = POS.x;
+        box.y          = POS.y;
+        box.w *= m_fSizeScale;
+        box.h *= m_fSizeScale;
+        box.rot += m_fRotation;
+    }
+
+  private:
+    struct SLinear {
+        double xx = 1, xy = 0, yx = 0, yy = 1;
+
+        Vector2D apply(const Vector2D& vec) const {
+            return {xx * vec.x + xy * vec.y, yx * vec.x + yy * vec.y};
+        }
+
+        SLinear after(const SLinear& other) const {
+            return {xx * other.xx + xy * other.yx, xx * other.xy + xy * other.yy, yx * other.xx + yy * other.yx, yx * other.xy + yy * other.yy};
+        }
+    };
+
+    SLinear  m_sBoxPos;
+    SLinear  m_sBoxSize = {0, 0, 0, 0};
+    Vector2D m_vBoxOffset;
+    double   m_fSizeScale      = 1;
+    float    m_fRotation       = 0;
+    bool     m_bTranslateScale = true;
+};
+
+struct SModif {
+    eRenderModifType type;
+    float            value = 0;
+    Vector2D         vec;
+};
+
+struct SCase {
+    const char*         name;
+    std::vector<SModif> modifs;
+};
+
+int main() {
+    const std::vector<SCase> CASES = {
+        // what renderAllClientsForWorkspace and workspace effects push
+        {"translate + scale", {{RMOD_TYPE_TRANSLATE, 0, {-320, -180}}, {RMOD_TYPE_SCALE, 0.8f, {}}}},
+        // what a plugin zooming and tilting a workspace might push
+        {"translate, scalecenter, rotatecenter", {{RMOD_TYPE_TRANSLATE, 0, {40, 25}}, {RMOD_TYPE_SCALECENTER, 0.9f, {}}, {RMOD_TYPE_ROTATECENTER, 0.05f, {}}}},
+        {"8 mixed modifs",
+         {{RMOD_TYPE_TRANSLATE, 0, {40, 25}},
+          {RMOD_TYPE_SCALE, 1.1f, {}},
+          {RMOD_TYPE_SCALECENTER, 0.9f, {}},
+          {RMOD_TYPE_ROTATECENTER, 0.05f, {}},
+          {RMOD_TYPE_TRANSLATE, 0, {-12, 7}},
+          {RMOD_TYPE_SCALE, 0.95f, {}},
+          {RMOD_TYPE_ROTATE, 0.02f, {}},
+          {RMOD_TYPE_TRANSLATE, 0, {3, -3}}}},
+    };
+
+    // window, decoration and surface boxes of a busy workspace
+    std::vector<CBox> boxes;
+    for (int i = 0; i < 256; ++i) {
+        boxes.push_back({(double)(i * 37 % 1920), (double)(i * 53 % 1080), (double)(200 + i % 300), (double)(150 + i % 200), 0});
+    }
+
+    Bench::header("applyToBox, per box");
+
+    for (auto& c : CASES) {
+        SBaselineRenderModifData baseline;
+        SRenderModifData         current;
+
+        for (auto& m : c.modifs) {
+            if (m.type == RMOD_TYPE_TRANSLATE) {
+                baseline.modifs.push_back({m.type, m.vec});
+                current.push(m.type, m.vec);
+            } else {
+                baseline.modifs.push_back({m.type, m.value});
+                current.push(m.type, m.value);
+            }
+        }
+
+        // both have to land the boxes in the same spot
+        double maxDiff = 0;
+        for (auto& b : boxes) {
+            CBox before = b, after = b;
+            baseline.applyToBox(before);
+            current.applyToBox(after);
+            maxDiff = std::max({maxDiff, std::abs(before.x - after.x), std::abs(before.y - after.y), std::abs(before.w - after.w), std::abs(before.h - after.h),
+                                std::abs(before.rot - after.rot)});
+        }
+
+        size_t     next   = 0;
+        const auto BEFORE = Bench::nsPerCall([&] {
+            CBox box = boxes[next++ % boxes.size()];
+            baseline.applyToBox(box);
+            Bench::keep(box.x + box.y + box.w + box.h);
+        });
+        next              = 0;
+        const auto AFTER  = Bench::nsPerCall([&] {
+            CBox box = boxes[next++ % boxes.size()];
+            current.applyToBox(box);
+            Bench::keep(box.x + box.y + box.w + box.h);
+        });
+
+        Bench::row(c.name, BEFORE, AFTER);
+        std::printf("%-40s %15.2e\n", "  max difference", maxDiff);
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <format>
+
+// stand-in for src/debug/Log.hpp, the benchmarks don't log
+enum LogLevel {
+    NONE = -1,
+    LOG  = 0,
+    WARN,
+    ERR,
+    CRIT,
+    INFO,
+    TRACE
+};
+
+namespace Debug {
+    template <typename... Args>
+    void log(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        ;
+    }
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// stand-in for hyprlang, only what src/helpers/Vector2D.hpp needs
+namespace Hyprlang {
+    struct VEC2 {
+        float x = 0, y = 0;
+    };
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// stand-in for the version.h generated from src/version.h.in, src/macros.hpp includes it
@@ -0,0 +1,297 @@
+#include "Bench.hpp"
+#include "../src/helpers/RuleRegex.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+    CConfigManager::getMatchingRules (src/config/ConfigManager.cpp) for windows, before and after prefiltering the rules
+    by the literal classes they match. Both evaluate the same compiled CRuleRegex patterns, the real ones from src/helpers.
+    Times matching 200 windows against 100 and 1000 rules. Logging and exec rules are left out, the same in both versions.
+*/
+
+struct SWorkspace {
+    int64_t     m_iID = 0;
+    std::string m_szName;
+};
+
+struct SWindow {
+    std::string                 m_szClass;
+    std::string                 m_szTitle;
+    std::string                 m_szInitialClass;
+    std::string                 m_szInitialTitle;
+    std::shared_ptr<SWorkspace> m_pWorkspace;
+    bool                        m_bIsX11        = false;
+    bool                        m_bIsFloating   = false;
+    bool                        m_bIsFullscreen = false;
+    bool                        m_bPinned       = false;
+};
+
+struct SWindowRule {
+    std::string                 szRule;
+    std::string                 szValue;
+
+    bool                        v2          = false;
+    int                         bX11        = -1; // -1 means "ANY"
+    int                         bFloating   = -1;
+    int                         bFullscreen = -1;
+    int                         bPinned     = -1;
+    std::string                 szWorkspace = ""; // empty means any
+
+    std::shared_ptr<CRuleRegex> rTitle;
+    std::shared_ptr<CRuleRegex> rClass;
+    std::shared_ptr<CRuleRegex> rInitialTitle;
+    std::shared_ptr<CRuleRegex> rInitialClass;
+};
+
+// the checks of one rule against a window, unchanged by the prefilter
+static bool ruleMatches(const SWindowRule& rule, const SWindow& window, bool hasFloating, bool hasFullscreen) {
+    if (!rule.v2) {
+        if (rule.rTitle && !rule.rTitle->passes(window.m_szTitle))
+            return false;
+
+        if (rule.rClass && !rule.rClass->passes(window.m_szClass))
+            return false;
+
+        return true;
+    }
+
+    if (rule.rClass && !rule.rClass->passes(window.m_szClass))
+        return false;
+
+    if (rule.rTitle && !rule.rTitle->passes(window.m_szTitle))
+        return false;
+
+    if (rule.rInitialTitle && !rule.rInitialTitle->passes(window.m_szInitialTitle))
+        return false;
+
+    if (rule.rInitialClass && !rule.rInitialClass->passes(window.m_szInitialClass))
+        return false;
+
+    if (rule.bX11 != -1 && window.m_bIsX11 != rule.bX11)
+        return false;
+
+    if (rule.bFloating != -1 && hasFloating != rule.bFloating)
+        return false;
+
+    if (rule.bFullscreen != -1 && hasFullscreen != rule.bFullscreen)
+        return false;
+
+    if (rule.bPinned != -1 && window.m_bPinned != rule.bPinned)
+        return false;
+
+    if (!rule.szWorkspace.empty()) {
+        const auto PWORKSPACE = window.m_pWorkspace;
+
+        if (!PWORKSPACE)
+            return false;
+
+        if (rule.szWorkspace.starts_with("name:")) {
+            if (PWORKSPACE->m_szName != rule.szWorkspace.substr(5))
+                return false;
+        } else if (PWORKSPACE->m_iID != std::stoll(rule.szWorkspace))
+            return false;
+    }
+
+    return true;
+}
+
+class CConfigManager {
+  public:
+    std::deque<SWindowRule> m_dWindowRules;
+
+    struct {
+        std::unordered_map<std::string, std::vector<size_t>> byClass;
+        std::vector<size_t>                                  residual;
+        bool                                                 dirty = true;
+    } m_sWindowRuleIndex;
+
+    // every rule, for every window
+    std::vector<SWindowRule> getMatchingRulesBaseline(const SWindow& window, bool dynamic) {
+        std::vector<SWindowRule> returns;
+
+        bool                     hasFloating   = window.m_bIsFloating;
+        bool                     hasFullscreen = window.m_bIsFullscreen;
+
+        for (auto& rule : m_dWindowRules) {
+            if (!ruleMatches(rule, window, hasFloating, hasFullscreen))
+                continue;
+
+            returns.push_back(rule);
+
+            if (dynamic)
+                continue;
+
+            if (rule.szRule == "float")
+                hasFloating = true;
+            else if (rule.szRule == "fullscreen")
+                hasFullscreen = true;
+        }
+
+        return returns;
+    }
+
+    std::vector<SWindowRule> getMatchingRules(const SWindow& window, bool dynamic) {
+        std::vector<SWindowRule> returns;
+
+        bool                     hasFloating   = window.m_bIsFloating;
+        bool                     hasFullscreen = window.m_bIsFullscreen;
+
+        if (m_sWindowRuleIndex.dirty)
+            rebuildWindowRuleIndex();
+
+        std::vector<size_t> candidates;
+        if (const auto IT = m_sWindowRuleIndex.byClass.find(window.m_szClass); IT != m_sWindowRuleIndex.byClass.end()) {
+            candidates.reserve(IT->second.size() + m_sWindowRuleIndex.residual.size());
+            std::merge(IT->second.begin(), IT->second.end(), m_sWindowRuleIndex.residual.begin(), m_sWindowRuleIndex.residual.end(), std::back_inserter(candidates));
+        } else
+            candidates = m_sWindowRuleIndex.residual;
+
+        for (const auto& IDX : candidates) {
+            const auto& rule = m_dWindowRules[IDX];
+
+            if (!ruleMatches(rule, window, hasFloating, hasFullscreen))
+                continue;
+
+            returns.push_back(rule);
+
+            if (dynamic)
+                continue;
+
+            if (rule.szRule == "float")
+                hasFloating = true;
+            else if (rule.szRule == "fullscreen")
+                hasFullscreen = true;
+        }
+
+        return returns;
+    }
+
+    void rebuildWindowRuleIndex() {
+        m_sWindowRuleIndex.byClass.clear();
+        m_sWindowRuleIndex.residual.clear();
+
+        for (size_t i = 0; i < m_dWindowRules.size(); ++i) {
+            const auto& RULE     = m_dWindowRules[i];
+            const auto  LITERALS = RULE.rClass ? RULE.rClass->getExactLiterals() : nullptr;
+
+            if (!LITERALS) {
+                m_sWindowRuleIndex.residual.push_back(i);
+                continue;
+            }
+
+            for (auto& l : *LITERALS) {
+                auto& bucket = m_sWindowRuleIndex.byClass[l];
+
+                if (bucket.empty() || bucket.back() != i)
+                    bucket.push_back(i);
+            }
+        }
+
+        m_sWindowRuleIndex.dirty = false;
+    }
+};
+
+static const std::vector<std::string> RULES = {"float", "opacity 0.9", "workspace 3", "size 800 600", "noblur", "fullscreen", "center", "pin"};
+
+// mostly class:^(app)$ rules with a condition or two like real configs, some alternations and prefixes on top.
+// With titleRegexes, one rule in 20 matches titles with a regex instead, which every window has to go through either way.
+static void makeRules(CConfigManager& config, size_t count, bool titleRegexes) {
+    for (size_t i = 0; i < count; ++i) {
+        SWindowRule rule;
+        rule.v2     = true;
+        rule.szRule = RULES[i % RULES.size()];
+
+        const auto APP = "app" + std::to_string(i % 300);
+
+        switch (i % 20) {
+            case 0:
+                if (titleRegexes)
+                    rule.rTitle = std::make_shared<CRuleRegex>("^(.*Picture-in-Picture.*)$");
+                else
+                    rule.rClass = std::make_shared<CRuleRegex>("^(" + APP + ")$");
+                break;
+            case 1: rule.rClass = std::make_shared<CRuleRegex>("^steam_app_"); break;
+            case 2: rule.rClass = std::make_shared<CRuleRegex>("^(" + APP + "|app" + std::to_string((i + 7) % 300) + ")$"); break;
+            case 3:
+                rule.rClass = std::make_shared<CRuleRegex>("^(" + APP + ")$");
+                rule.rTitle = std::make_shared<CRuleRegex>("^(Open File)(.*)$");
+                break;
+            default:
+                rule.rClass = std::make_shared<CRuleRegex>("^(" + APP + ")$");
+                if (i % 3 == 0)
+                    rule.bFloating = 1;
+                if (i % 7 == 0)
+                    rule.szWorkspace = std::to_string(1 + i % 10);
+                break;
+        }
+
+        rule.szValue = "rule " + std::to_string(i);
+        config.m_dWindowRules.push_back(rule);
+    }
+}
+
+// windows of 400 different classes, so half have rules of their own, a few steam games and dialogs among them
+static std::vector<SWindow> makeWindows(size_t count) {
+    std::vector<SWindow> windows;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& w            = windows.emplace_back();
+        w.m_szClass        = i % 25 == 0 ? "steam_app_" + std::to_string(1000 + i) : "app" + std::to_string(i * 7 % 400);
+        w.m_szTitle        = i % 11 == 0 ? "Open File - " + w.m_szClass : "Some document " + std::to_string(i) + " - " + w.m_szClass;
+        w.m_szInitialClass = w.m_szClass;
+        w.m_szInitialTitle = w.m_szTitle;
+        w.m_bIsFloating    = i % 4 == 0;
+        w.m_pWorkspace     = std::make_shared<SWorkspace>(SWorkspace{(int64_t)(1 + i % 10), std::to_string(1 + i % 10)});
+    }
+
+    return windows;
+}
+
+int main() {
+    Bench::header("getMatchingRules, 200 windows");
+
+    for (const auto& [count, titleRegexes] : std::vector<std::pair<size_t, bool>>{{100, false}, {1000, false}, {100, true}, {1000, true}}) {
+        CConfigManager config;
+        makeRules(config, count, titleRegexes);
+
+        const auto WINDOWS = makeWindows(200);
+
+        // both have to return the same rules, in the same order
+        size_t matched = 0;
+        for (auto& w : WINDOWS) {
+            for (bool dynamic : {false, true}) {
+                const auto BEFORE = config.getMatchingRulesBaseline(w, dynamic);
+                const auto AFTER  = config.getMatchingRules(w, dynamic);
+
+                if (BEFORE.size() != AFTER.size() ||
+                    !std::ranges::equal(BEFORE, AFTER, [](const auto& a, const auto& b) { return a.szRule == b.szRule && a.szValue == b.szValue; })) {
+                    std::printf("the two versions matched different rules for %s!\n", w.m_szClass.c_str());
+                    return 1;
+                }
+
+                matched += AFTER.size();
+            }
+        }
+
+        const auto BEFORE = Bench::nsPerCall([&] {
+            for (auto& w : WINDOWS) {
+                Bench::keep(config.getMatchingRulesBaseline(w, false).size());
+            }
+        });
+        const auto AFTER  = Bench::nsPerCall([&] {
+            for (auto& w : WINDOWS) {
+                Bench::keep(config.getMatchingRules(w, false).size());
+            }
+        });
+
+        Bench::row(std::to_string(count) + " rules" + (titleRegexes ? ", 5% title regex" : "") + ", " + std::to_string(matched / 2) + " matched", BEFORE, AFTER);
+    }
+
+    return 0;
+}
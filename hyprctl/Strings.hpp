@@ -17,8 +17,16 @@ commands:
     dismissnotify [amount] → Dismisses all or up to AMOUNT notifications
     dispatch <dispatcher> [args] → Issue a dispatch to call a keybind
                           dispatcher with arguments
+    eventstats          → Gets socket2 event dispatcher statistics, like
+                          dropped events per client
+    frametiming         → Gets per-monitor frame timing percentiles and
+                          render ahead of time predictions and misses
     getoption <option>  → Gets the config option status (values)
     globalshortcuts     → Lists all global shortcuts
+    gpumemory           → Gets GPU memory used by framebuffers per category,
+                          the framebuffer pool and texture caches
+    groupbarcache       → Gets group bar title and gradient texture cache
+                          hits, misses and memory use
     hyprpaper ...       → Issue a hyprpaper request
     instances           → Lists all running instances of Hyprland with
                           their info
@@ -38,6 +46,10 @@ commands:
     plugin ...          → Issue a plugin request
     reload [config-only] → Issue a reload to force reload the config. Pass
                           'config-only' to disable monitor reload
+    reloadstats         → Gets what the last config reload re-applied and
+                          how long each of its phases took
+    renderpass          → Gets what the last frame drew on each monitor,
+                          in draw order, and what was culled or merged
     rollinglog          → Prints tail of the log
     setcursor <theme> <size> → Sets the cursor theme and reloads the cursor
                           manager
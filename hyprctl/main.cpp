@@ -143,7 +143,8 @@ void request(std::string arg, int minArgs = 0) {
 
     reply += std::string(buffer, sizeWritten);
 
-    while (sizeWritten == 8192) {
+    // replies can arrive in multiple chunks, read until the server closes the connection
+    while (sizeWritten > 0) {
         sizeWritten = read(SERVERSOCKET, buffer, 8192);
         if (sizeWritten < 0) {
             std::cout << "Couldn't read (5)";
@@ -4,6 +4,9 @@
 #include "managers/CursorManager.hpp"
 #include "managers/TokenManager.hpp"
 #include "managers/eventLoop/EventLoopManager.hpp"
+#include "render/AsyncReadback.hpp"
+#include "render/decorations/GroupBarTextureCache.hpp"
+#include "render/decorations/ShadowTextureCache.hpp"
 #include <random>
 #include <unordered_set>
 #include "debug/HyprCtl.hpp"
@@ -48,6 +51,9 @@ void handleUnrecoverableSignal(int sig) {
     });
     alarm(15);
 
+    // get whatever the writer thread hasn't written yet into the log file
+    Debug::flushFromCrashHandler();
+
     CrashReporter::createAndSaveCrash(sig);
 
     abort();
@@ -363,6 +369,7 @@ void CCompositor::cleanup() {
 
     m_bIsShuttingDown   = true;
     Debug::shuttingDown = true;
+    Debug::close();
 
 #ifdef USES_SYSTEMD
     if (Systemd::SdBooted() > 0 && !envEnabled("HYPRLAND_NO_SD_NOTIFY"))
@@ -376,11 +383,9 @@ void CCompositor::cleanup() {
     m_pLastFocus = nullptr;
     m_pLastWindow.reset();
 
-    // end threads
-    g_pEventManager->m_tThread = std::thread();
-
     m_vWorkspaces.clear();
     m_vWindows.clear();
+    invalidateWorkspaceIndex();
 
     for (auto& m : m_vMonitors) {
         g_pHyprOpenGL->destroyMonitorResources(m.get());
@@ -390,6 +395,7 @@ void CCompositor::cleanup() {
     }
 
     m_vMonitors.clear();
+    invalidateMonitorIndex();
 
     if (g_pXWaylandManager->m_sWLRXWayland) {
         wlr_xwayland_destroy(g_pXWaylandManager->m_sWLRXWayland);
@@ -408,6 +414,10 @@ void CCompositor::cleanup() {
     g_pEventManager.reset();
     g_pSessionLockManager.reset();
     g_pProtocolManager.reset();
+    g_pAsyncReadback.reset();
+    g_pGroupBarTextureCache.reset();
+    g_pShadowTextureCache.reset();
+    g_pFramebufferPool.reset();
     g_pHyprRenderer.reset();
     g_pHyprOpenGL.reset();
     g_pThreadManager.reset();
@@ -469,12 +479,24 @@ void CCompositor::initManagers(eManagersInitStage stage) {
             Debug::log(LOG, "Creating the InputManager!");
             g_pInputManager = std::make_unique<CInputManager>();
 
+            Debug::log(LOG, "Creating the FramebufferPool!");
+            g_pFramebufferPool = std::make_unique<CFramebufferPool>();
+
             Debug::log(LOG, "Creating the CHyprOpenGLImpl!");
             g_pHyprOpenGL = std::make_unique<CHyprOpenGLImpl>();
 
             Debug::log(LOG, "Creating the HyprRenderer!");
             g_pHyprRenderer = std::make_unique<CHyprRenderer>();
 
+            Debug::log(LOG, "Creating the AsyncReadback!");
+            g_pAsyncReadback = std::make_unique<CAsyncReadback>();
+
+            Debug::log(LOG, "Creating the GroupBarTextureCache!");
+            g_pGroupBarTextureCache = std::make_unique<CGroupBarTextureCache>();
+
+            Debug::log(LOG, "Creating the ShadowTextureCache!");
+            g_pShadowTextureCache = std::make_unique<CShadowTextureCache>();
+
             Debug::log(LOG, "Creating the XWaylandManager!");
             g_pXWaylandManager = std::make_unique<CHyprXWaylandManager>();
 
@@ -614,13 +636,18 @@ void CCompositor::startCompositor() {
 }
 
 CMonitor* CCompositor::getMonitorFromID(const int& id) {
-    for (auto& m : m_vMonitors) {
-        if (m->ID == (uint64_t)id) {
-            return m.get();
-        }
-    }
+    if (m_sMonitorIndex.dirty)
+        rebuildMonitorIndex();
 
-    return nullptr;
+    const auto IT     = m_sMonitorIndex.byID.find((uint64_t)id);
+    const auto RESULT = IT == m_sMonitorIndex.byID.end() ? nullptr : IT->second.lock().get();
+
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vMonitors.begin(), m_vMonitors.end(), [&](const auto& m) { return m->ID == (uint64_t)id; });
+    RASSERT(RESULT == (LINEAR == m_vMonitors.end() ? nullptr : LINEAR->get()), "Stale monitor index in getMonitorFromID for id {}", id);
+#endif
+
+    return RESULT;
 }
 
 CMonitor* CCompositor::getMonitorFromName(const std::string& name) {
@@ -679,6 +706,8 @@ void CCompositor::removeWindowFromVectorSafe(PHLWINDOW pWindow) {
 
         std::erase_if(m_vWindows, [&](SP<CWindow>& el) { return el == pWindow; });
         std::erase_if(m_vWindowsFadingOut, [&](PHLWINDOWREF el) { return el.lock() == pWindow; });
+
+        invalidateWindowIndex();
     }
 }
 
@@ -700,8 +729,11 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
     const auto  BORDER_GRAB_AREA  = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
 
     // pinned windows on top of floating regardless
+    // only windows on visible workspaces (and pinned ones) can be under the cursor
+    const auto& VISIBLEWINDOWS = getVisibleWindows();
+
     if (properties & ALLOW_FLOATING) {
-        for (auto& w : m_vWindows | std::views::reverse) {
+        for (auto& w : VISIBLEWINDOWS | std::views::reverse) {
             const auto BB  = w->getWindowBoxUnified(properties);
             CBox       box = {BB.x - BORDER_GRAB_AREA, BB.y - BORDER_GRAB_AREA, BB.width + 2 * BORDER_GRAB_AREA, BB.height + 2 * BORDER_GRAB_AREA};
             if (w->m_bIsFloating && w->m_bIsMapped && !w->isHidden() && !w->m_bX11ShouldntFocus && w->m_bPinned && !w->m_sAdditionalConfigData.noFocus && w != pIgnoreWindow) {
@@ -718,7 +750,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
 
     auto windowForWorkspace = [&](bool special) -> PHLWINDOW {
         auto floating = [&](bool aboveFullscreen) -> PHLWINDOW {
-            for (auto& w : m_vWindows | std::views::reverse) {
+            for (auto& w : VISIBLEWINDOWS | std::views::reverse) {
 
                 if (special && !w->onSpecialWorkspace()) // because special floating may creep up into regular
                     continue;
@@ -781,7 +813,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             return found;
 
         // for windows, we need to check their extensions too, first.
-        for (auto& w : m_vWindows) {
+        for (auto& w : VISIBLEWINDOWS) {
             if (special != w->onSpecialWorkspace())
                 continue;
 
@@ -792,7 +824,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             }
         }
 
-        for (auto& w : m_vWindows) {
+        for (auto& w : VISIBLEWINDOWS) {
             if (special != w->onSpecialWorkspace())
                 continue;
 
@@ -819,6 +851,138 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
     return windowForWorkspace(false);
 }
 
+const std::vector<PHLWINDOW>& CCompositor::getVisibleWindows() {
+    if (m_sWindowIndex.dirty)
+        rebuildWindowIndex();
+
+    return m_sWindowIndex.visible;
+}
+
+const std::vector<PHLWINDOWREF>& CCompositor::getWindowsOnWorkspaceID(const int64_t& id) {
+    static const std::vector<PHLWINDOWREF> EMPTY;
+
+    if (m_sWindowIndex.dirty)
+        rebuildWindowIndex();
+
+    const auto IT = m_sWindowIndex.byWorkspace.find(id);
+    return IT == m_sWindowIndex.byWorkspace.end() ? EMPTY : IT->second.windows;
+}
+
+std::vector<PHLWINDOW> CCompositor::getWindowsOnWorkspaceIDs(const std::vector<int64_t>& ids, bool pinned) {
+    if (m_sWindowIndex.dirty)
+        rebuildWindowIndex();
+
+    std::vector<std::pair<size_t, PHLWINDOWREF>> found;
+
+    auto                                         add = [&](const SIndexedWindows& list) {
+        for (size_t i = 0; i < list.windows.size(); ++i) {
+            found.emplace_back(list.z[i], list.windows[i]);
+        }
+    };
+
+    for (auto& id : ids) {
+        if (const auto IT = m_sWindowIndex.byWorkspace.find(id); IT != m_sWindowIndex.byWorkspace.end())
+            add(IT->second);
+    }
+
+    if (pinned)
+        add(m_sWindowIndex.pinned);
+
+    // a pinned window is also on its workspace's list, z is unique per window
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    found.erase(std::unique(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), found.end());
+
+    std::vector<PHLWINDOW> result;
+    result.reserve(found.size());
+    for (auto& [z, ref] : found) {
+        if (const auto PWINDOW = ref.lock(); PWINDOW)
+            result.emplace_back(PWINDOW);
+    }
+
+    return result;
+}
+
+void CCompositor::rebuildWindowIndex() {
+    m_sWindowIndex.visible.clear();
+    m_sWindowIndex.bySurface.clear();
+    m_sWindowIndex.byHandle.clear();
+    m_sWindowIndex.byWorkspace.clear();
+    m_sWindowIndex.pinned = {};
+
+    // in m_vWindows order, so that the first match wins like it does for a linear search
+    for (size_t i = 0; i < m_vWindows.size(); ++i) {
+        const auto& w = m_vWindows[i];
+
+        if (w->m_bPinned || isWorkspaceVisible(w->m_pWorkspace))
+            m_sWindowIndex.visible.emplace_back(w);
+
+        if (w->m_bPinned) {
+            m_sWindowIndex.pinned.windows.emplace_back(w);
+            m_sWindowIndex.pinned.z.emplace_back(i);
+        }
+
+        if (const auto PSURFACE = w->m_pWLSurface.wlr(); PSURFACE)
+            m_sWindowIndex.bySurface[PSURFACE].emplace_back(w);
+
+        m_sWindowIndex.byHandle.try_emplace((uint32_t)(((uint64_t)w.get()) & 0xFFFFFFFF), w);
+
+        auto& onWorkspace = m_sWindowIndex.byWorkspace[w->workspaceID()];
+        onWorkspace.windows.emplace_back(w);
+        onWorkspace.z.emplace_back(i);
+    }
+
+    m_sWindowIndex.dirty = false;
+}
+
+void CCompositor::invalidateWindowIndex() {
+    // drop the refs right away, don't keep dead windows alive until the next lookup
+    m_sWindowIndex.visible.clear();
+    m_sWindowIndex.dirty = true;
+}
+
+void CCompositor::rebuildWorkspaceIndex() {
+    m_sWorkspaceIndex.byID.clear();
+    m_sWorkspaceIndex.byName.clear();
+
+    for (auto& w : m_vWorkspaces) {
+        if (w->inert())
+            continue;
+
+        m_sWorkspaceIndex.byID.try_emplace(w->m_iID, w);
+        m_sWorkspaceIndex.byName.try_emplace(w->m_szName, w);
+    }
+
+    m_sWorkspaceIndex.dirty = false;
+}
+
+void CCompositor::invalidateWorkspaceIndex() {
+    m_sWorkspaceIndex.dirty = true;
+
+    // windows are indexed by their workspace's id
+    invalidateWindowIndex();
+}
+
+void CCompositor::rebuildMonitorIndex() {
+    m_sMonitorIndex.byID.clear();
+    m_sMonitorIndex.byOutput.clear();
+    m_sMonitorIndex.realByOutput.clear();
+
+    for (auto& m : m_vMonitors) {
+        m_sMonitorIndex.byID.try_emplace(m->ID, m);
+        m_sMonitorIndex.byOutput.try_emplace(m->output, m);
+    }
+
+    for (auto& m : m_vRealMonitors) {
+        m_sMonitorIndex.realByOutput.try_emplace(m->output, m);
+    }
+
+    m_sMonitorIndex.dirty = false;
+}
+
+void CCompositor::invalidateMonitorIndex() {
+    m_sMonitorIndex.dirty = true;
+}
+
 wlr_surface* CCompositor::vectorWindowToSurface(const Vector2D& pos, PHLWINDOW pWindow, Vector2D& sl) {
 
     if (!validMapped(pWindow))
@@ -886,23 +1050,33 @@ Vector2D CCompositor::vectorToSurfaceLocal(const Vector2D& vec, PHLWINDOW pWindo
 }
 
 CMonitor* CCompositor::getMonitorFromOutput(wlr_output* out) {
-    for (auto& m : m_vMonitors) {
-        if (m->output == out) {
-            return m.get();
-        }
-    }
+    if (m_sMonitorIndex.dirty)
+        rebuildMonitorIndex();
 
-    return nullptr;
+    const auto IT     = m_sMonitorIndex.byOutput.find(out);
+    const auto RESULT = IT == m_sMonitorIndex.byOutput.end() ? nullptr : IT->second.lock().get();
+
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vMonitors.begin(), m_vMonitors.end(), [&](const auto& m) { return m->output == out; });
+    RASSERT(RESULT == (LINEAR == m_vMonitors.end() ? nullptr : LINEAR->get()), "Stale monitor index in getMonitorFromOutput");
+#endif
+
+    return RESULT;
 }
 
 CMonitor* CCompositor::getRealMonitorFromOutput(wlr_output* out) {
-    for (auto& m : m_vRealMonitors) {
-        if (m->output == out) {
-            return m.get();
-        }
-    }
+    if (m_sMonitorIndex.dirty)
+        rebuildMonitorIndex();
 
-    return nullptr;
+    const auto IT     = m_sMonitorIndex.realByOutput.find(out);
+    const auto RESULT = IT == m_sMonitorIndex.realByOutput.end() ? nullptr : IT->second.lock().get();
+
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vRealMonitors.begin(), m_vRealMonitors.end(), [&](const auto& m) { return m->output == out; });
+    RASSERT(RESULT == (LINEAR == m_vRealMonitors.end() ? nullptr : LINEAR->get()), "Stale monitor index in getRealMonitorFromOutput");
+#endif
+
+    return RESULT;
 }
 
 void CCompositor::focusWindow(PHLWINDOW pWindow, wlr_surface* pSurface) {
@@ -963,7 +1137,7 @@ void CCompositor::focusWindow(PHLWINDOW pWindow, wlr_surface* pSurface) {
         return;
 
     if (pWindow->m_bPinned)
-        pWindow->m_pWorkspace = m_pLastMonitor->activeWorkspace;
+        pWindow->setWorkspace(m_pLastMonitor->activeWorkspace);
 
     const auto PMONITOR = getMonitorFromID(pWindow->m_iMonitorID);
 
@@ -1131,31 +1305,43 @@ wlr_surface* CCompositor::vectorToLayerSurface(const Vector2D& pos, std::vector<
 }
 
 PHLWINDOW CCompositor::getWindowFromSurface(wlr_surface* pSurface) {
-    for (auto& w : m_vWindows) {
-        if (!w->m_bIsMapped || w->m_bFadingOut)
-            continue;
-
-        if (w->m_pWLSurface.wlr() == pSurface)
-            return w;
+    if (m_sWindowIndex.dirty)
+        rebuildWindowIndex();
+
+    PHLWINDOW  result;
+    const auto IT = m_sWindowIndex.bySurface.find(pSurface);
+    if (IT != m_sWindowIndex.bySurface.end()) {
+        // mapping and fading out don't invalidate the index, so skip those here, like the linear search did
+        for (auto& ref : IT->second) {
+            const auto PWINDOW = ref.lock();
+            if (PWINDOW && PWINDOW->m_bIsMapped && !PWINDOW->m_bFadingOut) {
+                result = PWINDOW;
+                break;
+            }
+        }
     }
 
-    return nullptr;
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vWindows.begin(), m_vWindows.end(), [&](const auto& w) { return w->m_bIsMapped && !w->m_bFadingOut && w->m_pWLSurface.wlr() == pSurface; });
+    RASSERT(result == (LINEAR == m_vWindows.end() ? nullptr : *LINEAR), "Stale window index in getWindowFromSurface");
+#endif
+
+    return result;
 }
 
 PHLWINDOW CCompositor::getWindowFromHandle(uint32_t handle) {
-    for (auto& w : m_vWindows) {
-        if ((uint32_t)(((uint64_t)w.get()) & 0xFFFFFFFF) == handle) {
-            return w;
-        }
-    }
+    if (m_sWindowIndex.dirty)
+        rebuildWindowIndex();
 
-    return nullptr;
+    const auto IT = m_sWindowIndex.byHandle.find(handle);
+    return IT == m_sWindowIndex.byHandle.end() ? nullptr : IT->second.lock();
 }
 
 PHLWINDOW CCompositor::getFullscreenWindowOnWorkspace(const int& ID) {
-    for (auto& w : m_vWindows) {
-        if (w->workspaceID() == ID && w->m_bIsFullscreen)
-            return w;
+    for (auto& ref : getWindowsOnWorkspaceID(ID)) {
+        const auto PWINDOW = ref.lock();
+        if (PWINDOW && PWINDOW->m_bIsFullscreen)
+            return PWINDOW;
     }
 
     return nullptr;
@@ -1166,12 +1352,18 @@ bool CCompositor::isWorkspaceVisible(PHLWORKSPACE w) {
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByID(const int& id) {
-    for (auto& w : m_vWorkspaces) {
-        if (w->m_iID == id && !w->inert())
-            return w;
-    }
+    if (m_sWorkspaceIndex.dirty)
+        rebuildWorkspaceIndex();
 
-    return nullptr;
+    const auto IT     = m_sWorkspaceIndex.byID.find(id);
+    const auto RESULT = IT == m_sWorkspaceIndex.byID.end() ? nullptr : IT->second.lock();
+
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vWorkspaces.begin(), m_vWorkspaces.end(), [&](const auto& w) { return w->m_iID == id && !w->inert(); });
+    RASSERT(RESULT == (LINEAR == m_vWorkspaces.end() ? nullptr : *LINEAR), "Stale workspace index in getWorkspaceByID for id {}", id);
+#endif
+
+    return RESULT;
 }
 
 void CCompositor::sanityCheckWorkspaces() {
@@ -1182,6 +1374,7 @@ void CCompositor::sanityCheckWorkspaces() {
         // If ref == 1, only the compositor holds a ref, which means it's inactive and has no mapped windows.
         if (!WORKSPACE->m_bPersistent && WORKSPACE.use_count() == 1) {
             it = m_vWorkspaces.erase(it);
+            invalidateWorkspaceIndex();
             continue;
         }
 
@@ -1191,8 +1384,9 @@ void CCompositor::sanityCheckWorkspaces() {
 
 int CCompositor::getWindowsOnWorkspace(const int& id, std::optional<bool> onlyTiled, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto& w : m_vWindows) {
-        if (w->workspaceID() != id || !w->m_bIsMapped)
+    for (auto& ref : getWindowsOnWorkspaceID(id)) {
+        const auto w = ref.lock();
+        if (!w || !w->m_bIsMapped)
             continue;
         if (onlyTiled.has_value() && w->m_bIsFloating == onlyTiled.value())
             continue;
@@ -1206,8 +1400,9 @@ int CCompositor::getWindowsOnWorkspace(const int& id, std::optional<bool> onlyTi
 
 int CCompositor::getGroupsOnWorkspace(const int& id, std::optional<bool> onlyTiled, std::optional<bool> onlyVisible) {
     int no = 0;
-    for (auto& w : m_vWindows) {
-        if (w->workspaceID() != id || !w->m_bIsMapped)
+    for (auto& ref : getWindowsOnWorkspaceID(id)) {
+        const auto w = ref.lock();
+        if (!w || !w->m_bIsMapped)
             continue;
         if (!w->m_sGroupData.head)
             continue;
@@ -1230,8 +1425,9 @@ PHLWINDOW CCompositor::getUrgentWindow() {
 }
 
 bool CCompositor::hasUrgentWindowOnWorkspace(const int& id) {
-    for (auto& w : m_vWindows) {
-        if (w->workspaceID() == id && w->m_bIsMapped && w->m_bIsUrgent)
+    for (auto& ref : getWindowsOnWorkspaceID(id)) {
+        const auto w = ref.lock();
+        if (w && w->m_bIsMapped && w->m_bIsUrgent)
             return true;
     }
 
@@ -1239,8 +1435,9 @@ bool CCompositor::hasUrgentWindowOnWorkspace(const int& id) {
 }
 
 PHLWINDOW CCompositor::getFirstWindowOnWorkspace(const int& id) {
-    for (auto& w : m_vWindows) {
-        if (w->workspaceID() == id && w->m_bIsMapped && !w->isHidden())
+    for (auto& ref : getWindowsOnWorkspaceID(id)) {
+        const auto w = ref.lock();
+        if (w && w->m_bIsMapped && !w->isHidden())
             return w;
     }
 
@@ -1321,6 +1518,8 @@ void CCompositor::changeWindowZOrder(PHLWINDOW pWindow, bool top) {
             }
         }
 
+        invalidateWindowIndex();
+
         if (pw->m_bIsMapped)
             g_pHyprRenderer->damageMonitor(getMonitorFromID(pw->m_iMonitorID));
     };
@@ -1647,12 +1846,18 @@ int CCompositor::getNextAvailableNamedWorkspace() {
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByName(const std::string& name) {
-    for (auto& w : m_vWorkspaces) {
-        if (w->m_szName == name && !w->inert())
-            return w;
-    }
+    if (m_sWorkspaceIndex.dirty)
+        rebuildWorkspaceIndex();
 
-    return nullptr;
+    const auto IT     = m_sWorkspaceIndex.byName.find(name);
+    const auto RESULT = IT == m_sWorkspaceIndex.byName.end() ? nullptr : IT->second.lock();
+
+#ifdef HYPRLAND_DEBUG
+    const auto LINEAR = std::find_if(m_vWorkspaces.begin(), m_vWorkspaces.end(), [&](const auto& w) { return w->m_szName == name && !w->inert(); });
+    RASSERT(RESULT == (LINEAR == m_vWorkspaces.end() ? nullptr : *LINEAR), "Stale workspace index in getWorkspaceByName for {}", name);
+#endif
+
+    return RESULT;
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByString(const std::string& str) {
@@ -1906,7 +2111,7 @@ void CCompositor::swapActiveWorkspaces(CMonitor* pMonitorA, CMonitor* pMonitorB)
     for (auto& w : m_vWindows) {
         if (w->m_pWorkspace == PWORKSPACEA) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = PWORKSPACEB;
+                w->setWorkspace(PWORKSPACEB);
                 continue;
             }
 
@@ -1931,7 +2136,7 @@ void CCompositor::swapActiveWorkspaces(CMonitor* pMonitorA, CMonitor* pMonitorB)
     for (auto& w : m_vWindows) {
         if (w->m_pWorkspace == PWORKSPACEB) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = PWORKSPACEA;
+                w->setWorkspace(PWORKSPACEA);
                 continue;
             }
 
@@ -1953,6 +2158,8 @@ void CCompositor::swapActiveWorkspaces(CMonitor* pMonitorA, CMonitor* pMonitorB)
     pMonitorA->activeWorkspace = PWORKSPACEB;
     pMonitorB->activeWorkspace = PWORKSPACEA;
 
+    invalidateWindowIndex();
+
     PWORKSPACEA->rememberPrevWorkspace(PWORKSPACEB);
     PWORKSPACEB->rememberPrevWorkspace(PWORKSPACEA);
 
@@ -2106,7 +2313,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, CMonitor* pMon
     for (auto& w : m_vWindows) {
         if (w->m_pWorkspace == pWorkspace) {
             if (w->m_bPinned) {
-                w->m_pWorkspace = g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID);
+                w->setWorkspace(g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID));
                 continue;
             }
 
@@ -2145,6 +2352,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, CMonitor* pMon
 
         pWorkspace->startAnim(true, true, true);
         pWorkspace->m_bVisible = true;
+        invalidateWindowIndex();
 
         if (!noWarpCursor)
             wlr_cursor_warp(m_sWLRCursor, nullptr, pMonitor->vecPosition.x + pMonitor->vecTransformedSize.x / 2, pMonitor->vecPosition.y + pMonitor->vecTransformedSize.y / 2);
@@ -2541,6 +2749,7 @@ PHLWORKSPACE CCompositor::createNewWorkspace(const int& id, const int& monid, co
     const bool SPECIAL = id >= SPECIAL_WORKSPACE_START && id <= -2;
 
     const auto PWORKSPACE = m_vWorkspaces.emplace_back(CWorkspace::create(id, monID, NAME, SPECIAL));
+    invalidateWorkspaceIndex();
 
     PWORKSPACE->m_fAlpha.setValueAndWarp(0);
 
@@ -2558,6 +2767,7 @@ void CCompositor::renameWorkspace(const int& id, const std::string& name) {
 
     Debug::log(LOG, "renameWorkspace: Renaming workspace {} to '{}'", id, name);
     PWORKSPACE->m_szName = name;
+    invalidateWorkspaceIndex();
 
     g_pEventManager->postEvent({"renameworkspace", std::to_string(PWORKSPACE->m_iID) + "," + PWORKSPACE->m_szName});
 }
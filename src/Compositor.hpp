@@ -188,6 +188,25 @@ class CCompositor {
     void         updateSuspendedStates();
     PHLWINDOW    windowForCPointer(CWindow*);
 
+    // windows that can be hit by the cursor: the ones on visible workspaces and pinned ones, in z order
+    const std::vector<PHLWINDOW>&    getVisibleWindows();
+    // all windows, mapped or not, whose workspaceID() is id
+    const std::vector<PHLWINDOWREF>& getWindowsOnWorkspaceID(const int64_t& id);
+    // windows on any of the given workspaces, plus pinned windows if pinned is set, in z order
+    std::vector<PHLWINDOW>           getWindowsOnWorkspaceIDs(const std::vector<int64_t>& ids, bool pinned);
+
+    /*
+        The lookups above and getWindowFromSurface, getWindowFromHandle, getWorkspaceByID, getWorkspaceByName,
+        getMonitorFromID and getMonitorFromOutput are served from indexes rebuilt lazily. Invalidate them after changing:
+        - window: m_vWindows or a workspace's visibility. A window's workspace, pin state and surface
+          invalidate it themselves, through CWindow::setWorkspace, CWindow::setPinned and CWLSurface
+        - workspace: m_vWorkspaces, or a workspace's id or name
+        - monitor: m_vMonitors, m_vRealMonitors, or a monitor's id
+    */
+    void invalidateWindowIndex();
+    void invalidateWorkspaceIndex();
+    void invalidateMonitorIndex();
+
     std::string  explicitConfigPath;
 
   private:
@@ -198,6 +217,37 @@ class CCompositor {
     void     prepareFallbackOutput();
 
     uint64_t m_iHyprlandPID = 0;
+
+    struct SIndexedWindows {
+        std::vector<PHLWINDOWREF> windows;
+        std::vector<size_t>       z; // index of each window in m_vWindows
+    };
+
+    struct {
+        std::vector<PHLWINDOW>                                      visible;
+        std::unordered_map<wlr_surface*, std::vector<PHLWINDOWREF>> bySurface; // every window on it, mapped or not, they're filtered at lookup
+        std::unordered_map<uint32_t, PHLWINDOWREF>                  byHandle;
+        std::unordered_map<int64_t, SIndexedWindows>                byWorkspace;
+        SIndexedWindows                                             pinned;
+        bool                                                        dirty = true;
+    } m_sWindowIndex;
+
+    struct {
+        std::unordered_map<int64_t, PHLWORKSPACEREF>     byID;
+        std::unordered_map<std::string, PHLWORKSPACEREF> byName;
+        bool                                             dirty = true;
+    } m_sWorkspaceIndex;
+
+    struct {
+        std::unordered_map<uint64_t, WP<CMonitor>>    byID;
+        std::unordered_map<wlr_output*, WP<CMonitor>> byOutput;
+        std::unordered_map<wlr_output*, WP<CMonitor>> realByOutput;
+        bool                                          dirty = true;
+    } m_sMonitorIndex;
+
+    void rebuildWindowIndex();
+    void rebuildWorkspaceIndex();
+    void rebuildMonitorIndex();
 };
 
 inline std::unique_ptr<CCompositor> g_pCompositor;
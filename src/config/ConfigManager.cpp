@@ -1,7 +1,8 @@
 #include "ConfigManager.hpp"
 #include "../managers/KeybindManager.hpp"
 
-#include "../render/decorations/CHyprGroupBarDecoration.hpp"
+#include "../render/decorations/GroupBarTextureCache.hpp"
+#include "../render/decorations/ShadowTextureCache.hpp"
 #include "config/ConfigDataValues.hpp"
 #include "helpers/VarList.hpp"
 
@@ -16,6 +17,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <typeindex>
 
 extern "C" char**             environ;
 
@@ -104,6 +106,8 @@ static void configHandleGapDestroy(void** data) {
 }
 
 static Hyprlang::CParseResult handleRawExec(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -116,6 +120,8 @@ static Hyprlang::CParseResult handleRawExec(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleExecOnce(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -128,6 +134,8 @@ static Hyprlang::CParseResult handleExecOnce(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleMonitor(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -140,6 +148,8 @@ static Hyprlang::CParseResult handleMonitor(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleBezier(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -152,6 +162,8 @@ static Hyprlang::CParseResult handleBezier(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleAnimation(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -164,6 +176,8 @@ static Hyprlang::CParseResult handleAnimation(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleBind(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -176,6 +190,8 @@ static Hyprlang::CParseResult handleBind(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleUnbind(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -188,6 +204,8 @@ static Hyprlang::CParseResult handleUnbind(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleWindowRule(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -200,6 +218,8 @@ static Hyprlang::CParseResult handleWindowRule(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleLayerRule(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -212,6 +232,8 @@ static Hyprlang::CParseResult handleLayerRule(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleWindowRuleV2(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -224,6 +246,8 @@ static Hyprlang::CParseResult handleWindowRuleV2(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleBlurLS(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -236,6 +260,8 @@ static Hyprlang::CParseResult handleBlurLS(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleWorkspaceRules(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -248,6 +274,8 @@ static Hyprlang::CParseResult handleWorkspaceRules(const char* c, const char* v)
 }
 
 static Hyprlang::CParseResult handleSubmap(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -260,6 +288,8 @@ static Hyprlang::CParseResult handleSubmap(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleSource(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -272,6 +302,8 @@ static Hyprlang::CParseResult handleSource(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handleEnv(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -284,6 +316,8 @@ static Hyprlang::CParseResult handleEnv(const char* c, const char* v) {
 }
 
 static Hyprlang::CParseResult handlePlugin(const char* c, const char* v) {
+    g_pConfigManager->recordKeyword(c, v);
+
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
 
@@ -301,272 +335,275 @@ CConfigManager::CConfigManager() {
     configPaths.emplace_back(getMainConfigPath());
     m_pConfig = std::make_unique<Hyprlang::CConfig>(configPaths.begin()->c_str(), Hyprlang::SConfigOptions{.throwAllErrors = true, .allowMissingConfig = true});
 
-    m_pConfig->addConfigValue("general:sensitivity", {1.0f});
-    m_pConfig->addConfigValue("general:apply_sens_to_raw", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:border_size", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("general:no_border_on_floating", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:border_part_of_window", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("general:gaps_in", Hyprlang::CConfigCustomValueType{configHandleGapSet, configHandleGapDestroy, "5"});
-    m_pConfig->addConfigValue("general:gaps_out", Hyprlang::CConfigCustomValueType{configHandleGapSet, configHandleGapDestroy, "20"});
-    m_pConfig->addConfigValue("general:gaps_workspaces", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:cursor_inactive_timeout", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:no_cursor_warps", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:no_focus_fallback", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:resize_on_border", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:extend_border_grab_area", Hyprlang::INT{15});
-    m_pConfig->addConfigValue("general:hover_icon_on_border", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("general:layout", {"dwindle"});
-    m_pConfig->addConfigValue("general:allow_tearing", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:resize_corner", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("general:default_cursor_monitor", {STRVAL_EMPTY});
-
-    m_pConfig->addConfigValue("misc:disable_hyprland_logo", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:disable_splash_rendering", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:col.splash", Hyprlang::INT{0x55ffffff});
-    m_pConfig->addConfigValue("misc:splash_font_family", {"Sans"});
-    m_pConfig->addConfigValue("misc:force_default_wallpaper", Hyprlang::INT{-1});
-    m_pConfig->addConfigValue("misc:vfr", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:vrr", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:mouse_move_enables_dpms", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:key_press_enables_dpms", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:always_follow_on_dnd", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:layers_hog_keyboard_focus", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:animate_manual_resizes", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:animate_mouse_windowdragging", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:disable_autoreload", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:enable_swallow", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:swallow_regex", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("misc:swallow_exception_regex", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("misc:focus_on_activate", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:no_direct_scanout", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:hide_cursor_on_touch", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:mouse_move_focuses_monitor", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:render_ahead_of_time", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:render_ahead_safezone", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:cursor_zoom_factor", {1.f});
-    m_pConfig->addConfigValue("misc:cursor_zoom_rigid", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:allow_session_lock_restore", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:close_special_on_empty", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:background_color", Hyprlang::INT{0xff111111});
-    m_pConfig->addConfigValue("misc:new_window_takes_over_fullscreen", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:enable_hyprcursor", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("misc:hide_cursor_on_key_press", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("misc:initial_workspace_tracking", Hyprlang::INT{1});
-
-    m_pConfig->addConfigValue("group:insert_after_current", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:focus_removed_window", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:groupbar:enabled", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:groupbar:font_family", {"Sans"});
-    m_pConfig->addConfigValue("group:groupbar:font_size", Hyprlang::INT{8});
-    m_pConfig->addConfigValue("group:groupbar:gradients", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:groupbar:height", Hyprlang::INT{14});
-    m_pConfig->addConfigValue("group:groupbar:priority", Hyprlang::INT{3});
-    m_pConfig->addConfigValue("group:groupbar:render_titles", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:groupbar:scrolling", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("group:groupbar:text_color", Hyprlang::INT{0xffffffff});
-
-    m_pConfig->addConfigValue("debug:int", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:log_damage", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:overlay", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:damage_blink", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:disable_logs", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("debug:disable_time", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("debug:enable_stdout_logs", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:damage_tracking", {(Hyprlang::INT)DAMAGE_TRACKING_FULL});
-    m_pConfig->addConfigValue("debug:manual_crash", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:suppress_errors", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:error_limit", Hyprlang::INT{5});
-    m_pConfig->addConfigValue("debug:watchdog_timeout", Hyprlang::INT{5});
-    m_pConfig->addConfigValue("debug:disable_scale_checks", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("debug:colored_stdout_logs", Hyprlang::INT{1});
-
-    m_pConfig->addConfigValue("decoration:rounding", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:blur:enabled", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("decoration:blur:size", Hyprlang::INT{8});
-    m_pConfig->addConfigValue("decoration:blur:passes", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("decoration:blur:ignore_opacity", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:blur:new_optimizations", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("decoration:blur:xray", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:blur:contrast", {0.8916F});
-    m_pConfig->addConfigValue("decoration:blur:brightness", {1.0F});
-    m_pConfig->addConfigValue("decoration:blur:vibrancy", {0.1696F});
-    m_pConfig->addConfigValue("decoration:blur:vibrancy_darkness", {0.0F});
-    m_pConfig->addConfigValue("decoration:blur:noise", {0.0117F});
-    m_pConfig->addConfigValue("decoration:blur:special", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:blur:popups", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:blur:popups_ignorealpha", {0.2F});
-    m_pConfig->addConfigValue("decoration:active_opacity", {1.F});
-    m_pConfig->addConfigValue("decoration:inactive_opacity", {1.F});
-    m_pConfig->addConfigValue("decoration:fullscreen_opacity", {1.F});
-    m_pConfig->addConfigValue("decoration:no_blur_on_oversized", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:drop_shadow", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("decoration:shadow_range", Hyprlang::INT{4});
-    m_pConfig->addConfigValue("decoration:shadow_render_power", Hyprlang::INT{3});
-    m_pConfig->addConfigValue("decoration:shadow_ignore_window", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("decoration:shadow_offset", Hyprlang::VEC2{0, 0});
-    m_pConfig->addConfigValue("decoration:shadow_scale", {1.f});
-    m_pConfig->addConfigValue("decoration:col.shadow", Hyprlang::INT{0xee1a1a1a});
-    m_pConfig->addConfigValue("decoration:col.shadow_inactive", {(Hyprlang::INT)INT_MAX});
-    m_pConfig->addConfigValue("decoration:dim_inactive", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("decoration:dim_strength", {0.5f});
-    m_pConfig->addConfigValue("decoration:dim_special", {0.2f});
-    m_pConfig->addConfigValue("decoration:dim_around", {0.4f});
-    m_pConfig->addConfigValue("decoration:screen_shader", {STRVAL_EMPTY});
-
-    m_pConfig->addConfigValue("dwindle:pseudotile", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:force_split", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:permanent_direction_override", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:preserve_split", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:special_scale_factor", {1.f});
-    m_pConfig->addConfigValue("dwindle:split_width_multiplier", {1.0f});
-    m_pConfig->addConfigValue("dwindle:no_gaps_when_only", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:use_active_for_splits", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("dwindle:default_split_ratio", {1.f});
-    m_pConfig->addConfigValue("dwindle:smart_split", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("dwindle:smart_resizing", Hyprlang::INT{1});
-
-    m_pConfig->addConfigValue("master:special_scale_factor", {1.f});
-    m_pConfig->addConfigValue("master:mfact", {0.55f});
-    m_pConfig->addConfigValue("master:new_is_master", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("master:always_center_master", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("master:new_on_top", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("master:no_gaps_when_only", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("master:orientation", {"left"});
-    m_pConfig->addConfigValue("master:inherit_fullscreen", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("master:allow_small_split", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("master:smart_resizing", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("master:drop_at_cursor", Hyprlang::INT{1});
-
-    m_pConfig->addConfigValue("animations:enabled", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("animations:first_launch_animation", Hyprlang::INT{1});
-
-    m_pConfig->addConfigValue("input:follow_mouse", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:mouse_refocus", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:special_fallthrough", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:off_window_axis_events", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:sensitivity", {0.f});
-    m_pConfig->addConfigValue("input:accel_profile", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:kb_file", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:kb_layout", {"us"});
-    m_pConfig->addConfigValue("input:kb_variant", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:kb_options", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:kb_rules", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:kb_model", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:repeat_rate", Hyprlang::INT{25});
-    m_pConfig->addConfigValue("input:repeat_delay", Hyprlang::INT{600});
-    m_pConfig->addConfigValue("input:natural_scroll", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:numlock_by_default", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:resolve_binds_by_sym", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:force_no_accel", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:float_switch_override_focus", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:left_handed", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:scroll_method", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:scroll_button", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:scroll_button_lock", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:scroll_factor", {1.f});
-    m_pConfig->addConfigValue("input:scroll_points", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:touchpad:natural_scroll", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:touchpad:disable_while_typing", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:touchpad:clickfinger_behavior", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:touchpad:tap_button_map", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:touchpad:middle_button_emulation", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:touchpad:tap-to-click", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:touchpad:tap-and-drag", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:touchpad:drag_lock", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:touchpad:scroll_factor", {1.f});
-    m_pConfig->addConfigValue("input:touchdevice:transform", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:touchdevice:output", {"[[Auto]]"});
-    m_pConfig->addConfigValue("input:touchdevice:enabled", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("input:tablet:transform", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:tablet:output", {STRVAL_EMPTY});
-    m_pConfig->addConfigValue("input:tablet:region_position", Hyprlang::VEC2{0, 0});
-    m_pConfig->addConfigValue("input:tablet:region_size", Hyprlang::VEC2{0, 0});
-    m_pConfig->addConfigValue("input:tablet:relative_input", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:tablet:left_handed", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("input:tablet:active_area_position", Hyprlang::VEC2{0, 0});
-    m_pConfig->addConfigValue("input:tablet:active_area_size", Hyprlang::VEC2{0, 0});
-
-    m_pConfig->addConfigValue("binds:pass_mouse_when_bound", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("binds:scroll_event_delay", Hyprlang::INT{300});
-    m_pConfig->addConfigValue("binds:workspace_back_and_forth", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("binds:allow_workspace_cycles", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("binds:workspace_center_on", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("binds:focus_preferred_method", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("binds:ignore_group_lock", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("binds:movefocus_cycles_fullscreen", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("binds:disable_keybind_grabbing", Hyprlang::INT{0});
-
-    m_pConfig->addConfigValue("gestures:workspace_swipe", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_fingers", Hyprlang::INT{3});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_distance", Hyprlang::INT{300});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_invert", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_min_speed_to_force", Hyprlang::INT{30});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_cancel_ratio", {0.5f});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_create_new", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_direction_lock", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_direction_lock_threshold", Hyprlang::INT{10});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_forever", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_use_r", Hyprlang::INT{0});
-    m_pConfig->addConfigValue("gestures:workspace_swipe_touch", Hyprlang::INT{0});
-
-    m_pConfig->addConfigValue("xwayland:use_nearest_neighbor", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("xwayland:force_zero_scaling", Hyprlang::INT{0});
-
-    m_pConfig->addConfigValue("opengl:nvidia_anti_flicker", Hyprlang::INT{1});
-    m_pConfig->addConfigValue("opengl:force_introspection", Hyprlang::INT{2});
-
-    m_pConfig->addConfigValue("autogenerated", Hyprlang::INT{0});
-
-    m_pConfig->addConfigValue("general:col.active_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffffffff"});
-    m_pConfig->addConfigValue("general:col.inactive_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xff444444"});
-    m_pConfig->addConfigValue("general:col.nogroup_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffffaaff"});
-    m_pConfig->addConfigValue("general:col.nogroup_border_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffff00ff"});
-
-    m_pConfig->addConfigValue("group:col.border_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ffff00"});
-    m_pConfig->addConfigValue("group:col.border_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66777700"});
-    m_pConfig->addConfigValue("group:col.border_locked_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ff5500"});
-    m_pConfig->addConfigValue("group:col.border_locked_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66775500"});
-
-    m_pConfig->addConfigValue("group:groupbar:col.active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ffff00"});
-    m_pConfig->addConfigValue("group:groupbar:col.inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66777700"});
-    m_pConfig->addConfigValue("group:groupbar:col.locked_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ff5500"});
-    m_pConfig->addConfigValue("group:groupbar:col.locked_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66775500"});
+    registerConfigValue("general:sensitivity", {1.0f});
+    registerConfigValue("general:apply_sens_to_raw", Hyprlang::INT{0});
+    registerConfigValue("general:border_size", Hyprlang::INT{1});
+    registerConfigValue("general:no_border_on_floating", Hyprlang::INT{0});
+    registerConfigValue("general:border_part_of_window", Hyprlang::INT{1});
+    registerConfigValue("general:gaps_in", Hyprlang::CConfigCustomValueType{configHandleGapSet, configHandleGapDestroy, "5"});
+    registerConfigValue("general:gaps_out", Hyprlang::CConfigCustomValueType{configHandleGapSet, configHandleGapDestroy, "20"});
+    registerConfigValue("general:gaps_workspaces", Hyprlang::INT{0});
+    registerConfigValue("general:cursor_inactive_timeout", Hyprlang::INT{0});
+    registerConfigValue("general:no_cursor_warps", Hyprlang::INT{0});
+    registerConfigValue("general:no_focus_fallback", Hyprlang::INT{0});
+    registerConfigValue("general:resize_on_border", Hyprlang::INT{0});
+    registerConfigValue("general:extend_border_grab_area", Hyprlang::INT{15});
+    registerConfigValue("general:hover_icon_on_border", Hyprlang::INT{1});
+    registerConfigValue("general:layout", {"dwindle"});
+    registerConfigValue("general:allow_tearing", Hyprlang::INT{0});
+    registerConfigValue("general:resize_corner", Hyprlang::INT{0});
+    registerConfigValue("general:default_cursor_monitor", {STRVAL_EMPTY});
+
+    registerConfigValue("misc:disable_hyprland_logo", Hyprlang::INT{0});
+    registerConfigValue("misc:disable_splash_rendering", Hyprlang::INT{0});
+    registerConfigValue("misc:col.splash", Hyprlang::INT{0x55ffffff});
+    registerConfigValue("misc:splash_font_family", {"Sans"});
+    registerConfigValue("misc:force_default_wallpaper", Hyprlang::INT{-1});
+    registerConfigValue("misc:vfr", Hyprlang::INT{1});
+    registerConfigValue("misc:vrr", Hyprlang::INT{0});
+    registerConfigValue("misc:mouse_move_enables_dpms", Hyprlang::INT{0});
+    registerConfigValue("misc:key_press_enables_dpms", Hyprlang::INT{0});
+    registerConfigValue("misc:always_follow_on_dnd", Hyprlang::INT{1});
+    registerConfigValue("misc:layers_hog_keyboard_focus", Hyprlang::INT{1});
+    registerConfigValue("misc:animate_manual_resizes", Hyprlang::INT{0});
+    registerConfigValue("misc:animate_mouse_windowdragging", Hyprlang::INT{0});
+    registerConfigValue("misc:disable_autoreload", Hyprlang::INT{0});
+    registerConfigValue("misc:enable_swallow", Hyprlang::INT{0});
+    registerConfigValue("misc:swallow_regex", {STRVAL_EMPTY});
+    registerConfigValue("misc:swallow_exception_regex", {STRVAL_EMPTY});
+    registerConfigValue("misc:focus_on_activate", Hyprlang::INT{0});
+    registerConfigValue("misc:no_direct_scanout", Hyprlang::INT{1});
+    registerConfigValue("misc:hide_cursor_on_touch", Hyprlang::INT{1});
+    registerConfigValue("misc:mouse_move_focuses_monitor", Hyprlang::INT{1});
+    registerConfigValue("misc:render_ahead_of_time", Hyprlang::INT{0});
+    registerConfigValue("misc:render_ahead_safezone", Hyprlang::INT{1});
+    registerConfigValue("misc:cursor_zoom_factor", {1.f});
+    registerConfigValue("misc:cursor_zoom_rigid", Hyprlang::INT{0});
+    registerConfigValue("misc:allow_session_lock_restore", Hyprlang::INT{0});
+    registerConfigValue("misc:close_special_on_empty", Hyprlang::INT{1});
+    registerConfigValue("misc:background_color", Hyprlang::INT{0xff111111});
+    registerConfigValue("misc:new_window_takes_over_fullscreen", Hyprlang::INT{0});
+    registerConfigValue("misc:enable_hyprcursor", Hyprlang::INT{1});
+    registerConfigValue("misc:hide_cursor_on_key_press", Hyprlang::INT{0});
+    registerConfigValue("misc:initial_workspace_tracking", Hyprlang::INT{1});
+    registerConfigValue("misc:socket2_max_queued", Hyprlang::INT{1024});
+    registerConfigValue("misc:socket2_overflow_policy", Hyprlang::INT{0});
+
+    registerConfigValue("group:insert_after_current", Hyprlang::INT{1});
+    registerConfigValue("group:focus_removed_window", Hyprlang::INT{1});
+    registerConfigValue("group:groupbar:enabled", Hyprlang::INT{1});
+    registerConfigValue("group:groupbar:font_family", {"Sans"});
+    registerConfigValue("group:groupbar:font_size", Hyprlang::INT{8});
+    registerConfigValue("group:groupbar:gradients", Hyprlang::INT{1});
+    registerConfigValue("group:groupbar:height", Hyprlang::INT{14});
+    registerConfigValue("group:groupbar:priority", Hyprlang::INT{3});
+    registerConfigValue("group:groupbar:render_titles", Hyprlang::INT{1});
+    registerConfigValue("group:groupbar:scrolling", Hyprlang::INT{1});
+    registerConfigValue("group:groupbar:text_color", Hyprlang::INT{0xffffffff});
+
+    registerConfigValue("debug:int", Hyprlang::INT{0});
+    registerConfigValue("debug:log_damage", Hyprlang::INT{0});
+    registerConfigValue("debug:overlay", Hyprlang::INT{0});
+    registerConfigValue("debug:damage_blink", Hyprlang::INT{0});
+    registerConfigValue("debug:disable_logs", Hyprlang::INT{1});
+    registerConfigValue("debug:disable_time", Hyprlang::INT{1});
+    registerConfigValue("debug:enable_stdout_logs", Hyprlang::INT{0});
+    registerConfigValue("debug:damage_tracking", {(Hyprlang::INT)DAMAGE_TRACKING_FULL});
+    registerConfigValue("debug:manual_crash", Hyprlang::INT{0});
+    registerConfigValue("debug:suppress_errors", Hyprlang::INT{0});
+    registerConfigValue("debug:error_limit", Hyprlang::INT{5});
+    registerConfigValue("debug:watchdog_timeout", Hyprlang::INT{5});
+    registerConfigValue("debug:disable_scale_checks", Hyprlang::INT{0});
+    registerConfigValue("debug:colored_stdout_logs", Hyprlang::INT{1});
+
+    registerConfigValue("decoration:rounding", Hyprlang::INT{0});
+    registerConfigValue("decoration:blur:enabled", Hyprlang::INT{1});
+    registerConfigValue("decoration:blur:size", Hyprlang::INT{8});
+    registerConfigValue("decoration:blur:passes", Hyprlang::INT{1});
+    registerConfigValue("decoration:blur:ignore_opacity", Hyprlang::INT{0});
+    registerConfigValue("decoration:blur:new_optimizations", Hyprlang::INT{1});
+    registerConfigValue("decoration:blur:xray", Hyprlang::INT{0});
+    registerConfigValue("decoration:blur:contrast", {0.8916F});
+    registerConfigValue("decoration:blur:brightness", {1.0F});
+    registerConfigValue("decoration:blur:vibrancy", {0.1696F});
+    registerConfigValue("decoration:blur:vibrancy_darkness", {0.0F});
+    registerConfigValue("decoration:blur:noise", {0.0117F});
+    registerConfigValue("decoration:blur:special", Hyprlang::INT{0});
+    registerConfigValue("decoration:blur:popups", Hyprlang::INT{0});
+    registerConfigValue("decoration:blur:popups_ignorealpha", {0.2F});
+    registerConfigValue("decoration:active_opacity", {1.F});
+    registerConfigValue("decoration:inactive_opacity", {1.F});
+    registerConfigValue("decoration:fullscreen_opacity", {1.F});
+    registerConfigValue("decoration:no_blur_on_oversized", Hyprlang::INT{0});
+    registerConfigValue("decoration:drop_shadow", Hyprlang::INT{1});
+    registerConfigValue("decoration:shadow_range", Hyprlang::INT{4});
+    registerConfigValue("decoration:shadow_render_power", Hyprlang::INT{3});
+    registerConfigValue("decoration:shadow_ignore_window", Hyprlang::INT{1});
+    registerConfigValue("decoration:shadow_offset", Hyprlang::VEC2{0, 0});
+    registerConfigValue("decoration:shadow_scale", {1.f});
+    registerConfigValue("decoration:col.shadow", Hyprlang::INT{0xee1a1a1a});
+    registerConfigValue("decoration:col.shadow_inactive", {(Hyprlang::INT)INT_MAX});
+    registerConfigValue("decoration:dim_inactive", Hyprlang::INT{0});
+    registerConfigValue("decoration:dim_strength", {0.5f});
+    registerConfigValue("decoration:dim_special", {0.2f});
+    registerConfigValue("decoration:dim_around", {0.4f});
+    registerConfigValue("decoration:screen_shader", {STRVAL_EMPTY});
+
+    registerConfigValue("dwindle:pseudotile", Hyprlang::INT{0});
+    registerConfigValue("dwindle:force_split", Hyprlang::INT{0});
+    registerConfigValue("dwindle:permanent_direction_override", Hyprlang::INT{0});
+    registerConfigValue("dwindle:preserve_split", Hyprlang::INT{0});
+    registerConfigValue("dwindle:special_scale_factor", {1.f});
+    registerConfigValue("dwindle:split_width_multiplier", {1.0f});
+    registerConfigValue("dwindle:no_gaps_when_only", Hyprlang::INT{0});
+    registerConfigValue("dwindle:use_active_for_splits", Hyprlang::INT{1});
+    registerConfigValue("dwindle:default_split_ratio", {1.f});
+    registerConfigValue("dwindle:smart_split", Hyprlang::INT{0});
+    registerConfigValue("dwindle:smart_resizing", Hyprlang::INT{1});
+
+    registerConfigValue("master:special_scale_factor", {1.f});
+    registerConfigValue("master:mfact", {0.55f});
+    registerConfigValue("master:new_is_master", Hyprlang::INT{1});
+    registerConfigValue("master:always_center_master", Hyprlang::INT{0});
+    registerConfigValue("master:new_on_top", Hyprlang::INT{0});
+    registerConfigValue("master:no_gaps_when_only", Hyprlang::INT{0});
+    registerConfigValue("master:orientation", {"left"});
+    registerConfigValue("master:inherit_fullscreen", Hyprlang::INT{1});
+    registerConfigValue("master:allow_small_split", Hyprlang::INT{0});
+    registerConfigValue("master:smart_resizing", Hyprlang::INT{1});
+    registerConfigValue("master:drop_at_cursor", Hyprlang::INT{1});
+
+    registerConfigValue("animations:enabled", Hyprlang::INT{1});
+    registerConfigValue("animations:first_launch_animation", Hyprlang::INT{1});
+
+    registerConfigValue("input:follow_mouse", Hyprlang::INT{1});
+    registerConfigValue("input:mouse_refocus", Hyprlang::INT{1});
+    registerConfigValue("input:special_fallthrough", Hyprlang::INT{0});
+    registerConfigValue("input:off_window_axis_events", Hyprlang::INT{1});
+    registerConfigValue("input:sensitivity", {0.f});
+    registerConfigValue("input:accel_profile", {STRVAL_EMPTY});
+    registerConfigValue("input:kb_file", {STRVAL_EMPTY});
+    registerConfigValue("input:kb_layout", {"us"});
+    registerConfigValue("input:kb_variant", {STRVAL_EMPTY});
+    registerConfigValue("input:kb_options", {STRVAL_EMPTY});
+    registerConfigValue("input:kb_rules", {STRVAL_EMPTY});
+    registerConfigValue("input:kb_model", {STRVAL_EMPTY});
+    registerConfigValue("input:repeat_rate", Hyprlang::INT{25});
+    registerConfigValue("input:repeat_delay", Hyprlang::INT{600});
+    registerConfigValue("input:natural_scroll", Hyprlang::INT{0});
+    registerConfigValue("input:numlock_by_default", Hyprlang::INT{0});
+    registerConfigValue("input:resolve_binds_by_sym", Hyprlang::INT{0});
+    registerConfigValue("input:force_no_accel", Hyprlang::INT{0});
+    registerConfigValue("input:float_switch_override_focus", Hyprlang::INT{1});
+    registerConfigValue("input:left_handed", Hyprlang::INT{0});
+    registerConfigValue("input:scroll_method", {STRVAL_EMPTY});
+    registerConfigValue("input:scroll_button", Hyprlang::INT{0});
+    registerConfigValue("input:scroll_button_lock", Hyprlang::INT{0});
+    registerConfigValue("input:scroll_factor", {1.f});
+    registerConfigValue("input:scroll_points", {STRVAL_EMPTY});
+    registerConfigValue("input:touchpad:natural_scroll", Hyprlang::INT{0});
+    registerConfigValue("input:touchpad:disable_while_typing", Hyprlang::INT{1});
+    registerConfigValue("input:touchpad:clickfinger_behavior", Hyprlang::INT{0});
+    registerConfigValue("input:touchpad:tap_button_map", {STRVAL_EMPTY});
+    registerConfigValue("input:touchpad:middle_button_emulation", Hyprlang::INT{0});
+    registerConfigValue("input:touchpad:tap-to-click", Hyprlang::INT{1});
+    registerConfigValue("input:touchpad:tap-and-drag", Hyprlang::INT{1});
+    registerConfigValue("input:touchpad:drag_lock", Hyprlang::INT{0});
+    registerConfigValue("input:touchpad:scroll_factor", {1.f});
+    registerConfigValue("input:touchdevice:transform", Hyprlang::INT{0});
+    registerConfigValue("input:touchdevice:output", {"[[Auto]]"});
+    registerConfigValue("input:touchdevice:enabled", Hyprlang::INT{1});
+    registerConfigValue("input:tablet:transform", Hyprlang::INT{0});
+    registerConfigValue("input:tablet:output", {STRVAL_EMPTY});
+    registerConfigValue("input:tablet:region_position", Hyprlang::VEC2{0, 0});
+    registerConfigValue("input:tablet:region_size", Hyprlang::VEC2{0, 0});
+    registerConfigValue("input:tablet:relative_input", Hyprlang::INT{0});
+    registerConfigValue("input:tablet:left_handed", Hyprlang::INT{0});
+    registerConfigValue("input:tablet:active_area_position", Hyprlang::VEC2{0, 0});
+    registerConfigValue("input:tablet:active_area_size", Hyprlang::VEC2{0, 0});
+
+    registerConfigValue("binds:pass_mouse_when_bound", Hyprlang::INT{0});
+    registerConfigValue("binds:scroll_event_delay", Hyprlang::INT{300});
+    registerConfigValue("binds:workspace_back_and_forth", Hyprlang::INT{0});
+    registerConfigValue("binds:allow_workspace_cycles", Hyprlang::INT{0});
+    registerConfigValue("binds:workspace_center_on", Hyprlang::INT{1});
+    registerConfigValue("binds:focus_preferred_method", Hyprlang::INT{0});
+    registerConfigValue("binds:ignore_group_lock", Hyprlang::INT{0});
+    registerConfigValue("binds:movefocus_cycles_fullscreen", Hyprlang::INT{1});
+    registerConfigValue("binds:disable_keybind_grabbing", Hyprlang::INT{0});
+
+    registerConfigValue("gestures:workspace_swipe", Hyprlang::INT{0});
+    registerConfigValue("gestures:workspace_swipe_fingers", Hyprlang::INT{3});
+    registerConfigValue("gestures:workspace_swipe_distance", Hyprlang::INT{300});
+    registerConfigValue("gestures:workspace_swipe_invert", Hyprlang::INT{1});
+    registerConfigValue("gestures:workspace_swipe_min_speed_to_force", Hyprlang::INT{30});
+    registerConfigValue("gestures:workspace_swipe_cancel_ratio", {0.5f});
+    registerConfigValue("gestures:workspace_swipe_create_new", Hyprlang::INT{1});
+    registerConfigValue("gestures:workspace_swipe_direction_lock", Hyprlang::INT{1});
+    registerConfigValue("gestures:workspace_swipe_direction_lock_threshold", Hyprlang::INT{10});
+    registerConfigValue("gestures:workspace_swipe_forever", Hyprlang::INT{0});
+    registerConfigValue("gestures:workspace_swipe_use_r", Hyprlang::INT{0});
+    registerConfigValue("gestures:workspace_swipe_touch", Hyprlang::INT{0});
+
+    registerConfigValue("xwayland:use_nearest_neighbor", Hyprlang::INT{1});
+    registerConfigValue("xwayland:force_zero_scaling", Hyprlang::INT{0});
+
+    registerConfigValue("opengl:nvidia_anti_flicker", Hyprlang::INT{1});
+    registerConfigValue("opengl:force_introspection", Hyprlang::INT{2});
+    registerConfigValue("opengl:memory_budget", Hyprlang::INT{0});
+
+    registerConfigValue("autogenerated", Hyprlang::INT{0});
+
+    registerConfigValue("general:col.active_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffffffff"});
+    registerConfigValue("general:col.inactive_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xff444444"});
+    registerConfigValue("general:col.nogroup_border", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffffaaff"});
+    registerConfigValue("general:col.nogroup_border_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0xffff00ff"});
+
+    registerConfigValue("group:col.border_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ffff00"});
+    registerConfigValue("group:col.border_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66777700"});
+    registerConfigValue("group:col.border_locked_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ff5500"});
+    registerConfigValue("group:col.border_locked_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66775500"});
+
+    registerConfigValue("group:groupbar:col.active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ffff00"});
+    registerConfigValue("group:groupbar:col.inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66777700"});
+    registerConfigValue("group:groupbar:col.locked_active", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66ff5500"});
+    registerConfigValue("group:groupbar:col.locked_inactive", Hyprlang::CConfigCustomValueType{&configHandleGradientSet, configHandleGradientDestroy, "0x66775500"});
 
     // devices
     m_pConfig->addSpecialCategory("device", {"name"});
-    m_pConfig->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_pConfig->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_pConfig->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_pConfig->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_pConfig->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_pConfig->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "transform", Hyprlang::INT{0});
-    m_pConfig->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_pConfig->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_pConfig->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_pConfig->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    registerDeviceConfigValue("sensitivity", {0.F});
+    registerDeviceConfigValue("accel_profile", {STRVAL_EMPTY});
+    registerDeviceConfigValue("kb_file", {STRVAL_EMPTY});
+    registerDeviceConfigValue("kb_layout", {"us"});
+    registerDeviceConfigValue("kb_variant", {STRVAL_EMPTY});
+    registerDeviceConfigValue("kb_options", {STRVAL_EMPTY});
+    registerDeviceConfigValue("kb_rules", {STRVAL_EMPTY});
+    registerDeviceConfigValue("kb_model", {STRVAL_EMPTY});
+    registerDeviceConfigValue("repeat_rate", Hyprlang::INT{25});
+    registerDeviceConfigValue("repeat_delay", Hyprlang::INT{600});
+    registerDeviceConfigValue("natural_scroll", Hyprlang::INT{0});
+    registerDeviceConfigValue("tap_button_map", {STRVAL_EMPTY});
+    registerDeviceConfigValue("numlock_by_default", Hyprlang::INT{0});
+    registerDeviceConfigValue("resolve_binds_by_sym", Hyprlang::INT{0});
+    registerDeviceConfigValue("disable_while_typing", Hyprlang::INT{1});
+    registerDeviceConfigValue("clickfinger_behavior", Hyprlang::INT{0});
+    registerDeviceConfigValue("middle_button_emulation", Hyprlang::INT{0});
+    registerDeviceConfigValue("tap-to-click", Hyprlang::INT{1});
+    registerDeviceConfigValue("tap-and-drag", Hyprlang::INT{1});
+    registerDeviceConfigValue("drag_lock", Hyprlang::INT{0});
+    registerDeviceConfigValue("left_handed", Hyprlang::INT{0});
+    registerDeviceConfigValue("scroll_method", {STRVAL_EMPTY});
+    registerDeviceConfigValue("scroll_button", Hyprlang::INT{0});
+    registerDeviceConfigValue("scroll_button_lock", Hyprlang::INT{0});
+    registerDeviceConfigValue("scroll_points", {STRVAL_EMPTY});
+    registerDeviceConfigValue("transform", Hyprlang::INT{0});
+    registerDeviceConfigValue("output", {STRVAL_EMPTY});
+    registerDeviceConfigValue("enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    registerDeviceConfigValue("region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    registerDeviceConfigValue("region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    registerDeviceConfigValue("relative_input", Hyprlang::INT{0});           // only for tablets
+    registerDeviceConfigValue("active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    registerDeviceConfigValue("active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
 
     // keywords
     m_pConfig->registerHandler(&::handleRawExec, "exec", {false});
@@ -625,13 +662,172 @@ std::string CConfigManager::getErrors() {
     return m_szConfigErrors;
 }
 
-void CConfigManager::reload() {
+const SConfigReloadStats& CConfigManager::getReloadStats() {
+    return m_sReloadStats;
+}
+
+void CConfigManager::registerConfigValue(const char* name, const Hyprlang::CConfigValue& value) {
+    m_pConfig->addConfigValue(name, value);
+    m_vConfigValueNames.emplace_back(name);
+}
+
+void CConfigManager::registerDeviceConfigValue(const char* name, const Hyprlang::CConfigValue& value) {
+    m_pConfig->addSpecialConfigValue("device", name, value);
+    m_vDeviceConfigValueNames.emplace_back(name);
+}
+
+void CConfigManager::recordKeyword(const std::string& keyword, const std::string& value) {
+    m_mKeywordLines[keyword] += value + "\n";
+}
+
+static std::string configValueToString(Hyprlang::CConfigValue* value) {
+    if (!value)
+        return "";
+
+    const auto VAL  = value->getValue();
+    const auto TYPE = std::type_index(VAL.type());
+
+    if (TYPE == typeid(Hyprlang::INT))
+        return std::to_string(std::any_cast<Hyprlang::INT>(VAL));
+    else if (TYPE == typeid(Hyprlang::FLOAT))
+        return std::format("{}", std::any_cast<Hyprlang::FLOAT>(VAL));
+    else if (TYPE == typeid(Hyprlang::VEC2))
+        return std::format("{} {}", std::any_cast<Hyprlang::VEC2>(VAL).x, std::any_cast<Hyprlang::VEC2>(VAL).y);
+    else if (TYPE == typeid(Hyprlang::STRING))
+        return std::any_cast<Hyprlang::STRING>(VAL) ? std::any_cast<Hyprlang::STRING>(VAL) : "";
+    else if (TYPE == typeid(void*))
+        return ((ICustomConfigValueData*)std::any_cast<void*>(VAL))->toString();
+
+    return "";
+}
+
+// what has to be re-applied when a value or keyword changes. Most values are read live, these are the ones something caches.
+static uint32_t configSectionsFor(const std::string& key) {
+    // keywords
+    if (key == "monitor")
+        return CONFIG_SECTION_MONITORS;
+    if (key.starts_with("bind") || key == "unbind" || key == "submap")
+        return CONFIG_SECTION_BINDS;
+    if (key == "windowrule" || key == "windowrulev2" || key == "layerrule")
+        return CONFIG_SECTION_RULES;
+    if (key == "workspace")
+        return CONFIG_SECTION_RULES | CONFIG_SECTION_LAYOUT;
+    if (key == "bezier" || key == "animation")
+        return CONFIG_SECTION_ANIMATIONS;
+    if (key == "blurls")
+        return CONFIG_SECTION_RENDER;
+    if (key == "exec" || key == "exec-once" || key == "env" || key == "source" || key == "plugin")
+        return CONFIG_SECTION_OTHER;
+
+    // values
+    if (key.starts_with("input:") || key.starts_with("device["))
+        return CONFIG_SECTION_INPUT;
+    if (key == "decoration:screen_shader")
+        return CONFIG_SECTION_SHADER;
+    if (key == "misc:vrr")
+        return CONFIG_SECTION_MONITORS;
+    if (key.starts_with("general:"))
+        return CONFIG_SECTION_LAYOUT | CONFIG_SECTION_DECORATION;
+    if (key.starts_with("decoration:"))
+        return CONFIG_SECTION_DECORATION;
+    if (key.starts_with("dwindle:") || key.starts_with("master:"))
+        return CONFIG_SECTION_LAYOUT;
+    if (key.starts_with("group:"))
+        return CONFIG_SECTION_LAYOUT | CONFIG_SECTION_DECORATION;
+    if (key.starts_with("xwayland:"))
+        return CONFIG_SECTION_MONITORS | CONFIG_SECTION_LAYOUT | CONFIG_SECTION_RENDER; // force_zero_scaling changes how xwayland windows are sized
+    if (key.starts_with("animations:"))
+        return CONFIG_SECTION_ANIMATIONS;
+    if (key.starts_with("binds:") || key.starts_with("gestures:"))
+        return CONFIG_SECTION_OTHER;
+    if (key.starts_with("plugin:"))
+        return CONFIG_SECTION_ALL; // no idea what plugins cache
+
+    return CONFIG_SECTION_RENDER;
+}
+
+uint32_t CConfigManager::takeConfigSnapshot() {
+    auto snapshot = m_mKeywordLines;
+
+    for (auto& name : m_vConfigValueNames) {
+        snapshot[name] = configValueToString(m_pConfig->getConfigValuePtr(name.c_str()));
+    }
+
+    for (auto& [handle, field] : pluginVariables) {
+        snapshot["plugin:" + field] = configValueToString(m_pConfig->getSpecialConfigValuePtr("plugin", field.c_str(), nullptr));
+    }
+
+    // device categories are only applied to connected devices
+    if (g_pInputManager) {
+        const auto ADDDEVICE = [&](std::string name) {
+            std::replace(name.begin(), name.end(), ' ', '-');
+
+            if (!m_pConfig->specialCategoryExistsForKey("device", name.c_str()))
+                return;
+
+            for (auto& field : m_vDeviceConfigValueNames) {
+                snapshot[std::format("device[{}]:{}", name, field)] = configValueToString(m_pConfig->getSpecialConfigValuePtr("device", field.c_str(), name.c_str()));
+            }
+        };
+
+        for (auto& k : g_pInputManager->m_lKeyboards)
+            ADDDEVICE(k.name);
+        for (auto& m : g_pInputManager->m_lMice)
+            ADDDEVICE(m.name);
+        for (auto& t : g_pInputManager->m_lTouchDevices)
+            ADDDEVICE(t.name);
+        for (auto& t : g_pInputManager->m_lTablets)
+            ADDDEVICE(t.name);
+    }
+
+    uint32_t changed = 0;
+
+    if (m_mConfigSnapshot.empty())
+        changed = CONFIG_SECTION_ALL;
+    else {
+        for (auto& [key, value] : snapshot) {
+            const auto IT = m_mConfigSnapshot.find(key);
+            if (IT == m_mConfigSnapshot.end() || IT->second != value)
+                changed |= configSectionsFor(key);
+        }
+
+        for (auto& [key, value] : m_mConfigSnapshot) {
+            if (!snapshot.contains(key))
+                changed |= configSectionsFor(key);
+        }
+    }
+
+    m_mConfigSnapshot = std::move(snapshot);
+
+    return changed;
+}
+
+static float msSince(std::chrono::steady_clock::time_point& since) {
+    const auto NOW = std::chrono::steady_clock::now();
+    const auto MS  = std::chrono::duration_cast<std::chrono::microseconds>(NOW - since).count() / 1000.F;
+    since          = NOW;
+    return MS;
+}
+
+void CConfigManager::reload(bool force) {
     EMIT_HOOK_EVENT("preConfigReload", nullptr);
+
+    m_sReloadStats.lastPhases.clear();
+    auto phaseStart = std::chrono::steady_clock::now();
+
     setDefaultAnimationVars();
     resetHLConfig();
     configCurrentPath = getMainConfigPath();
     const auto ERR    = m_pConfig->parse();
-    postConfigReload(ERR);
+
+    m_sReloadStats.lastPhases.emplace_back("parse", msSince(phaseStart));
+
+    // forced reloads (hyprctl reload, plugin loads) re-apply everything
+    const auto CHANGED = takeConfigSnapshot();
+
+    m_sReloadStats.lastPhases.emplace_back("diff", msSince(phaseStart));
+
+    postConfigReload(ERR, force ? CONFIG_SECTION_ALL : CHANGED);
 }
 
 void CConfigManager::setDefaultAnimationVars() {
@@ -724,6 +920,7 @@ std::optional<std::string> CConfigManager::verifyConfigExists() {
 std::optional<std::string> CConfigManager::resetHLConfig() {
     m_dMonitorRules.clear();
     m_dWindowRules.clear();
+    m_sWindowRuleIndex.dirty = true;
     g_pKeybindManager->clearKeybinds();
     g_pAnimationManager->removeAllBeziers();
     m_mAdditionalReservedAreas.clear();
@@ -733,6 +930,7 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     m_vDeclaredPlugins.clear();
     m_dLayerRules.clear();
     m_vFailedPluginConfigValues.clear();
+    m_mKeywordLines.clear();
 
     // paths
     configPaths.clear();
@@ -745,23 +943,36 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
     return RET;
 }
 
-void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
-    for (auto& w : g_pCompositor->m_vWindows) {
-        w->uncacheWindowDecos();
+void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result, uint32_t changed) {
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    if (changed & CONFIG_SECTION_DECORATION) {
+        for (auto& w : g_pCompositor->m_vWindows) {
+            w->uncacheWindowDecos();
+        }
+    }
+
+    m_sReloadStats.lastPhases.emplace_back("decorations", msSince(phaseStart));
+
+    // decorations and workspace rules change what's reserved for windows too
+    if (changed & (CONFIG_SECTION_LAYOUT | CONFIG_SECTION_DECORATION | CONFIG_SECTION_RULES)) {
+        for (auto& m : g_pCompositor->m_vMonitors)
+            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
     }
 
-    for (auto& m : g_pCompositor->m_vMonitors)
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+    m_sReloadStats.lastPhases.emplace_back("layout", msSince(phaseStart));
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
-    if (!isFirstLaunch) {
+    if (!isFirstLaunch && (changed & CONFIG_SECTION_INPUT)) {
         g_pInputManager->setKeyboardLayout();
         g_pInputManager->setPointerConfigs();
         g_pInputManager->setTouchDeviceConfigs();
         g_pInputManager->setTabletConfigs();
     }
 
-    if (!isFirstLaunch)
+    m_sReloadStats.lastPhases.emplace_back("input", msSince(phaseStart));
+
+    if (!isFirstLaunch && (changed & CONFIG_SECTION_SHADER))
         g_pHyprOpenGL->m_bReloadScreenShader = true;
 
     // parseError will be displayed next frame
@@ -783,29 +994,38 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     // not on first launch because monitors might not exist yet
     // and they'll be taken care of in the newMonitor event
     // ignore if nomonitorreload is set
-    if (!isFirstLaunch && !m_bNoMonitorReload) {
+    if (!isFirstLaunch && !m_bNoMonitorReload && (changed & CONFIG_SECTION_MONITORS)) {
         // check
         performMonitorReload();
         ensureMonitorStatus();
         ensureVRR();
     }
 
-    if (!isFirstLaunch && !g_pCompositor->m_bUnsafeState)
-        refreshGroupBarGradients();
+    m_sReloadStats.lastPhases.emplace_back("monitors", msSince(phaseStart));
 
-    // Updates dynamic window and workspace rules
-    for (auto& w : g_pCompositor->m_vWorkspaces) {
-        if (w->inert())
-            continue;
-        g_pCompositor->updateWorkspaceWindows(w->m_iID);
-        g_pCompositor->updateWorkspaceSpecialRenderData(w->m_iID);
+    if (!isFirstLaunch && !g_pCompositor->m_bUnsafeState && (changed & CONFIG_SECTION_DECORATION)) {
+        g_pGroupBarTextureCache->clear();
+        g_pShadowTextureCache->clear();
     }
 
-    // Update window border colors
-    g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+    if (changed & (CONFIG_SECTION_RULES | CONFIG_SECTION_LAYOUT | CONFIG_SECTION_DECORATION)) {
+        // Updates dynamic window and workspace rules
+        for (auto& w : g_pCompositor->m_vWorkspaces) {
+            if (w->inert())
+                continue;
+            g_pCompositor->updateWorkspaceWindows(w->m_iID);
+            g_pCompositor->updateWorkspaceSpecialRenderData(w->m_iID);
+        }
+
+        // Update window border colors
+        g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+    }
 
     // update layout
-    g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_pConfig->getConfigValue("general:layout")));
+    if (changed & CONFIG_SECTION_LAYOUT)
+        g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_pConfig->getConfigValue("general:layout")));
+
+    m_sReloadStats.lastPhases.emplace_back("rules", msSince(phaseStart));
 
     // manual crash
     if (std::any_cast<Hyprlang::INT>(m_pConfig->getConfigValue("debug:manual_crash")) && !m_bManualCrashInitiated) {
@@ -822,29 +1042,47 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 
     Debug::coloredLogs = reinterpret_cast<int64_t* const*>(m_pConfig->getConfigValuePtr("debug:colored_stdout_logs")->getDataStaticPtr());
 
-    for (auto& m : g_pCompositor->m_vMonitors) {
-        // mark blur dirty
-        g_pHyprOpenGL->markBlurDirtyForMonitor(m.get());
+    constexpr uint32_t VISIBLE =
+        CONFIG_SECTION_LAYOUT | CONFIG_SECTION_DECORATION | CONFIG_SECTION_RULES | CONFIG_SECTION_MONITORS | CONFIG_SECTION_SHADER | CONFIG_SECTION_RENDER;
 
-        g_pCompositor->scheduleFrameForMonitor(m.get());
+    if (changed & VISIBLE) {
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            // mark blur dirty
+            g_pHyprOpenGL->markBlurDirtyForMonitor(m.get());
 
-        // Force the compositor to fully re-render all monitors
-        m->forceFullFrames = 2;
+            g_pCompositor->scheduleFrameForMonitor(m.get());
 
-        // also force mirrors, as the aspect ratio could've changed
-        for (auto& mirror : m->mirrors)
-            mirror->forceFullFrames = 3;
+            // Force the compositor to fully re-render all monitors
+            m->forceFullFrames = 2;
+
+            // also force mirrors, as the aspect ratio could've changed
+            for (auto& mirror : m->mirrors)
+                mirror->forceFullFrames = 3;
+        }
     }
 
+    m_sReloadStats.lastPhases.emplace_back("render", msSince(phaseStart));
+
     // Reset no monitor reload
     m_bNoMonitorReload = false;
 
     // update plugins
     handlePluginLoads();
 
+    m_sReloadStats.lastPhases.emplace_back("plugins", msSince(phaseStart));
+
     EMIT_HOOK_EVENT("configReloaded", nullptr);
     if (g_pEventManager)
         g_pEventManager->postEvent(SHyprIPCEvent{"configreloaded", ""});
+
+    m_sReloadStats.lastPhases.emplace_back("hooks", msSince(phaseStart));
+
+    m_sReloadStats.reloads++;
+    if (changed != CONFIG_SECTION_ALL)
+        m_sReloadStats.incremental++;
+    m_sReloadStats.lastChanged = changed;
+
+    Debug::log(LOG, "Config reloaded, re-applied sections {:x}", changed);
 }
 
 void CConfigManager::init() {
@@ -866,6 +1104,9 @@ void CConfigManager::init() {
 std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::string& VALUE) {
     const auto RET = m_pConfig->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
+    // the live config no longer matches the snapshot, reloading the file has to re-apply everything
+    m_mConfigSnapshot.clear();
+
     // invalidate layouts if they changed
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
         for (auto& m : g_pCompositor->m_vMonitors)
@@ -915,9 +1156,10 @@ void CConfigManager::tick() {
     }
 
     if (parse) {
-        m_bForceReload = false;
+        const bool FORCE = m_bForceReload;
+        m_bForceReload   = false;
 
-        reload();
+        reload(FORCE);
     }
 }
 
@@ -1037,55 +1279,41 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(PHLWINDOW pWindow, boo
     bool hasFloating   = pWindow->m_bIsFloating;
     bool hasFullscreen = pWindow->m_bIsFullscreen;
 
-    for (auto& rule : m_dWindowRules) {
+    if (m_sWindowRuleIndex.dirty)
+        rebuildWindowRuleIndex();
+
+    // only rules that can match this class, in their config order
+    std::vector<size_t> candidates;
+    if (const auto IT = m_sWindowRuleIndex.byClass.find(appidclass); IT != m_sWindowRuleIndex.byClass.end()) {
+        candidates.reserve(IT->second.size() + m_sWindowRuleIndex.residual.size());
+        std::merge(IT->second.begin(), IT->second.end(), m_sWindowRuleIndex.residual.begin(), m_sWindowRuleIndex.residual.end(), std::back_inserter(candidates));
+    } else
+        candidates = m_sWindowRuleIndex.residual;
+
+    for (const auto& IDX : candidates) {
+        const auto& rule = m_dWindowRules[IDX];
+
         // check if we have a matching rule
         if (!rule.v2) {
-            try {
-                if (rule.szValue.starts_with("title:")) {
-                    // we have a title rule.
-                    std::regex RULECHECK(rule.szValue.substr(6));
-
-                    if (!std::regex_search(title, RULECHECK))
-                        continue;
-                } else {
-                    std::regex classCheck(rule.szValue);
+            // v1 rules are compiled into either a class or a title pattern
+            if (rule.rTitle && !rule.rTitle->passes(title))
+                continue;
 
-                    if (!std::regex_search(appidclass, classCheck))
-                        continue;
-                }
-            } catch (...) {
-                Debug::log(ERR, "Regex error at {}", rule.szValue);
+            if (rule.rClass && !rule.rClass->passes(appidclass))
                 continue;
-            }
         } else {
             try {
-                if (rule.szClass != "") {
-                    std::regex RULECHECK(rule.szClass);
+                if (rule.rClass && !rule.rClass->passes(appidclass))
+                    continue;
 
-                    if (!std::regex_search(appidclass, RULECHECK))
-                        continue;
-                }
+                if (rule.rTitle && !rule.rTitle->passes(title))
+                    continue;
 
-                if (rule.szTitle != "") {
-                    std::regex RULECHECK(rule.szTitle);
+                if (rule.rInitialTitle && !rule.rInitialTitle->passes(pWindow->m_szInitialTitle))
+                    continue;
 
-                    if (!std::regex_search(title, RULECHECK))
-                        continue;
-                }
-
-                if (rule.szInitialTitle != "") {
-                    std::regex RULECHECK(rule.szInitialTitle);
-
-                    if (!std::regex_search(pWindow->m_szInitialTitle, RULECHECK))
-                        continue;
-                }
-
-                if (rule.szInitialClass != "") {
-                    std::regex RULECHECK(rule.szInitialClass);
-
-                    if (!std::regex_search(pWindow->m_szInitialClass, RULECHECK))
-                        continue;
-                }
+                if (rule.rInitialClass && !rule.rInitialClass->passes(pWindow->m_szInitialClass))
+                    continue;
 
                 if (rule.bX11 != -1) {
                     if (pWindow->m_bIsX11 != rule.bX11)
@@ -1139,7 +1367,7 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(PHLWINDOW pWindow, boo
                     }
                 }
             } catch (std::exception& e) {
-                Debug::log(ERR, "Regex error at {} ({})", rule.szValue, e.what());
+                Debug::log(ERR, "Rule error at {} ({})", rule.szValue, e.what());
                 continue;
             }
         }
@@ -1178,6 +1406,31 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(PHLWINDOW pWindow, boo
     return returns;
 }
 
+void CConfigManager::rebuildWindowRuleIndex() {
+    m_sWindowRuleIndex.byClass.clear();
+    m_sWindowRuleIndex.residual.clear();
+
+    for (size_t i = 0; i < m_dWindowRules.size(); ++i) {
+        const auto& RULE     = m_dWindowRules[i];
+        const auto  LITERALS = RULE.rClass ? RULE.rClass->getExactLiterals() : nullptr;
+
+        if (!LITERALS) {
+            m_sWindowRuleIndex.residual.push_back(i);
+            continue;
+        }
+
+        for (auto& l : *LITERALS) {
+            auto& bucket = m_sWindowRuleIndex.byClass[l];
+
+            // ^(a|a)$ would otherwise put the rule in twice
+            if (bucket.empty() || bucket.back() != i)
+                bucket.push_back(i);
+        }
+    }
+
+    m_sWindowRuleIndex.dirty = false;
+}
+
 std::vector<SLayerRule> CConfigManager::getMatchingRules(PHLLS pLS) {
     std::vector<SLayerRule> returns;
 
@@ -1189,9 +1442,7 @@ std::vector<SLayerRule> CConfigManager::getMatchingRules(PHLLS pLS) {
             if (std::format("address:0x{:x}", (uintptr_t)pLS.get()) != lr.targetNamespace)
                 continue;
         } else {
-            std::regex NSCHECK(lr.targetNamespace);
-
-            if (!pLS->layerSurface->_namespace || !std::regex_search(pLS->layerSurface->_namespace, NSCHECK))
+            if (!pLS->layerSurface->_namespace || !lr.rNamespace || !lr.rNamespace->passes(pLS->layerSurface->_namespace))
                 continue;
         }
 
@@ -1838,10 +2089,12 @@ std::optional<std::string> CConfigManager::handleAnimation(const std::string& co
         }
 
         // curve
-        PANIM->second.internalBezier = ARGS[3];
+        PANIM->second.internalBezier      = ARGS[3];
+        PANIM->second.internalBezierIndex = g_pAnimationManager->getBezierIndex(ARGS[3]);
 
         if (!g_pAnimationManager->bezierExists(ARGS[3])) {
-            PANIM->second.internalBezier = "default";
+            PANIM->second.internalBezier      = "default";
+            PANIM->second.internalBezierIndex = 0;
             return "no such bezier";
         }
 
@@ -1999,6 +2252,7 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
 
     if (RULE == "unset") {
         std::erase_if(m_dWindowRules, [&](const SWindowRule& other) { return other.szValue == VALUE; });
+        m_sWindowRuleIndex.dirty = true;
         return {};
     }
 
@@ -2008,10 +2262,25 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
         return "Invalid rule: " + RULE;
     }
 
+    SWindowRule rule{RULE, VALUE};
+
+    if (VALUE.starts_with("title:"))
+        rule.rTitle = std::make_shared<CRuleRegex>(VALUE.substr(6));
+    else
+        rule.rClass = std::make_shared<CRuleRegex>(VALUE);
+
+    const auto& PREGEX = rule.rTitle ? rule.rTitle : rule.rClass;
+    if (!PREGEX->isValid()) {
+        Debug::log(ERR, "Invalid regex in windowrule {}: {}", VALUE, PREGEX->getError());
+        return "Invalid regex in windowrule " + VALUE + ": " + PREGEX->getError();
+    }
+
     if (RULE.starts_with("size") || RULE.starts_with("maxsize") || RULE.starts_with("minsize"))
-        m_dWindowRules.push_front({RULE, VALUE});
+        m_dWindowRules.push_front(rule);
     else
-        m_dWindowRules.push_back({RULE, VALUE});
+        m_dWindowRules.push_back(rule);
+
+    m_sWindowRuleIndex.dirty = true;
 
     return {};
 }
@@ -2034,7 +2303,18 @@ std::optional<std::string> CConfigManager::handleLayerRule(const std::string& co
         return "Invalid rule found: " + RULE;
     }
 
-    m_dLayerRules.push_back({VALUE, RULE});
+    SLayerRule layerRule{VALUE, RULE};
+
+    if (!VALUE.starts_with("address:0x")) {
+        layerRule.rNamespace = std::make_shared<CRuleRegex>(VALUE);
+
+        if (!layerRule.rNamespace->isValid()) {
+            Debug::log(ERR, "Invalid regex in layerrule {}: {}", VALUE, layerRule.rNamespace->getError());
+            return "Invalid regex in layerrule " + VALUE + ": " + layerRule.rNamespace->getError();
+        }
+    }
+
+    m_dLayerRules.push_back(layerRule);
 
     for (auto& m : g_pCompositor->m_vMonitors)
         for (auto& lsl : m->m_aLayerSurfaceLayers)
@@ -2200,7 +2480,29 @@ std::optional<std::string> CConfigManager::handleWindowRuleV2(const std::string&
                 return true;
             }
         });
+        m_sWindowRuleIndex.dirty = true;
+        return {};
+    }
+
+    // compile once here instead of on every rule evaluation
+    auto compile = [](const std::string& pattern, SP<CRuleRegex>& regex) -> std::optional<std::string> {
+        if (pattern.empty())
+            return {};
+
+        regex = std::make_shared<CRuleRegex>(pattern);
+
+        if (!regex->isValid()) {
+            Debug::log(ERR, "Invalid regex in windowrulev2 {}: {}", pattern, regex->getError());
+            return "Invalid regex in windowrulev2 " + pattern + ": " + regex->getError();
+        }
+
         return {};
+    };
+
+    for (auto& err : {compile(rule.szClass, rule.rClass), compile(rule.szTitle, rule.rTitle), compile(rule.szInitialClass, rule.rInitialClass),
+                      compile(rule.szInitialTitle, rule.rInitialTitle)}) {
+        if (err.has_value())
+            return err;
     }
 
     if (RULE.starts_with("size") || RULE.starts_with("maxsize") || RULE.starts_with("minsize"))
@@ -2208,6 +2510,8 @@ std::optional<std::string> CConfigManager::handleWindowRuleV2(const std::string&
     else
         m_dWindowRules.push_back(rule);
 
+    m_sWindowRuleIndex.dirty = true;
+
     return {};
 }
 
@@ -65,6 +65,8 @@ struct SAnimationPropertyConfig {
 
     SAnimationPropertyConfig* pValues          = nullptr;
     SAnimationPropertyConfig* pParentAnimation = nullptr;
+
+    size_t                    internalBezierIndex = 0; // internalBezier resolved in the animation manager, 0 is "default"
 };
 
 struct SPluginKeyword {
@@ -83,6 +85,29 @@ struct SExecRequestedRule {
     uint64_t    iPid   = 0;
 };
 
+// parts of the config a reload can change, only the changed ones are re-applied
+enum eConfigSection : uint32_t {
+    CONFIG_SECTION_INPUT      = (1 << 0),
+    CONFIG_SECTION_MONITORS   = (1 << 1),
+    CONFIG_SECTION_LAYOUT     = (1 << 2),
+    CONFIG_SECTION_DECORATION = (1 << 3),
+    CONFIG_SECTION_RULES      = (1 << 4),
+    CONFIG_SECTION_SHADER     = (1 << 5),
+    CONFIG_SECTION_BINDS      = (1 << 6),
+    CONFIG_SECTION_ANIMATIONS = (1 << 7),
+    CONFIG_SECTION_RENDER     = (1 << 8), // anything else that shows on screen
+    CONFIG_SECTION_OTHER      = (1 << 9),
+
+    CONFIG_SECTION_ALL = 0xFFFFFFFF,
+};
+
+struct SConfigReloadStats {
+    uint64_t                                   reloads     = 0;
+    uint64_t                                   incremental = 0; // reloads that didn't re-apply everything
+    uint32_t                                   lastChanged = 0; // eConfigSection mask
+    std::vector<std::pair<std::string, float>> lastPhases;      // name, ms
+};
+
 class CConfigManager {
   public:
     CConfigManager();
@@ -143,6 +168,10 @@ class CConfigManager {
 
     void                      handlePluginLoads();
     std::string               getErrors();
+    const SConfigReloadStats& getReloadStats();
+
+    // called by the keyword handlers, so a reload can tell which keywords changed
+    void recordKeyword(const std::string& keyword, const std::string& value);
 
     // keywords
     std::optional<std::string> handleRawExec(const std::string&, const std::string&);
@@ -186,6 +215,14 @@ class CConfigManager {
     std::deque<SMonitorRule>                                  m_dMonitorRules;
     std::deque<SWorkspaceRule>                                m_dWorkspaceRules;
     std::deque<SWindowRule>                                   m_dWindowRules;
+
+    // indices into m_dWindowRules. Rules whose class can only match exact literals are bucketed by those,
+    // everything else has to be checked for every window.
+    struct {
+        std::unordered_map<std::string, std::vector<size_t>> byClass;
+        std::vector<size_t>                                  residual;
+        bool                                                 dirty = true;
+    } m_sWindowRuleIndex;
     std::deque<SLayerRule>                                    m_dLayerRules;
     std::deque<std::string>                                   m_dBlurLSNamespaces;
 
@@ -196,14 +233,25 @@ class CConfigManager {
     std::vector<std::pair<std::string, std::string>>          m_vFailedPluginConfigValues; // for plugin values of unloaded plugins
     std::string                                               m_szConfigErrors = "";
 
+    // reload diffing
+    std::vector<std::string>                                  m_vConfigValueNames;
+    std::vector<std::string>                                  m_vDeviceConfigValueNames;
+    std::unordered_map<std::string, std::string>              m_mKeywordLines;   // keyword -> its values, since the last reset
+    std::unordered_map<std::string, std::string>              m_mConfigSnapshot; // what the last reload applied, empty forces a full re-apply
+    SConfigReloadStats                                        m_sReloadStats;
+
     // internal methods
     void                       setAnimForChildren(SAnimationPropertyConfig* const);
     void                       updateBlurredLS(const std::string&, const bool);
+    void                       rebuildWindowRuleIndex();
     void                       setDefaultAnimationVars();
     std::optional<std::string> resetHLConfig();
     std::optional<std::string> verifyConfigExists();
-    void                       postConfigReload(const Hyprlang::CParseResult& result);
-    void                       reload();
+    void                       registerConfigValue(const char* name, const Hyprlang::CConfigValue& value);
+    void                       registerDeviceConfigValue(const char* name, const Hyprlang::CConfigValue& value);
+    uint32_t                   takeConfigSnapshot();
+    void                       postConfigReload(const Hyprlang::CParseResult& result, uint32_t changed);
+    void                       reload(bool force = false);
     SWorkspaceRule             mergeWorkspaceRules(const SWorkspaceRule&, const SWorkspaceRule&);
 };
 
@@ -228,5 +228,15 @@ void CrashReporter::createAndSaveCrash(int sig) {
 
     finalCrashReport += "\n\nLog tail:\n";
 
-    finalCrashReport += std::string_view(Debug::rollingLog).substr(Debug::rollingLog.find("\n") + 1);
+    // skip the first line, it's likely cut off
+    auto [oldest, newest] = Debug::rollingLog.unsafeViews();
+    if (const auto NEWLINE = oldest.find('\n'); NEWLINE != std::string_view::npos) {
+        oldest = oldest.substr(NEWLINE + 1);
+    } else if (const auto NEWLINEINNEWEST = newest.find('\n'); NEWLINEINNEWEST != std::string_view::npos) {
+        oldest = {};
+        newest = newest.substr(NEWLINEINNEWEST + 1);
+    }
+
+    finalCrashReport += oldest;
+    finalCrashReport += newest;
 }
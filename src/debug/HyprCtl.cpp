@@ -10,7 +10,9 @@
 #include <sys/utsname.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <errno.h>
 
+#include <array>
 #include <sstream>
 #include <string>
 #include <typeindex>
@@ -19,6 +21,8 @@
 #include "../config/ConfigValue.hpp"
 #include "../managers/CursorManager.hpp"
 #include "../hyprerror/HyprError.hpp"
+#include "../render/decorations/GroupBarTextureCache.hpp"
+#include "../render/decorations/ShadowTextureCache.hpp"
 
 static void trimTrailingComma(std::string& str) {
     if (!str.empty() && str.back() == ',')
@@ -724,15 +728,321 @@ std::string rollinglogRequest(eHyprCtlOutputFormat format, std::string request)
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[\n\"log\":\"";
-        result += escapeJSONStrings(Debug::rollingLog);
+        result += escapeJSONStrings(Debug::rollingLog.get());
         result += "\"]";
     } else {
-        result = Debug::rollingLog;
+        result = Debug::rollingLog.get();
     }
 
     return result;
 }
 
+std::string eventStatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto  STATS = g_pEventManager->getStats();
+
+    std::string ret = "";
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
+        ret += std::format("posted: {}\ndropped: {}\ndisconnected: {}\nclients: {}\n", STATS.posted, STATS.dropped, STATS.disconnected, STATS.clients.size());
+
+        for (auto& c : STATS.clients) {
+            ret += std::format("\tclient fd {}:\n\t\tqueued: {}\n\t\tdropped: {}\n\t\tjson: {}\n\t\tfilter: {}\n", c.fd, c.queued, c.dropped, c.json, c.filter);
+        }
+    } else {
+        ret += std::format(R"#({{
+    "posted": {},
+    "dropped": {},
+    "disconnected": {},
+    "clients": [)#",
+                           STATS.posted, STATS.dropped, STATS.disconnected);
+
+        for (auto& c : STATS.clients) {
+            ret += std::format(R"#(
+        {{
+            "fd": {},
+            "queued": {},
+            "dropped": {},
+            "json": {},
+            "filter": "{}"
+        }},)#",
+                               c.fd, c.queued, c.dropped, c.json ? "true" : "false", escapeJSONStrings(c.filter));
+        }
+
+        trimTrailingComma(ret);
+
+        ret += "\n    ]\n}";
+    }
+
+    return ret;
+}
+
+std::string frameTimingRequest(eHyprCtlOutputFormat format, std::string request) {
+    std::string ret = "";
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            auto&       timing = m->frameTiming;
+            const auto& RAT    = timing.predictionStats();
+
+            ret += std::format("Monitor {} (ID {}):\n\tsamples: {}\n\trender: avg {:.2f}ms, p50 {:.2f}ms, p95 {:.2f}ms, p99 {:.2f}ms, max {:.2f}ms\n\tpresent latency: avg "
+                               "{:.2f}ms, p50 {:.2f}ms, p95 {:.2f}ms\n\trender ahead of time: scheduled {}, missed {}, last predicted render {:.2f}ms, last sleep {:.2f}ms\n\n",
+                               m->szName, m->ID, timing.samples(), timing.renderTimeAverage(), timing.renderTimePercentile(50), timing.renderTimePercentile(95),
+                               timing.renderTimePercentile(99), timing.renderTimePercentile(100), timing.presentLatencyAverage(), timing.presentLatencyPercentile(50),
+                               timing.presentLatencyPercentile(95), RAT.scheduled, RAT.missed, RAT.lastRenderMs, RAT.lastSleepMs);
+        }
+    } else {
+        ret += "[";
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            auto&       timing = m->frameTiming;
+            const auto& RAT    = timing.predictionStats();
+
+            ret += std::format(R"#(
+{{
+    "id": {},
+    "name": "{}",
+    "samples": {},
+    "render": {{
+        "avg": {:.3f},
+        "p50": {:.3f},
+        "p95": {:.3f},
+        "p99": {:.3f},
+        "max": {:.3f}
+    }},
+    "presentLatency": {{
+        "avg": {:.3f},
+        "p50": {:.3f},
+        "p95": {:.3f}
+    }},
+    "renderAheadOfTime": {{
+        "scheduled": {},
+        "missed": {},
+        "lastPredictedRender": {:.3f},
+        "lastSleep": {:.3f}
+    }}
+}},)#",
+                               m->ID, escapeJSONStrings(m->szName), timing.samples(), timing.renderTimeAverage(), timing.renderTimePercentile(50),
+                               timing.renderTimePercentile(95), timing.renderTimePercentile(99), timing.renderTimePercentile(100), timing.presentLatencyAverage(),
+                               timing.presentLatencyPercentile(50), timing.presentLatencyPercentile(95), RAT.scheduled, RAT.missed, RAT.lastRenderMs, RAT.lastSleepMs);
+        }
+
+        trimTrailingComma(ret);
+
+        ret += "]";
+    }
+
+    return ret;
+}
+
+static std::string configSectionsToString(uint32_t sections) {
+    if (sections == CONFIG_SECTION_ALL)
+        return "all";
+
+    constexpr std::array<std::pair<eConfigSection, const char*>, 10> NAMES = {{
+        {CONFIG_SECTION_INPUT, "input"},
+        {CONFIG_SECTION_MONITORS, "monitors"},
+        {CONFIG_SECTION_LAYOUT, "layout"},
+        {CONFIG_SECTION_DECORATION, "decoration"},
+        {CONFIG_SECTION_RULES, "rules"},
+        {CONFIG_SECTION_SHADER, "shader"},
+        {CONFIG_SECTION_BINDS, "binds"},
+        {CONFIG_SECTION_ANIMATIONS, "animations"},
+        {CONFIG_SECTION_RENDER, "render"},
+        {CONFIG_SECTION_OTHER, "other"},
+    }};
+
+    std::string result;
+    for (auto& [section, name] : NAMES) {
+        if (sections & section)
+            result += std::string{name} + " ";
+    }
+
+    if (!result.empty())
+        result.pop_back();
+
+    return result;
+}
+
+std::string reloadStatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto& STATS = g_pConfigManager->getReloadStats();
+
+    float       total = 0;
+    for (auto& [name, ms] : STATS.lastPhases) {
+        total += ms;
+    }
+
+    std::string ret = "";
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
+        ret += std::format("reloads: {}\nincremental: {}\nlast re-applied: {}\nlast phases:\n", STATS.reloads, STATS.incremental,
+                           configSectionsToString(STATS.lastChanged));
+
+        for (auto& [name, ms] : STATS.lastPhases) {
+            ret += std::format("\t{}: {:.3f}ms\n", name, ms);
+        }
+
+        ret += std::format("\ttotal: {:.3f}ms\n", total);
+    } else {
+        std::string phases = "";
+        for (auto& [name, ms] : STATS.lastPhases) {
+            phases += std::format("\n        \"{}\": {:.3f},", escapeJSONStrings(name), ms);
+        }
+
+        trimTrailingComma(phases);
+
+        ret += std::format(R"#({{
+    "reloads": {},
+    "incremental": {},
+    "lastReapplied": "{}",
+    "lastPhases": {{{}
+    }},
+    "lastTotal": {:.3f}
+}})#",
+                           STATS.reloads, STATS.incremental, configSectionsToString(STATS.lastChanged), phases, total);
+    }
+
+    return ret;
+}
+
+static const char* renderPassShaderToString(eRenderPassShader shader) {
+    switch (shader) {
+        case RENDER_PASS_SHADER_QUAD: return "quad";
+        case RENDER_PASS_SHADER_RGBA: return "rgba";
+        case RENDER_PASS_SHADER_RGBX: return "rgbx";
+        case RENDER_PASS_SHADER_EXT: return "ext";
+        case RENDER_PASS_SHADER_BLUR: return "blur";
+    }
+
+    return "unknown";
+}
+
+std::string renderPassRequest(eHyprCtlOutputFormat format, std::string request) {
+    std::string ret = "";
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        ret += "[";
+
+    for (auto& m : g_pCompositor->m_vMonitors) {
+        const auto IT = g_pHyprRenderer->m_sRenderPass.frames().find(m->ID);
+        if (IT == g_pHyprRenderer->m_sRenderPass.frames().end())
+            continue;
+
+        const auto& FRAME = IT->second;
+
+        if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
+            ret += std::format("Monitor {} (ID {}):\n\tflushes: {}\n\telements: {}\n\treordered: {}\n\tculled: {}\n\tmerged: {}\n\tshader switches: {}\n", m->szName, m->ID,
+                               FRAME.flushes, FRAME.elements.size(), FRAME.reordered, FRAME.culled, FRAME.merged, FRAME.shaderSwitches);
+
+            for (auto& e : FRAME.elements) {
+                ret += std::format("\t\t{}: {} {} {:.0f},{:.0f} {:.0f}x{:.0f} flush {}{}{}\n", e.index, e.type == RENDER_PASS_ELEMENT_RECT ? "rect" : "surface",
+                                   renderPassShaderToString(e.shader), e.box.x, e.box.y, e.box.w, e.box.h, e.flush, e.culled ? " culled" : "", e.merged ? " merged" : "");
+            }
+
+            ret += "\n";
+        } else {
+            std::string elements = "";
+            for (auto& e : FRAME.elements) {
+                elements += std::format(R"#(
+        {{
+            "index": {},
+            "type": "{}",
+            "shader": "{}",
+            "box": [{:.0f}, {:.0f}, {:.0f}, {:.0f}],
+            "flush": {},
+            "culled": {},
+            "merged": {}
+        }},)#",
+                                        e.index, e.type == RENDER_PASS_ELEMENT_RECT ? "rect" : "surface", renderPassShaderToString(e.shader), e.box.x, e.box.y, e.box.w, e.box.h,
+                                        e.flush, e.culled ? "true" : "false", e.merged ? "true" : "false");
+            }
+
+            trimTrailingComma(elements);
+
+            ret += std::format(R"#(
+{{
+    "monitor": "{}",
+    "id": {},
+    "flushes": {},
+    "reordered": {},
+    "culled": {},
+    "merged": {},
+    "shaderSwitches": {},
+    "elements": [{}
+    ]
+}},)#",
+                               escapeJSONStrings(m->szName), m->ID, FRAME.flushes, FRAME.reordered, FRAME.culled, FRAME.merged, FRAME.shaderSwitches, elements);
+        }
+    }
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        trimTrailingComma(ret);
+        ret += "]";
+    }
+
+    return ret;
+}
+
+std::string groupbarCacheRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto STATS = g_pGroupBarTextureCache->stats();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL)
+        return std::format("hits: {}\nmisses: {}\nevictions: {}\nentries: {}\nbytes: {}\nbudget: {}\n", STATS.hits, STATS.misses, STATS.evictions, STATS.entries,
+                           STATS.bytes, STATS.budget);
+
+    return std::format(R"#({{
+    "hits": {},
+    "misses": {},
+    "evictions": {},
+    "entries": {},
+    "bytes": {},
+    "budget": {}
+}})#",
+                       STATS.hits, STATS.misses, STATS.evictions, STATS.entries, STATS.bytes, STATS.budget);
+}
+
+std::string gpuMemoryRequest(eHyprCtlOutputFormat format, std::string request) {
+    static constexpr std::array<const char*, FB_CATEGORY_END> CATEGORIES = {"other", "monitor", "effect", "snapshot", "capture"};
+
+    // the budget only covers framebuffers, the texture caches keep to their own
+    const auto  STATS    = g_pFramebufferPool->stats();
+    const auto  GROUPBAR = g_pGroupBarTextureCache->stats().bytes;
+    const auto  SHADOWS  = g_pShadowTextureCache->bytes();
+    const auto  TOTAL    = g_pFramebufferPool->totalBytes() + GROUPBAR + SHADOWS;
+
+    std::string result;
+
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
+        for (size_t i = 0; i < FB_CATEGORY_END; ++i) {
+            result += std::format("{}: {}\n", CATEGORIES[i], STATS.bytes[i]);
+        }
+
+        result += std::format("free: {} in {} buffers\nreused: {}\ncreated: {}\ndeleted: {}\nevicted snapshots: {}\n", STATS.freeBytes, STATS.freeCount, STATS.reused,
+                              STATS.created, STATS.deleted, g_pHyprOpenGL->m_iEvictedSnapshots);
+        result += std::format("budget: {}\ngroupbar textures: {}\nshadow textures: {}\ntotal: {}\n", STATS.budget, GROUPBAR, SHADOWS, TOTAL);
+        return result;
+    }
+
+    for (size_t i = 0; i < FB_CATEGORY_END; ++i) {
+        result += std::format(R"#(
+        "{}": {},)#",
+                              CATEGORIES[i], STATS.bytes[i]);
+    }
+    trimTrailingComma(result);
+
+    return std::format(R"#({{
+    "framebuffers": {{{}
+    }},
+    "free": {},
+    "freeBuffers": {},
+    "reused": {},
+    "created": {},
+    "deleted": {},
+    "evictedSnapshots": {},
+    "budget": {},
+    "groupbarTextures": {},
+    "shadowTextures": {},
+    "total": {}
+}})#",
+                       result, STATS.freeBytes, STATS.freeCount, STATS.reused, STATS.created, STATS.deleted, g_pHyprOpenGL->m_iEvictedSnapshots, STATS.budget, GROUPBAR, SHADOWS,
+                       TOTAL);
+}
+
 std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::string request) {
     std::string ret       = "";
     const auto  SHORTCUTS = g_pProtocolManager->m_pGlobalShortcutsProtocolManager->getAllShortcuts();
@@ -1008,32 +1318,27 @@ std::string cursorPosRequest(eHyprCtlOutputFormat format, std::string request) {
 }
 
 std::string dispatchBatch(eHyprCtlOutputFormat format, std::string request) {
-    // split by ;
+    // split by ;, walking the payload once without copying the remainder around
 
-    request             = request.substr(9);
-    std::string curitem = "";
-    std::string reply   = "";
+    std::string_view payload = std::string_view{request}.substr(9);
+    std::string      reply   = "";
 
-    auto        nextItem = [&]() {
-        auto idx = request.find_first_of(';');
+    while (!payload.empty()) {
+        const auto       IDX  = payload.find(';');
+        std::string_view item = payload.substr(0, IDX);
+        payload               = IDX == std::string_view::npos ? std::string_view{} : payload.substr(IDX + 1);
 
-        if (idx != std::string::npos) {
-            curitem = request.substr(0, idx);
-            request = request.substr(idx + 1);
-        } else {
-            curitem = request;
-            request = "";
+        const auto       BEGIN = item.find_first_not_of(" \t");
+        if (BEGIN == std::string_view::npos) {
+            // like they always did, empty items only get a reply when more follows them
+            if (!payload.empty())
+                reply += g_pHyprCtl->getReply("");
+            continue;
         }
 
-        curitem = removeBeginEndSpacesTabs(curitem);
-    };
-
-    nextItem();
-
-    while (curitem != "" || request != "") {
-        reply += g_pHyprCtl->getReply(curitem);
+        item = item.substr(BEGIN, item.find_last_not_of(" \t") - BEGIN + 1);
 
-        nextItem();
+        reply += g_pHyprCtl->getReply(std::string{item});
     }
 
     return reply;
@@ -1563,6 +1868,12 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"rollinglog", true, rollinglogRequest});
     registerCommand(SHyprCtlCommand{"layouts", true, layoutsRequest});
     registerCommand(SHyprCtlCommand{"configerrors", true, configErrorsRequest});
+    registerCommand(SHyprCtlCommand{"eventstats", true, eventStatsRequest});
+    registerCommand(SHyprCtlCommand{"frametiming", true, frameTimingRequest});
+    registerCommand(SHyprCtlCommand{"groupbarcache", true, groupbarCacheRequest});
+    registerCommand(SHyprCtlCommand{"gpumemory", true, gpuMemoryRequest});
+    registerCommand(SHyprCtlCommand{"reloadstats", true, reloadStatsRequest});
+    registerCommand(SHyprCtlCommand{"renderpass", true, renderPassRequest});
 
     registerCommand(SHyprCtlCommand{"monitors", false, monitorsRequest});
     registerCommand(SHyprCtlCommand{"reload", false, reloadRequest});
@@ -1584,11 +1895,70 @@ CHyprCtl::CHyprCtl() {
 }
 
 std::shared_ptr<SHyprCtlCommand> CHyprCtl::registerCommand(SHyprCtlCommand cmd) {
-    return m_vCommands.emplace_back(std::make_shared<SHyprCtlCommand>(cmd));
+    const auto PCMD = m_vCommands.emplace_back(std::make_shared<SHyprCtlCommand>(cmd));
+    rebuildCommandIndex();
+    return PCMD;
 }
 
 void CHyprCtl::unregisterCommand(const std::shared_ptr<SHyprCtlCommand>& cmd) {
     std::erase(m_vCommands, cmd);
+    rebuildCommandIndex();
+}
+
+void CHyprCtl::rebuildCommandIndex() {
+    m_mExactCommands.clear();
+    m_sPrefixTrie = {};
+
+    // registration order decides between duplicates, like the linear scan used to
+    for (size_t i = 0; i < m_vCommands.size(); ++i) {
+        const auto& CMD = m_vCommands[i];
+
+        if (CMD->exact) {
+            m_mExactCommands.emplace(CMD->name, CMD);
+            continue;
+        }
+
+        SCommandTrieNode* node = &m_sPrefixTrie;
+        for (const auto& c : CMD->name) {
+            auto& child = node->children[c];
+            if (!child)
+                child = std::make_unique<SCommandTrieNode>();
+            node = child.get();
+        }
+
+        if (!node->command) {
+            node->command = CMD;
+            node->order   = i;
+        }
+    }
+}
+
+std::shared_ptr<SHyprCtlCommand> CHyprCtl::findExactCommand(const std::string& request) {
+    const auto IT = m_mExactCommands.find(request);
+    return IT == m_mExactCommands.end() ? nullptr : IT->second;
+}
+
+std::shared_ptr<SHyprCtlCommand> CHyprCtl::findPrefixCommand(const std::string& request) {
+    // every node on the request's path is a registered prefix of it. Pick the earliest registered one.
+    const SCommandTrieNode*          node      = &m_sPrefixTrie;
+    std::shared_ptr<SHyprCtlCommand> best      = node->command;
+    size_t                           bestOrder = node->command ? node->order : SIZE_MAX;
+
+    for (const auto& c : request) {
+        const auto IT = node->children.find(c);
+
+        if (IT == node->children.end())
+            break;
+
+        node = IT->second.get();
+
+        if (node->command && node->order < bestOrder) {
+            best      = node->command;
+            bestOrder = node->order;
+        }
+    }
+
+    return best;
 }
 
 std::string CHyprCtl::getReply(std::string request) {
@@ -1628,27 +1998,14 @@ std::string CHyprCtl::getReply(std::string request) {
     std::string result = "";
 
     // parse exact cmds first, then non-exact.
-    for (auto& cmd : m_vCommands) {
-        if (!cmd->exact)
-            continue;
+    if (const auto EXACT = findExactCommand(request); EXACT)
+        result = EXACT->fn(format, request);
 
-        if (cmd->name == request) {
-            result = cmd->fn(format, request);
-            break;
-        }
+    if (result.empty()) {
+        if (const auto PREFIX = findPrefixCommand(request); PREFIX)
+            result = PREFIX->fn(format, request);
     }
 
-    if (result.empty())
-        for (auto& cmd : m_vCommands) {
-            if (cmd->exact)
-                continue;
-
-            if (request.starts_with(cmd->name)) {
-                result = cmd->fn(format, request);
-                break;
-            }
-        }
-
     if (result.empty())
         return "unknown request";
 
@@ -1683,62 +2040,230 @@ std::string CHyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
 
-int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
+// a single request, anything longer without a newline gets the client dropped
+constexpr size_t MAX_CTL_REQUEST_SIZE = 64 * 1024;
+// replies a client hasn't read yet. A client pipelining requests past this without reading gets dropped.
+constexpr size_t MAX_CTL_QUEUED_REPLIES = 16 * 1024 * 1024;
+// how long a new client gets to send its request or the persistent marker, like the old blocking select allowed
+constexpr int CTL_IDLE_TIMEOUT_MS = 5;
+
+static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
         return 0;
 
-    sockaddr_in            clientAddress;
-    socklen_t              clientSize = sizeof(clientAddress);
+    g_pHyprCtl->acceptClients();
 
-    const auto             ACCEPTEDCONNECTION = accept4(g_pHyprCtl->m_iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC);
+    return 0;
+}
 
-    std::array<char, 1024> readBuffer;
+static int hyprCtlClientFDTick(int fd, uint32_t mask, void* data) {
+    g_pHyprCtl->onClientFD(fd, mask);
 
-    fd_set                 fdset;
-    FD_ZERO(&fdset);
-    FD_SET(ACCEPTEDCONNECTION, &fdset);
-    timeval timeout = {.tv_sec = 0, .tv_usec = 5000};
-    auto    success = select(ACCEPTEDCONNECTION + 1, &fdset, nullptr, nullptr, &timeout);
+    return 0;
+}
 
-    if (success <= 0) {
-        close(ACCEPTEDCONNECTION);
-        return 0;
-    }
+static int hyprCtlClientIdleTick(void* data) {
+    g_pHyprCtl->onClientIdle((int)(intptr_t)data);
+
+    return 0;
+}
 
-    std::string request;
+void CHyprCtl::acceptClients() {
     while (true) {
-        readBuffer.fill(0);
-        auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
-        if (messageSize < 1)
+        sockaddr_in clientAddress;
+        socklen_t   clientSize = sizeof(clientAddress);
+
+        const auto  ACCEPTEDCONNECTION = accept4(m_iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+        if (ACCEPTEDCONNECTION < 0)
             break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
-        if (messageSize < 1023)
+
+        auto& client      = m_vClients.emplace_back(std::make_unique<SClient>());
+        client->fd        = ACCEPTEDCONNECTION;
+        client->source    = wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, ACCEPTEDCONNECTION, WL_EVENT_READABLE, hyprCtlClientFDTick, nullptr);
+        client->idleTimer = wl_event_loop_add_timer(g_pCompositor->m_sWLEventLoop, hyprCtlClientIdleTick, (void*)(intptr_t)ACCEPTEDCONNECTION);
+        wl_event_source_timer_update(client->idleTimer, CTL_IDLE_TIMEOUT_MS);
+    }
+}
+
+void CHyprCtl::removeClient(int fd) {
+    std::erase_if(m_vClients, [fd](const auto& c) {
+        if (c->fd != fd)
+            return false;
+
+        wl_event_source_remove(c->source);
+        if (c->idleTimer)
+            wl_event_source_remove(c->idleTimer);
+        close(c->fd);
+        return true;
+    });
+}
+
+void CHyprCtl::onClientIdle(int fd) {
+    const auto PCLIENT = getClient(fd);
+
+    // one-shot clients that never sent anything don't get to hold a connection open
+    if (PCLIENT && !PCLIENT->persistent && !PCLIENT->closeAfterWrite)
+        removeClient(fd);
+}
+
+CHyprCtl::SClient* CHyprCtl::getClient(int fd) {
+    for (auto& c : m_vClients) {
+        if (c->fd == fd)
+            return c.get();
+    }
+
+    return nullptr;
+}
+
+/*
+    Two kinds of clients are handled here:
+    - legacy clients send a single request, read the reply and get disconnected.
+    - persistent clients start with PERSISTENT_MARKER followed by a newline. After that, every newline-terminated
+      line is a request, and every reply is sent as "<length in bytes>\n<reply>". Requests can be pipelined,
+      replies are sent in order.
+    A client that sends neither a request nor the marker within CTL_IDLE_TIMEOUT_MS of connecting is dropped.
+    While a client has replies it hasn't read, nothing more is read from it, so it can't queue more requests.
+*/
+void CHyprCtl::onClientFD(int fd, uint32_t mask) {
+    const auto PCLIENT = getClient(fd);
+
+    if (!PCLIENT)
+        return;
+
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
+        removeClient(fd);
+        return;
+    }
+
+    if (mask & WL_EVENT_READABLE) {
+        std::array<char, 4096> readBuffer;
+        bool                   eof = false;
+
+        // what's left stays in the socket until the buffered requests are handled
+        while (PCLIENT->readBuffer.length() <= MAX_CTL_REQUEST_SIZE) {
+            const auto RECEIVED = read(fd, readBuffer.data(), readBuffer.size());
+
+            if (RECEIVED > 0) {
+                PCLIENT->readBuffer.append(readBuffer.data(), RECEIVED);
+                continue;
+            }
+
+            if (RECEIVED < 0 && errno == EINTR)
+                continue;
+
+            if (RECEIVED == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+                eof = true;
+
             break;
+        }
+
+        if (!PCLIENT->persistent && !PCLIENT->closeAfterWrite) {
+            const std::string_view MARKER = PERSISTENT_MARKER "\n";
+
+            if (PCLIENT->readBuffer.starts_with(MARKER)) {
+                PCLIENT->persistent = true;
+                PCLIENT->readBuffer.erase(0, MARKER.length());
+            } else if (!eof && MARKER.starts_with(PCLIENT->readBuffer)) {
+                // possibly an incomplete marker, wait for more
+                return;
+            } else if (PCLIENT->readBuffer.length() > MAX_CTL_REQUEST_SIZE) {
+                Debug::log(ERR, "Hyprctl: dropping a client with a request over {} bytes", MAX_CTL_REQUEST_SIZE);
+                removeClient(fd);
+                return;
+            } else if (!PCLIENT->readBuffer.empty()) {
+                // legacy client, the whole read is the request
+                PCLIENT->writeBuffer     = processRequest(PCLIENT->readBuffer);
+                PCLIENT->closeAfterWrite = true;
+                PCLIENT->readBuffer.clear();
+            }
+        }
+
+        if ((PCLIENT->persistent || PCLIENT->closeAfterWrite) && PCLIENT->idleTimer) {
+            wl_event_source_remove(PCLIENT->idleTimer);
+            PCLIENT->idleTimer = nullptr;
+        }
+
+        if (PCLIENT->persistent) {
+            size_t newline = 0;
+            while ((newline = PCLIENT->readBuffer.find('\n')) != std::string::npos) {
+                const auto REPLY = processRequest(PCLIENT->readBuffer.substr(0, newline));
+                PCLIENT->readBuffer.erase(0, newline + 1);
+
+                PCLIENT->writeBuffer += std::format("{}\n", REPLY.length());
+                PCLIENT->writeBuffer += REPLY;
+
+                if (PCLIENT->writeBuffer.length() > MAX_CTL_QUEUED_REPLIES) {
+                    Debug::log(ERR, "Hyprctl: dropping a client with over {} bytes of unread replies", MAX_CTL_QUEUED_REPLIES);
+                    removeClient(fd);
+                    return;
+                }
+            }
+
+            if (PCLIENT->readBuffer.length() > MAX_CTL_REQUEST_SIZE) {
+                Debug::log(ERR, "Hyprctl: dropping a client with a request over {} bytes", MAX_CTL_REQUEST_SIZE);
+                removeClient(fd);
+                return;
+            }
+        }
+
+        if (eof) {
+            // the peer won't send anything more, but still gets the replies to whatever it sent
+            PCLIENT->closeAfterWrite = true;
+        }
+    }
+
+    if (!flushClient(PCLIENT) || (PCLIENT->closeAfterWrite && PCLIENT->writeBuffer.empty()))
+        removeClient(fd);
+}
+
+bool CHyprCtl::flushClient(SClient* client) {
+    while (!client->writeBuffer.empty()) {
+        const auto WRITTEN = send(client->fd, client->writeBuffer.c_str(), client->writeBuffer.length(), MSG_NOSIGNAL);
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            return false;
+        }
+
+        client->writeBuffer.erase(0, WRITTEN);
     }
 
+    // backed up replies stop reading until they're through
+    const bool WANTSWRITABLE = !client->writeBuffer.empty();
+
+    if (WANTSWRITABLE != client->wantsWritable) {
+        client->wantsWritable = WANTSWRITABLE;
+        wl_event_source_fd_update(client->source, WANTSWRITABLE ? WL_EVENT_WRITABLE : WL_EVENT_READABLE);
+    }
+
+    return true;
+}
+
+std::string CHyprCtl::processRequest(const std::string& request) {
     std::string reply = "";
 
     try {
-        reply = g_pHyprCtl->getReply(request);
+        reply = getReply(request);
     } catch (std::exception& e) {
         Debug::log(ERR, "Error in request: {}", e.what());
         reply = "Err: " + std::string(e.what());
     }
 
-    write(ACCEPTEDCONNECTION, reply.c_str(), reply.length());
-
-    close(ACCEPTEDCONNECTION);
-
     if (g_pConfigManager->m_bWantsMonitorReload)
         g_pConfigManager->ensureMonitorStatus();
 
-    return 0;
+    return reply;
 }
 
 void CHyprCtl::startHyprCtlSocket() {
 
-    m_iSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    m_iSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
 
     if (m_iSocketFD < 0) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
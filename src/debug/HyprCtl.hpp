@@ -4,6 +4,10 @@
 #include <fstream>
 #include "../helpers/MiscFunctions.hpp"
 #include <functional>
+#include <unordered_map>
+
+// sent by a client as its first line to keep the connection open for multiple requests
+#define PERSISTENT_MARKER "[[PERSISTENT]]"
 
 class CHyprCtl {
   public:
@@ -20,10 +24,41 @@ class CHyprCtl {
         bool all = false;
     } m_sCurrentRequestParams;
 
+    void acceptClients();
+    void onClientFD(int fd, uint32_t mask);
+    void onClientIdle(int fd);
+
   private:
+    struct SClient {
+        int              fd        = -1;
+        wl_event_source* source    = nullptr;
+        wl_event_source* idleTimer = nullptr; // until it sends a request or the persistent marker
+        std::string      readBuffer;
+        std::string      writeBuffer;
+        bool             persistent      = false;
+        bool             closeAfterWrite = false;
+        bool             wantsWritable   = false;
+    };
+
+    struct SCommandTrieNode {
+        std::unordered_map<char, std::unique_ptr<SCommandTrieNode>> children;
+        std::shared_ptr<SHyprCtlCommand>                            command;
+        size_t                                                      order = 0;
+    };
+
     void                                          startHyprCtlSocket();
+    void                                          rebuildCommandIndex();
+    std::shared_ptr<SHyprCtlCommand>              findExactCommand(const std::string& request);
+    std::shared_ptr<SHyprCtlCommand>              findPrefixCommand(const std::string& request);
+    std::string                                   processRequest(const std::string& request);
+    bool                                          flushClient(SClient* client);
+    void                                          removeClient(int fd);
+    SClient*                                      getClient(int fd);
 
-    std::vector<std::shared_ptr<SHyprCtlCommand>> m_vCommands;
+    std::vector<std::shared_ptr<SHyprCtlCommand>>                     m_vCommands;
+    std::unordered_map<std::string, std::shared_ptr<SHyprCtlCommand>> m_mExactCommands;
+    SCommandTrieNode                                                  m_sPrefixTrie;
+    std::vector<std::unique_ptr<SClient>>                             m_vClients;
 };
 
 inline std::unique_ptr<CHyprCtl> g_pHyprCtl;
\ No newline at end of file
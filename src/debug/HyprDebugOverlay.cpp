@@ -42,15 +42,12 @@ void CHyprMonitorDebugOverlay::frameData(CMonitor* pMonitor) {
     }
 }
 
-int CHyprMonitorDebugOverlay::draw(int offset) {
+int CHyprMonitorDebugOverlay::addLines(int offset, std::vector<SDebugOverlayLine>& lines) {
 
     if (!m_pMonitor)
         return 0;
 
-    int                  yOffset = offset;
-    cairo_text_extents_t cairoExtents;
-    float                maxX = 0;
-    std::string          text = "";
+    int yOffset = offset;
 
     // get avg fps
     float avgFrametime = 0;
@@ -108,77 +105,42 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     const float FPS      = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
     const float idealFPS = m_dLastFrametimes.size();
 
-    cairo_select_font_face(g_pDebugOverlay->m_pCairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
-
-    cairo_set_font_size(g_pDebugOverlay->m_pCairo, 10);
-    cairo_set_source_rgba(g_pDebugOverlay->m_pCairo, 1.f, 1.f, 1.f, 1.f);
+    const CColor WHITE = {1.f, 1.f, 1.f, 1.f};
 
     yOffset += 10;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = m_pMonitor->szName;
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
-
-    cairo_set_font_size(g_pDebugOverlay->m_pCairo, 16);
+    lines.push_back({m_pMonitor->szName, 10, WHITE, yOffset});
 
+    CColor fpsColor;
     if (FPS > idealFPS * 0.95f)
-        cairo_set_source_rgba(g_pDebugOverlay->m_pCairo, 0.2f, 1.f, 0.2f, 1.f);
+        fpsColor = CColor{0.2f, 1.f, 0.2f, 1.f};
     else if (FPS > idealFPS * 0.8f)
-        cairo_set_source_rgba(g_pDebugOverlay->m_pCairo, 1.f, 1.f, 0.2f, 1.f);
+        fpsColor = CColor{1.f, 1.f, 0.2f, 1.f};
     else
-        cairo_set_source_rgba(g_pDebugOverlay->m_pCairo, 1.f, 0.2f, 0.2f, 1.f);
+        fpsColor = CColor{1.f, 0.2f, 0.2f, 1.f};
 
     yOffset += 17;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = std::format("{} FPS", (int)FPS);
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
-
-    cairo_set_font_size(g_pDebugOverlay->m_pCairo, 10);
-    cairo_set_source_rgba(g_pDebugOverlay->m_pCairo, 1.f, 1.f, 1.f, 1.f);
+    lines.push_back({std::format("{} FPS", (int)FPS), 16, fpsColor, yOffset});
 
     yOffset += 11;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = std::format("Avg Frametime: {:.2f}ms (var {:.2f}ms)", avgFrametime, varFrametime);
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
+    lines.push_back({std::format("Avg Frametime: {:.2f}ms (var {:.2f}ms)", avgFrametime, varFrametime), 10, WHITE, yOffset});
 
     yOffset += 11;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = std::format("Avg Rendertime: {:.2f}ms (var {:.2f}ms)", avgRenderTime, varRenderTime);
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
+    lines.push_back({std::format("Avg Rendertime: {:.2f}ms (var {:.2f}ms)", avgRenderTime, varRenderTime), 10, WHITE, yOffset});
 
     yOffset += 11;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = std::format("Avg Rendertime (No Overlay): {:.2f}ms (var {:.2f}ms)", avgRenderTimeNoOverlay, varRenderTimeNoOverlay);
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
+    lines.push_back({std::format("Avg Rendertime (No Overlay): {:.2f}ms (var {:.2f}ms)", avgRenderTimeNoOverlay, varRenderTimeNoOverlay), 10, WHITE, yOffset});
 
     yOffset += 11;
-    cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
-    text = std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0));
-    cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
-    cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
-    if (cairoExtents.width > maxX)
-        maxX = cairoExtents.width;
+    lines.push_back(
+        {std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0)), 10, WHITE, yOffset});
 
-    yOffset += 11;
+    const auto& OCCLUSIONFRAMES = g_pHyprRenderer->m_sOcclusion.frames();
+    if (const auto IT = OCCLUSIONFRAMES.find(m_pMonitor->ID); IT != OCCLUSIONFRAMES.end()) {
+        yOffset += 11;
+        lines.push_back({std::format("Occlusion: {:.2f}Mpx culled, {} covered entirely", IT->second.culledPixels / 1000000.0, IT->second.hidden), 10, WHITE, yOffset});
+    }
 
-    g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
-    m_wbLastDrawnBox = {(int)g_pCompositor->m_vMonitors.front()->vecPosition.x, (int)g_pCompositor->m_vMonitors.front()->vecPosition.y + offset - 1, (int)maxX + 2,
-                        yOffset - offset + 2};
-    g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
+    yOffset += 11;
 
     return yOffset - offset;
 }
@@ -195,44 +157,112 @@ void CHyprDebugOverlay::frameData(CMonitor* pMonitor) {
     m_mMonitorOverlays[pMonitor].frameData(pMonitor);
 }
 
+static bool sameLine(const SDebugOverlayLine& a, const SDebugOverlayLine& b) {
+    return a.baseline == b.baseline && a.fontSize == b.fontSize && a.color == b.color && a.text == b.text;
+}
+
 void CHyprDebugOverlay::draw() {
 
     const auto PMONITOR = g_pCompositor->m_vMonitors.front().get();
 
-    if (!m_pCairoSurface || !m_pCairo) {
-        m_pCairoSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
-        m_pCairo        = cairo_create(m_pCairoSurface);
-    }
-
-    // clear the pixmap
-    cairo_save(m_pCairo);
-    cairo_set_operator(m_pCairo, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(m_pCairo);
-    cairo_restore(m_pCairo);
+    std::vector<SDebugOverlayLine> lines;
 
-    // draw the things
-    int offsetY = 0;
+    int                            offsetY = 0;
     for (auto& m : g_pCompositor->m_vMonitors) {
-        offsetY += m_mMonitorOverlays[m.get()].draw(offsetY);
+        offsetY += m_mMonitorOverlays[m.get()].addLines(offsetY, lines);
         offsetY += 5; // for padding between mons
     }
 
-    cairo_surface_flush(m_pCairoSurface);
+    auto cairo = m_tOverlay.cairo();
+    cairo_select_font_face(cairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+
+    // lines that didn't change keep their glyphs on the surface, only new text is measured and drawn
+    float maxWidth = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        auto& line = lines[i];
+
+        cairo_set_font_size(cairo, line.fontSize);
+
+        if (i < m_vLines.size() && m_vLines[i].fontSize == line.fontSize && m_vLines[i].text == line.text)
+            line.width = m_vLines[i].width;
+        else {
+            cairo_text_extents_t cairoExtents;
+            cairo_text_extents(cairo, line.text.c_str(), &cairoExtents);
+            line.width = cairoExtents.width;
+        }
+
+        cairo_font_extents_t fontExtents;
+        cairo_font_extents(cairo, &fontExtents);
+        line.band = {0, line.baseline - std::ceil(fontExtents.ascent), 0, std::ceil(fontExtents.ascent) + std::ceil(fontExtents.descent)};
+
+        maxWidth = std::max(maxWidth, line.width);
+    }
+
+    // grow in steps, so numbers changing width don't reallocate every frame
+    const Vector2D SIZE = {std::ceil((maxWidth + 2) / 64.0) * 64.0, (double)offsetY};
+
+    if (m_tOverlay.resize(SIZE)) {
+        g_pHyprRenderer->damageBox(&m_bLastDrawnBox);
+        m_vLines.clear();
+
+        cairo = m_tOverlay.cairo();
+        cairo_select_font_face(cairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    }
+
+    CRegion changed;
+    for (size_t i = 0; i < std::max(lines.size(), m_vLines.size()); ++i) {
+        if (i < lines.size() && i < m_vLines.size() && sameLine(lines[i], m_vLines[i]))
+            continue;
+
+        if (i < lines.size())
+            changed.add(lines[i].band.copy().expand(1));
+        if (i < m_vLines.size())
+            changed.add(m_vLines[i].band.copy().expand(1));
+    }
+
+    changed.intersect(0, 0, SIZE.x, SIZE.y);
+
+    // bands are as wide as the surface
+    const auto CHANGEDBOXES = changed.getRects();
+    for (auto& RECT : CHANGEDBOXES) {
+        m_tOverlay.clear({0.0, (double)RECT.y1, SIZE.x, (double)(RECT.y2 - RECT.y1)});
+    }
+
+    if (!changed.empty()) {
+        cairo_save(cairo);
+
+        for (auto& RECT : CHANGEDBOXES) {
+            cairo_rectangle(cairo, 0, RECT.y1, SIZE.x, RECT.y2 - RECT.y1);
+        }
+        cairo_clip(cairo);
+
+        // neighbours reaching into a cleared band are redrawn too, clipped to it
+        for (auto& line : lines) {
+            const CBox BAND = {0, line.band.y, SIZE.x, line.band.h};
+            if (CRegion{BAND}.intersect(changed).empty())
+                continue;
+
+            cairo_set_font_size(cairo, line.fontSize);
+            cairo_set_source_rgba(cairo, line.color.r, line.color.g, line.color.b, line.color.a);
+            cairo_move_to(cairo, 0, line.baseline);
+            cairo_show_text(cairo, line.text.c_str());
+        }
+
+        cairo_restore(cairo);
+
+        auto damage = changed.getExtents();
+        damage.x    = 0;
+        damage.w    = SIZE.x;
+        damage.scale(1.0 / PMONITOR->scale).translate(PMONITOR->vecPosition).expand(1);
+        g_pHyprRenderer->damageBox(&damage);
+    }
 
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(m_pCairoSurface);
-    m_tTexture.allocate();
-    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_vLines = std::move(lines);
 
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
+    m_bLastDrawnBox = CBox{{0, 0}, SIZE}.scale(1.0 / PMONITOR->scale).translate(PMONITOR->vecPosition).expand(1);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    m_tOverlay.upload();
 
-    CBox pMonBox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
-    g_pHyprOpenGL->renderTexture(m_tTexture, &pMonBox, 1.f);
+    CBox pMonBox = {{0, 0}, SIZE};
+    g_pHyprOpenGL->renderTexture(m_tOverlay.m_tTexture, &pMonBox, 1.f);
 }
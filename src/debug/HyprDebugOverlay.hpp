@@ -2,16 +2,27 @@
 
 #include "../defines.hpp"
 #include "../helpers/Monitor.hpp"
-#include "../render/Texture.hpp"
+#include "../render/OverlayTexture.hpp"
 #include <deque>
 #include <cairo/cairo.h>
 #include <unordered_map>
 
 class CHyprRenderer;
 
+struct SDebugOverlayLine {
+    std::string text;
+    int         fontSize = 10;
+    CColor      color;
+    int         baseline = 0;
+
+    // filled in when drawn
+    float width = 0;
+    CBox  band; // rows the glyphs can touch
+};
+
 class CHyprMonitorDebugOverlay {
   public:
-    int  draw(int offset);
+    int  addLines(int offset, std::vector<SDebugOverlayLine>& lines);
 
     void renderData(CMonitor* pMonitor, float µs);
     void renderDataNoOverlay(CMonitor* pMonitor, float µs);
@@ -24,7 +35,6 @@ class CHyprMonitorDebugOverlay {
     std::deque<float>                              m_dLastAnimationTicks;
     std::chrono::high_resolution_clock::time_point m_tpLastFrame;
     CMonitor*                                      m_pMonitor = nullptr;
-    CBox                                           m_wbLastDrawnBox;
 
     friend class CHyprRenderer;
 };
@@ -39,10 +49,10 @@ class CHyprDebugOverlay {
   private:
     std::unordered_map<CMonitor*, CHyprMonitorDebugOverlay> m_mMonitorOverlays;
 
-    cairo_surface_t*                                        m_pCairoSurface = nullptr;
-    cairo_t*                                                m_pCairo        = nullptr;
-
-    CTexture                                                m_tTexture;
+    // one surface for all monitors, lines are only redrawn when their text changes
+    COverlayTexture                                         m_tOverlay;
+    std::vector<SDebugOverlayLine>                          m_vLines;
+    CBox                                                    m_bLastDrawnBox;
 
     friend class CHyprMonitorDebugOverlay;
     friend class CHyprRenderer;
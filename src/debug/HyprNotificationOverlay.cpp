@@ -76,23 +76,64 @@ CBox CHyprNotificationOverlay::drawNotifications(CMonitor* pMonitor) {
 
     const auto            SCALE = pMonitor->scale;
 
-    const auto            MONSIZE = pMonitor->vecTransformedSize;
-
     cairo_text_extents_t  cairoExtents;
-    int                   iconW = 0, iconH = 0;
 
-    cairo_select_font_face(m_pCairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    const auto            PBEZIER = g_pAnimationManager->getBezier("default");
+
+    // measure first, the surface only has to fit the notifications
+    struct SMeasuredNotification {
+        int                   fontSize = 0;
+        Vector2D              size;
+        int                   iconW = 0, iconH = 0;
+        PangoLayout*          pangoLayout = nullptr;
+        PangoFontDescription* pangoFD     = nullptr;
+    };
 
-    const auto PBEZIER = g_pAnimationManager->getBezier("default");
+    std::vector<SMeasuredNotification> measured;
+    Vector2D                           surfaceSize = {0, 10};
+
+    auto                               cairo = m_tOverlay.cairo();
+    cairo_select_font_face(cairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
 
     for (auto& notif : m_dNotifications) {
-        const auto            ICONPADFORNOTIF = notif->icon == ICON_NONE ? 0 : ICON_PAD;
-        const auto            FONTSIZE        = std::clamp((int)(notif->fontSize * ((pMonitor->vecPixelSize.x * SCALE) / 1920.f)), 8, 40);
+        auto&      m               = measured.emplace_back();
+        const auto ICONPADFORNOTIF = notif->icon == ICON_NONE ? 0 : ICON_PAD;
 
-        PangoLayout*          pangoLayout = pango_cairo_create_layout(m_pCairo);
-        PangoFontDescription* pangoFD     = pango_font_description_from_string(("Sans " + std::to_string(FONTSIZE * ICON_SCALE)).c_str());
-        pango_layout_set_font_description(pangoLayout, pangoFD);
-        cairo_set_font_size(m_pCairo, FONTSIZE);
+        m.fontSize    = std::clamp((int)(notif->fontSize * ((pMonitor->vecPixelSize.x * SCALE) / 1920.f)), 8, 40);
+        m.pangoLayout = pango_cairo_create_layout(cairo);
+        m.pangoFD     = pango_font_description_from_string(("Sans " + std::to_string(m.fontSize * ICON_SCALE)).c_str());
+        pango_layout_set_font_description(m.pangoLayout, m.pangoFD);
+        cairo_set_font_size(cairo, m.fontSize);
+
+        // get text size
+        cairo_text_extents(cairo, notif->text.c_str(), &cairoExtents);
+        pango_layout_set_text(m.pangoLayout, ICONS_ARRAY[m_eIconBackend][notif->icon].c_str(), -1);
+        pango_cairo_update_layout(cairo, m.pangoLayout);
+        pango_layout_get_size(m.pangoLayout, &m.iconW, &m.iconH);
+        m.iconW /= PANGO_SCALE;
+        m.iconH /= PANGO_SCALE;
+
+        m.size = Vector2D{cairoExtents.width + 20 + m.iconW + 2 * ICONPADFORNOTIF, cairoExtents.height + 10};
+
+        surfaceSize.x = std::max(surfaceSize.x, m.size.x + NOTIF_LEFTBAR_SIZE);
+        surfaceSize.y += m.size.y + 10;
+    }
+
+    // everything animates, so the whole surface is redrawn
+    if (!m_tOverlay.resize(surfaceSize))
+        m_tOverlay.clear({{0, 0}, m_tOverlay.m_vSize});
+
+    cairo = m_tOverlay.cairo();
+    cairo_select_font_face(cairo, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+
+    // the surface is anchored to the right edge of the monitor
+    const auto RIGHT = m_tOverlay.m_vSize.x;
+
+    for (size_t i = 0; i < m_dNotifications.size(); ++i) {
+        const auto& notif           = m_dNotifications[i];
+        const auto& m               = measured[i];
+        const auto  ICONPADFORNOTIF = notif->icon == ICON_NONE ? 0 : ICON_PAD;
+        const auto  NOTIFSIZE       = m.size;
 
         // first rect (bg, col)
         const float FIRSTRECTANIMP =
@@ -114,67 +155,59 @@ CBox CHyprNotificationOverlay::drawNotifications(CMonitor* pMonitor) {
         // third rect (horiz, col)
         const float THIRDRECTPERC = notif->started.getMillis() / notif->timeMs;
 
-        // get text size
-        cairo_text_extents(m_pCairo, notif->text.c_str(), &cairoExtents);
-        const auto ICON      = ICONS_ARRAY[m_eIconBackend][notif->icon];
-        const auto ICONCOLOR = ICONS_COLORS[notif->icon];
-        pango_layout_set_text(pangoLayout, ICON.c_str(), -1);
-        pango_layout_set_font_description(pangoLayout, pangoFD);
-        pango_cairo_update_layout(m_pCairo, pangoLayout);
-        pango_layout_get_size(pangoLayout, &iconW, &iconH);
-        iconW /= PANGO_SCALE;
-        iconH /= PANGO_SCALE;
+        const auto  ICONCOLOR = ICONS_COLORS[notif->icon];
 
-        cairo_set_source_rgba(m_pCairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
-
-        const auto NOTIFSIZE = Vector2D{cairoExtents.width + 20 + iconW + 2 * ICONPADFORNOTIF, cairoExtents.height + 10};
+        cairo_set_source_rgba(cairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
 
         // draw rects
-        cairo_rectangle(m_pCairo, MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, NOTIFSIZE.y);
-        cairo_fill(m_pCairo);
+        cairo_rectangle(cairo, RIGHT - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, NOTIFSIZE.y);
+        cairo_fill(cairo);
 
-        cairo_set_source_rgb(m_pCairo, 0.f, 0.f, 0.f);
+        cairo_set_source_rgb(cairo, 0.f, 0.f, 0.f);
 
-        cairo_rectangle(m_pCairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC, offsetY, NOTIFSIZE.x * SECONDRECTPERC, NOTIFSIZE.y);
-        cairo_fill(m_pCairo);
+        cairo_rectangle(cairo, RIGHT - NOTIFSIZE.x * SECONDRECTPERC, offsetY, NOTIFSIZE.x * SECONDRECTPERC, NOTIFSIZE.y);
+        cairo_fill(cairo);
 
-        cairo_set_source_rgba(m_pCairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
+        cairo_set_source_rgba(cairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
 
-        cairo_rectangle(m_pCairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + 3, offsetY + NOTIFSIZE.y - 4, THIRDRECTPERC * (NOTIFSIZE.x - 6), 2);
-        cairo_fill(m_pCairo);
+        cairo_rectangle(cairo, RIGHT - NOTIFSIZE.x * SECONDRECTPERC + 3, offsetY + NOTIFSIZE.y - 4, THIRDRECTPERC * (NOTIFSIZE.x - 6), 2);
+        cairo_fill(cairo);
 
         // draw gradient
         if (notif->icon != ICON_NONE) {
             cairo_pattern_t* pattern;
-            pattern = cairo_pattern_create_linear(MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY,
-                                                  MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC + GRADIENT_SIZE, offsetY);
+            pattern = cairo_pattern_create_linear(RIGHT - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY,
+                                                  RIGHT - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC + GRADIENT_SIZE, offsetY);
             cairo_pattern_add_color_stop_rgba(pattern, 0, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, ICONCOLOR.a / 3.0);
             cairo_pattern_add_color_stop_rgba(pattern, 1, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, 0);
-            cairo_rectangle(m_pCairo, MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, GRADIENT_SIZE, NOTIFSIZE.y);
-            cairo_set_source(m_pCairo, pattern);
-            cairo_fill(m_pCairo);
+            cairo_rectangle(cairo, RIGHT - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, GRADIENT_SIZE, NOTIFSIZE.y);
+            cairo_set_source(cairo, pattern);
+            cairo_fill(cairo);
             cairo_pattern_destroy(pattern);
 
             // draw icon
-            cairo_set_source_rgb(m_pCairo, 1.f, 1.f, 1.f);
-            cairo_move_to(m_pCairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + ICONPADFORNOTIF - 1, offsetY + std::round((NOTIFSIZE.y - iconH - 4) / 2.0));
-            pango_cairo_show_layout(m_pCairo, pangoLayout);
+            cairo_set_source_rgb(cairo, 1.f, 1.f, 1.f);
+            cairo_move_to(cairo, RIGHT - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + ICONPADFORNOTIF - 1, offsetY + std::round((NOTIFSIZE.y - m.iconH - 4) / 2.0));
+            pango_cairo_update_layout(cairo, m.pangoLayout);
+            pango_cairo_show_layout(cairo, m.pangoLayout);
         }
 
         // draw text
-        cairo_set_font_size(m_pCairo, FONTSIZE);
-        cairo_set_source_rgb(m_pCairo, 1.f, 1.f, 1.f);
-        cairo_move_to(m_pCairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + iconW + 2 * ICONPADFORNOTIF, offsetY + FONTSIZE + (FONTSIZE / 10.0));
-        cairo_show_text(m_pCairo, notif->text.c_str());
+        cairo_set_font_size(cairo, m.fontSize);
+        cairo_set_source_rgb(cairo, 1.f, 1.f, 1.f);
+        cairo_move_to(cairo, RIGHT - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + m.iconW + 2 * ICONPADFORNOTIF, offsetY + m.fontSize + (m.fontSize / 10.0));
+        cairo_show_text(cairo, notif->text.c_str());
 
         // adjust offset and move on
         offsetY += NOTIFSIZE.y + 10;
 
         if (maxWidth < NOTIFSIZE.x)
             maxWidth = NOTIFSIZE.x;
+    }
 
-        pango_font_description_free(pangoFD);
-        g_object_unref(pangoLayout);
+    for (auto& m : measured) {
+        pango_font_description_free(m.pangoFD);
+        g_object_unref(m.pangoLayout);
     }
 
     // cleanup notifs
@@ -185,35 +218,12 @@ CBox CHyprNotificationOverlay::drawNotifications(CMonitor* pMonitor) {
 
 void CHyprNotificationOverlay::draw(CMonitor* pMonitor) {
 
-    const auto MONSIZE = pMonitor->vecTransformedSize;
-
-    if (m_pLastMonitor != pMonitor || m_vecLastSize != MONSIZE || !m_pCairo || !m_pCairoSurface) {
-
-        if (m_pCairo && m_pCairoSurface) {
-            cairo_destroy(m_pCairo);
-            cairo_surface_destroy(m_pCairoSurface);
-        }
-
-        m_pCairoSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, MONSIZE.x, MONSIZE.y);
-        m_pCairo        = cairo_create(m_pCairoSurface);
-        m_pLastMonitor  = pMonitor;
-        m_vecLastSize   = MONSIZE;
-    }
-
     // Draw the notifications
     if (m_dNotifications.size() == 0)
         return;
 
     // Render to the monitor
 
-    // clear the pixmap
-    cairo_save(m_pCairo);
-    cairo_set_operator(m_pCairo, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(m_pCairo);
-    cairo_restore(m_pCairo);
-
-    cairo_surface_flush(m_pCairoSurface);
-
     CBox damage = drawNotifications(pMonitor);
 
     g_pHyprRenderer->damageBox(&damage);
@@ -224,21 +234,10 @@ void CHyprNotificationOverlay::draw(CMonitor* pMonitor) {
     m_bLastDamage = damage;
 
     // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(m_pCairoSurface);
-    m_tTexture.allocate();
-    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, MONSIZE.x, MONSIZE.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    m_tOverlay.upload();
 
-    CBox pMonBox = {0, 0, MONSIZE.x, MONSIZE.y};
-    g_pHyprOpenGL->renderTexture(m_tTexture, &pMonBox, 1.f);
+    CBox texbox = {pMonitor->vecTransformedSize.x - m_tOverlay.m_vSize.x, 0, m_tOverlay.m_vSize.x, m_tOverlay.m_vSize.y};
+    g_pHyprOpenGL->renderTexture(m_tOverlay.m_tTexture, &texbox, 1.f);
 }
 
 bool CHyprNotificationOverlay::hasAny() {
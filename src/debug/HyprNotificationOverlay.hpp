@@ -3,7 +3,7 @@
 #include "../defines.hpp"
 #include "../helpers/Timer.hpp"
 #include "../helpers/Monitor.hpp"
-#include "../render/Texture.hpp"
+#include "../render/OverlayTexture.hpp"
 #include "../SharedDefs.hpp"
 
 #include <deque>
@@ -51,13 +51,7 @@ class CHyprNotificationOverlay {
 
     std::deque<std::unique_ptr<SNotification>> m_dNotifications;
 
-    cairo_surface_t*                           m_pCairoSurface = nullptr;
-    cairo_t*                                   m_pCairo        = nullptr;
-
-    CMonitor*                                  m_pLastMonitor = nullptr;
-    Vector2D                                   m_vecLastSize  = Vector2D(-1, -1);
-
-    CTexture                                   m_tTexture;
+    COverlayTexture                            m_tOverlay;
 
     eIconBackend                               m_eIconBackend   = ICONS_BACKEND_NONE;
     std::string                                m_szIconFontName = "Sans";
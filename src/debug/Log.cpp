@@ -1,12 +1,225 @@
 #include "Log.hpp"
 #include "../defines.hpp"
 #include "../Compositor.hpp"
+#include "../helpers/MPSCQueue.hpp"
 
 #include <fstream>
 #include <iostream>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+    Lines are queued by the logging thread and written out in batches by a writer thread,
+    so logging never does file syscalls on the main thread.
+*/
+class CLogWriter {
+  public:
+    ~CLogWriter() {
+        stop();
+    }
+
+    void start(const std::string& path) {
+        m_iFD = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+        if (m_iFD < 0) {
+            std::cout << "[ERR] Couldn't open the log file " << path << "\n";
+            return;
+        }
+
+        m_tThread = std::thread([this]() { writerThread(); });
+    }
+
+    void stop() {
+        if (m_tThread.joinable()) {
+            m_bExit = true;
+            wakeup();
+            m_tThread.join();
+        }
+
+        flush();
+
+        if (m_iFD >= 0)
+            ::close(m_iFD);
+
+        m_iFD = -1;
+    }
+
+    void queue(std::string&& line) {
+        if (m_iFD < 0)
+            return;
+
+        m_qLines.push(std::move(line));
+        wakeup();
+    }
+
+    // writes everything queued from the calling thread
+    void flush() {
+        std::vector<std::string> lines;
+        m_qLines.popAll(lines);
+        writeLines(lines);
+    }
+
+    // Only calls async-signal-safe functions. Stops the writer thread from consuming first,
+    // the queue can only have one consumer, then drains it through a preallocated buffer.
+    void flushFromCrashHandler() {
+        m_bCrashing = true;
+
+        // crashed on the writer thread itself, the queue might be half taken apart
+        if (m_iWriterTID == gettid())
+            return;
+
+        // the writer can't start another batch anymore, wait for the current one. The crash handler's alarm covers a stuck write.
+        while (m_bWriterBusy) {
+            ;
+        }
+
+        if (m_iFD < 0)
+            return;
+
+        size_t used = 0;
+        m_qLines.drainWithoutFreeing([&](const std::string& line) {
+            if (used + line.size() > m_aCrashBuffer.size()) {
+                writeAll(m_aCrashBuffer.data(), used);
+                used = 0;
+            }
+
+            if (line.size() > m_aCrashBuffer.size()) {
+                writeAll(line.data(), line.size());
+                return;
+            }
+
+            memcpy(m_aCrashBuffer.data() + used, line.data(), line.size());
+            used += line.size();
+        });
+
+        writeAll(m_aCrashBuffer.data(), used);
+    }
+
+  private:
+    void wakeup() {
+        if (!m_bWakeup.exchange(true))
+            m_bWakeup.notify_one();
+    }
+
+    void writerThread() {
+        std::vector<std::string> lines;
+
+        m_iWriterTID = gettid();
+
+        while (true) {
+            m_bWakeup.wait(false);
+            m_bWakeup = false;
+
+            // announce the batch before checking, so the crash handler either sees it running or stops it from starting
+            m_bWriterBusy = true;
+            if (m_bCrashing) {
+                m_bWriterBusy = false;
+                return;
+            }
+
+            m_qLines.popAll(lines);
+            writeLines(lines);
+            lines.clear();
+
+            m_bWriterBusy = false;
+
+            if (m_bExit)
+                break;
+        }
+    }
+
+    void writeLines(const std::vector<std::string>& lines) {
+        if (lines.empty() || m_iFD < 0)
+            return;
+
+        std::string batch;
+        for (auto& l : lines) {
+            batch += l;
+        }
+
+        writeAll(batch.data(), batch.size());
+    }
+
+    void writeAll(const char* data, size_t size) {
+        size_t written = 0;
+        while (written < size) {
+            const auto RET = write(m_iFD, data + written, size - written);
+
+            if (RET < 0 && errno == EINTR)
+                continue;
+
+            if (RET <= 0)
+                return;
+
+            written += RET;
+        }
+    }
+
+    int                         m_iFD = -1;
+    CMPSCQueue<std::string>     m_qLines;
+    std::atomic<bool>           m_bWakeup     = false;
+    std::atomic<bool>           m_bExit       = false;
+    std::atomic<bool>           m_bCrashing   = false;
+    std::atomic<bool>           m_bWriterBusy = false;
+    std::atomic<pid_t>          m_iWriterTID  = 0;
+    std::thread                 m_tThread;
+
+    std::array<char, 64 * 1024> m_aCrashBuffer = {};
+};
+
+static CLogWriter logWriter;
+
+void Debug::CRollingLog::append(std::string_view str) {
+    std::lock_guard<std::mutex> lg(m_mMutex);
+
+    // only the tail fits anyways
+    if (str.size() > m_aBuffer.size())
+        str = str.substr(str.size() - m_aBuffer.size());
+
+    const size_t FIRST = std::min(str.size(), m_aBuffer.size() - m_iPos);
+    memcpy(m_aBuffer.data() + m_iPos, str.data(), FIRST);
+    memcpy(m_aBuffer.data(), str.data() + FIRST, str.size() - FIRST);
+
+    if (m_iPos + str.size() >= m_aBuffer.size())
+        m_bFull = true;
+
+    m_iPos = (m_iPos + str.size()) % m_aBuffer.size();
+}
+
+std::string Debug::CRollingLog::get() {
+    std::lock_guard<std::mutex> lg(m_mMutex);
+
+    const auto [OLDEST, NEWEST] = unsafeViews();
+
+    std::string result;
+    result.reserve(OLDEST.size() + NEWEST.size());
+    result += OLDEST;
+    result += NEWEST;
+    return result;
+}
+
+std::pair<std::string_view, std::string_view> Debug::CRollingLog::unsafeViews() const {
+    if (!m_bFull)
+        return {std::string_view{m_aBuffer.data(), m_iPos}, std::string_view{}};
+
+    return {std::string_view{m_aBuffer.data() + m_iPos, m_aBuffer.size() - m_iPos}, std::string_view{m_aBuffer.data(), m_iPos}};
+}
 
 void Debug::init(const std::string& IS) {
     logFile = IS + (ISDEBUG ? "/hyprlandd.log" : "/hyprland.log");
+
+    logWriter.start(logFile);
+}
+
+void Debug::close() {
+    logWriter.stop();
+}
+
+void Debug::flushFromCrashHandler() {
+    logWriter.flushFromCrashHandler();
 }
 
 void Debug::wlrLog(wlr_log_importance level, const char* fmt, va_list args) {
@@ -20,14 +233,10 @@ void Debug::wlrLog(wlr_log_importance level, const char* fmt, va_list args) {
     std::string output = std::string(outputStr);
     free(outputStr);
 
-    rollingLog += output + "\n";
+    rollingLog.append(output + "\n");
 
-    if (!disableLogs || !**disableLogs) {
-        std::ofstream ofs;
-        ofs.open(logFile, std::ios::out | std::ios::app);
-        ofs << "[wlr] " << output << "\n";
-        ofs.close();
-    }
+    if (!disableLogs || !**disableLogs)
+        logWriter.queue("[wlr] " + output + "\n");
 
     if (!disableStdout)
         std::cout << output << "\n";
@@ -69,20 +278,15 @@ void Debug::log(LogLevel level, std::string str) {
         default: break;
     }
 
-    rollingLog += str + "\n";
-    if (rollingLog.size() > ROLLING_LOG_SIZE)
-        rollingLog = rollingLog.substr(rollingLog.size() - ROLLING_LOG_SIZE);
+    str += "\n";
 
-    if (!disableLogs || !**disableLogs) {
-        // log to a file
-        std::ofstream ofs;
-        ofs.open(logFile, std::ios::out | std::ios::app);
-        ofs << str << "\n";
+    rollingLog.append(str);
 
-        ofs.close();
-    }
+    // log to a file
+    if (!disableLogs || !**disableLogs)
+        logWriter.queue(std::string{str});
 
     // log it to the stdout too.
     if (!disableStdout)
-        std::cout << ((coloredLogs && !**coloredLogs) ? str : coloredStr) << "\n";
+        std::cout << ((coloredLogs && !**coloredLogs) ? str : coloredStr + "\n");
 }
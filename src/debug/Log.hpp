@@ -4,6 +4,9 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <array>
+#include <mutex>
+#include <string_view>
 #include "../includes.hpp"
 #include "../helpers/MiscFunctions.hpp"
 
@@ -21,6 +24,22 @@ enum LogLevel {
 };
 
 namespace Debug {
+    // fixed-size circular buffer holding the ROLLING_LOG_SIZE tail of the log
+    class CRollingLog {
+      public:
+        void        append(std::string_view str);
+        std::string get();
+
+        // unlocked view of the contents, oldest part first. Only meant for the crash handler.
+        std::pair<std::string_view, std::string_view> unsafeViews() const;
+
+      private:
+        std::array<char, ROLLING_LOG_SIZE> m_aBuffer = {};
+        size_t                             m_iPos    = 0;
+        bool                               m_bFull   = false;
+        std::mutex                         m_mMutex;
+    };
+
     inline std::string     logFile;
     inline int64_t* const* disableLogs   = nullptr;
     inline int64_t* const* disableTime   = nullptr;
@@ -29,9 +48,14 @@ namespace Debug {
     inline bool            shuttingDown  = false;
     inline int64_t* const* coloredLogs   = nullptr;
 
-    inline std::string     rollingLog = ""; // rolling log contains the ROLLING_LOG_SIZE tail of the log
+    inline CRollingLog     rollingLog;
 
-    void                   init(const std::string& IS);
+    // opens the log file and starts the writer thread
+    void init(const std::string& IS);
+    // writes out everything still queued and stops the writer thread
+    void close();
+    // writes out everything still queued from the calling thread, for the crash handler
+    void flushFromCrashHandler();
 
     //
     void log(LogLevel level, std::string str);
@@ -3,4 +3,5 @@
 
 class CWorkspace;
 
-typedef std::shared_ptr<CWorkspace> PHLWORKSPACE;
\ No newline at end of file
+typedef std::shared_ptr<CWorkspace> PHLWORKSPACE;
+typedef std::weak_ptr<CWorkspace>   PHLWORKSPACEREF;
\ No newline at end of file
@@ -4,11 +4,14 @@
 #include "../defines.hpp"
 #include "WLSurface.hpp"
 #include "../helpers/AnimatedVariable.hpp"
+#include "../helpers/RuleRegex.hpp"
 #include "wlr-layer-shell-unstable-v1-protocol.h"
 
 struct SLayerRule {
-    std::string targetNamespace = "";
-    std::string rule            = "";
+    std::string    targetNamespace = "";
+    std::string    rule            = "";
+
+    SP<CRuleRegex> rNamespace; // compiled targetNamespace, unset for address: rules
 };
 
 class CLayerSurface {
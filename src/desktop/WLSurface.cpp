@@ -12,6 +12,9 @@ void CWLSurface::assign(wlr_surface* pSurface, PHLWINDOW pOwner) {
     m_pWLRSurface  = pSurface;
     init();
     m_bInert = false;
+
+    // windows are indexed by their surface
+    g_pCompositor->invalidateWindowIndex();
 }
 
 void CWLSurface::assign(wlr_surface* pSurface, PHLLS pOwner) {
@@ -112,6 +115,10 @@ void CWLSurface::destroy() {
     hyprListener_destroy.removeCallback();
     hyprListener_commit.removeCallback();
     m_pWLRSurface->data = nullptr;
+
+    if (!m_pWindowOwner.expired() && g_pCompositor)
+        g_pCompositor->invalidateWindowIndex();
+
     m_pWindowOwner.reset();
     m_pLayerOwner.reset();
     m_pPopupOwner      = nullptr;
@@ -352,7 +352,7 @@ void CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace) {
 
     const auto  OLDWORKSPACE = m_pWorkspace;
 
-    m_pWorkspace = pWorkspace;
+    setWorkspace(pWorkspace);
 
     setAnimationsToMove();
 
@@ -473,7 +473,7 @@ void CWindow::onUnmap() {
     g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m_iMonitorID);
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
-    m_pWorkspace.reset();
+    setWorkspace(nullptr);
 
     if (m_bIsX11)
         return;
@@ -538,6 +538,16 @@ void CWindow::onBorderAngleAnimEnd(void* ptr) {
     PANIMVAR->setCallbackOnEnd([&](void* ptr) { onBorderAngleAnimEnd(ptr); }, false);
 }
 
+void CWindow::setWorkspace(PHLWORKSPACE pWorkspace) {
+    m_pWorkspace = pWorkspace;
+    g_pCompositor->invalidateWindowIndex();
+}
+
+void CWindow::setPinned(bool pinned) {
+    m_bPinned = pinned;
+    g_pCompositor->invalidateWindowIndex();
+}
+
 void CWindow::setHidden(bool hidden) {
     m_bHidden = hidden;
 
@@ -13,6 +13,7 @@
 #include "../managers/XWaylandManager.hpp"
 #include "DesktopTypes.hpp"
 #include "../helpers/signal/Signal.hpp"
+#include "../helpers/RuleRegex.hpp"
 
 enum eIdleInhibitMode {
     IDLEINHIBIT_NONE = 0,
@@ -186,6 +187,12 @@ struct SWindowRule {
     int         bFocus        = -1;
     std::string szOnWorkspace = ""; // empty means any
     std::string szWorkspace   = ""; // empty means any
+
+    // compiled at config parse time from the patterns above
+    SP<CRuleRegex> rTitle;
+    SP<CRuleRegex> rClass;
+    SP<CRuleRegex> rInitialTitle;
+    SP<CRuleRegex> rInitialClass;
 };
 
 struct SInitialWorkspaceToken {
@@ -272,7 +279,7 @@ class CWindow {
     std::string  m_szTitle             = "";
     std::string  m_szInitialTitle      = "";
     std::string  m_szInitialClass      = "";
-    PHLWORKSPACE m_pWorkspace;
+    PHLWORKSPACE m_pWorkspace; // set through setWorkspace(), the compositor indexes windows by it
 
     bool         m_bIsMapped = false;
 
@@ -319,7 +326,7 @@ class CWindow {
     SWindowDecorationExtents m_eOriginalClosedExtents;
     bool                     m_bAnimatingIn = false;
 
-    // For pinned (sticky) windows
+    // For pinned (sticky) windows. Set through setPinned(), the compositor indexes windows by it
     bool m_bPinned = false;
 
     // urgency hint
@@ -404,6 +411,8 @@ class CWindow {
     void                     updateToplevel();
     void                     updateSurfaceScaleTransformDetails();
     void                     moveToWorkspace(PHLWORKSPACE);
+    void                     setWorkspace(PHLWORKSPACE); // only sets m_pWorkspace, see moveToWorkspace for the rest
+    void                     setPinned(bool pinned);
     PHLWINDOW                X11TransientFor();
     void                     onUnmap();
     void                     onMap();
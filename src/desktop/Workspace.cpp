@@ -29,8 +29,10 @@ void CWorkspace::init(PHLWORKSPACE self) {
     m_fAlpha.registerVar();
 
     const auto RULEFORTHIS = g_pConfigManager->getWorkspaceRuleFor(self);
-    if (RULEFORTHIS.defaultName.has_value())
+    if (RULEFORTHIS.defaultName.has_value()) {
         m_szName = RULEFORTHIS.defaultName.value();
+        g_pCompositor->invalidateWorkspaceIndex();
+    }
 
     m_pFocusedWindowHook = g_pHookSystem->hookDynamic("closeWindow", [this](void* self, SCallbackInfo& info, std::any param) {
         const auto PWINDOW = std::any_cast<PHLWINDOW>(param);
@@ -498,6 +500,8 @@ void CWorkspace::markInert() {
     m_iID        = WORKSPACE_INVALID;
     m_iMonitorID = -1;
     m_bVisible   = false;
+
+    g_pCompositor->invalidateWorkspaceIndex();
 }
 
 bool CWorkspace::inert() {
@@ -117,6 +117,8 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
     const auto PNEWMONITOR        = PNEWMONITORWRAP->get();
     PNEWMONITOR->isUnsafeFallback = FALLBACK;
 
+    g_pCompositor->invalidateMonitorIndex();
+
     if (!FALLBACK)
         PNEWMONITOR->onConnect(false);
 
@@ -186,6 +188,7 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     static auto PRATSAFE   = CConfigValue<Hyprlang::INT>("misc:render_ahead_safezone");
 
     PMONITOR->lastPresentationTimer.reset();
+    PMONITOR->frameTiming.onFrame();
 
     if (*PENABLERAT && !PMONITOR->tearingState.nextRenderTorn) {
         if (!PMONITOR->RATScheduled) {
@@ -195,22 +198,25 @@ void Events::listener_monitorFrame(void* owner, void* data) {
 
         PMONITOR->RATScheduled = false;
 
-        const auto& [avg, max, min] = g_pHyprRenderer->getRenderTimes(PMONITOR);
+        // plan for the slow frames, not the average one. A single outlier shouldn't disable RAT though, so p99 instead of the max.
+        const auto FRAMEMS = 1000.0 / PMONITOR->refreshRate;
 
-        if (max + *PRATSAFE > 1000.0 / PMONITOR->refreshRate)
+        if (PMONITOR->frameTiming.renderTimePercentile(99) + *PRATSAFE > FRAMEMS)
             return;
 
-        const auto MSLEFT = 1000.0 / PMONITOR->refreshRate - PMONITOR->lastPresentationTimer.getMillis();
+        const auto MSLEFT = FRAMEMS - PMONITOR->lastPresentationTimer.getMillis();
 
         PMONITOR->RATScheduled = true;
 
-        const auto ESTRENDERTIME = std::ceil(avg + *PRATSAFE);
+        const auto ESTRENDERTIME = std::ceil(PMONITOR->frameTiming.renderTimePercentile(95) + *PRATSAFE);
         const auto TIMETOSLEEP   = std::floor(MSLEFT - ESTRENDERTIME);
 
-        if (MSLEFT < 1 || MSLEFT < ESTRENDERTIME || TIMETOSLEEP < 1)
+        if (MSLEFT < 1 || MSLEFT < ESTRENDERTIME || TIMETOSLEEP < 1) {
             g_pHyprRenderer->renderMonitor(PMONITOR);
-        else
+        } else {
+            PMONITOR->frameTiming.onPredicted(ESTRENDERTIME, TIMETOSLEEP, MSLEFT);
             wl_event_source_timer_update(PMONITOR->renderTimer, TIMETOSLEEP);
+        }
     } else {
         g_pHyprRenderer->renderMonitor(PMONITOR);
     }
@@ -241,6 +247,7 @@ void Events::listener_monitorDestroy(void* owner, void* data) {
     Debug::log(LOG, "Removing monitor {} from realMonitors", pMonitor->szName);
 
     std::erase_if(g_pCompositor->m_vRealMonitors, [&](std::shared_ptr<CMonitor>& el) { return el.get() == pMonitor; });
+    g_pCompositor->invalidateMonitorIndex();
 }
 
 void Events::listener_monitorStateRequest(void* owner, void* data) {
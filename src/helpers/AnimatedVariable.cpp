@@ -61,7 +61,11 @@ int CBaseAnimatedVariable::getDurationLeftMs() {
 }
 
 float CBaseAnimatedVariable::getPercent() {
-    const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - animationBegin).count();
+    return getPercent(std::chrono::system_clock::now());
+}
+
+float CBaseAnimatedVariable::getPercent(const std::chrono::system_clock::time_point& now) {
+    const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(now - animationBegin).count();
     return std::clamp((DURATIONPASSED / 100.f) / m_pConfig->pValues->internalSpeed, 0.f, 1.f);
 }
 
@@ -74,19 +78,21 @@ float CBaseAnimatedVariable::getCurveValue() {
     if (SPENT >= 1.f)
         return 1.f;
 
-    return g_pAnimationManager->getBezier(m_pConfig->pValues->internalBezier)->getYForPoint(SPENT);
+    return g_pAnimationManager->getBezier(m_pConfig->pValues->internalBezierIndex)->getYForPoint(SPENT);
 }
 
 void CBaseAnimatedVariable::connectToActive() {
     g_pAnimationManager->scheduleTick(); // otherwise the animation manager will never pick this up
 
     if (!m_bIsConnectedToActive)
-        g_pAnimationManager->m_vActiveAnimatedVariables.push_back(this);
+        g_pAnimationManager->addActiveVariable(this);
 
     m_bIsConnectedToActive = true;
 }
 
 void CBaseAnimatedVariable::disconnectFromActive() {
-    std::erase_if(g_pAnimationManager->m_vActiveAnimatedVariables, [&](const auto& other) { return other == this; });
+    if (m_bIsConnectedToActive)
+        g_pAnimationManager->removeActiveVariable(this);
+
     m_bIsConnectedToActive = false;
 }
@@ -98,6 +98,7 @@ class CBaseAnimatedVariable {
 
     /* returns the spent (completion) % */
     float getPercent();
+    float getPercent(const std::chrono::system_clock::time_point& now);
 
     /* returns the current curve value */
     float getCurveValue();
@@ -167,6 +168,7 @@ class CBaseAnimatedVariable {
     std::function<void(void* thisptr)>    m_fUpdateCallback;
 
     bool                                  m_bIsConnectedToActive = false;
+    size_t                                m_iActiveIndex         = 0; // position in the animation manager's active lane
 
     void                                  connectToActive();
 
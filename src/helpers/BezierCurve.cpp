@@ -20,14 +20,35 @@ void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
 
     RASSERT(m_dPoints.size() == 4, "CBezierCurve only supports cubic beziers! (points num: {})", m_dPoints.size());
 
-    // bake BAKEDPOINTS points for faster lookups
-    // T -> X ( / BAKEDPOINTS )
-    for (int i = 0; i < BAKEDPOINTS; ++i) {
-        m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
+    m_vCoeffC = m_dPoints[1] * 3.0;
+    m_vCoeffB = (m_dPoints[2] - m_dPoints[1]) * 3.0 - m_vCoeffC;
+    m_vCoeffA = Vector2D(1, 1) - m_vCoeffC - m_vCoeffB;
+
+    // bake BAKEDPOINTS + 1 points for faster lookups
+    // X ( / BAKEDPOINTS ) -> T, found by walking the curve in small steps.
+    // For curves that aren't monotonic in x this picks the first crossing.
+    constexpr int SAMPLES = BAKEDPOINTS * 4;
+    int           sample  = 0;
+    float         lastT   = 0.f;
+    float         nextX   = getXForT(1.f / SAMPLES);
+
+    m_aTForX[0]           = 0.f;
+    m_aTForX[BAKEDPOINTS] = 1.f;
+
+    for (int i = 1; i < BAKEDPOINTS; ++i) {
+        const float X = i * INVBAKEDPOINTS;
+
+        while (nextX < X && sample < SAMPLES - 1) {
+            sample++;
+            lastT = sample / (float)SAMPLES;
+            nextX = getXForT((sample + 1) / (float)SAMPLES);
+        }
+
+        m_aTForX[i] = bisectT(X, lastT, (sample + 1) / (float)SAMPLES);
     }
 
     const auto ELAPSEDUS  = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / 1000.f;
-    const auto POINTSSIZE = m_aPointsBaked.size() * sizeof(m_aPointsBaked[0]) / 1000.f;
+    const auto POINTSSIZE = m_aTForX.size() * sizeof(m_aTForX[0]) / 1000.f;
 
     const auto BEGINCALC = std::chrono::high_resolution_clock::now();
     for (float i = 0.1f; i < 1.f; i += 0.1f)
@@ -39,39 +60,60 @@ void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
 }
 
 float CBezierCurve::getYForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].y + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].y + pow(t, 3);
+    return ((m_vCoeffA.y * t + m_vCoeffB.y) * t + m_vCoeffC.y) * t;
 }
 
 float CBezierCurve::getXForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].x + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].x + pow(t, 3);
+    return ((m_vCoeffA.x * t + m_vCoeffB.x) * t + m_vCoeffC.x) * t;
+}
+
+float CBezierCurve::getXDerivativeForT(float t) {
+    return (3 * m_vCoeffA.x * t + 2 * m_vCoeffB.x) * t + m_vCoeffC.x;
+}
+
+float CBezierCurve::bisectT(float x, float lower, float upper) {
+    for (int i = 0; i < 16; ++i) {
+        const float MID = (lower + upper) / 2.f;
+        if (getXForT(MID) < x)
+            lower = MID;
+        else
+            upper = MID;
+    }
+
+    return (lower + upper) / 2.f;
 }
 
-// Todo: this probably can be done better and faster
 float CBezierCurve::getYForPoint(float x) {
     if (x >= 1.f)
         return 1.f;
 
-    int  index = 0;
-    bool below = true;
-    for (int step = (BAKEDPOINTS + 1) / 2; step > 0; step /= 2) {
-        if (below)
-            index += step;
-        else
-            index -= step;
+    if (x <= 0.f)
+        return 0.f;
 
-        below = m_aPointsBaked[index].x < x;
-    }
+    // O(1) lookup of the surrounding baked points, no search needed as they are evenly spaced in x
+    const float POS   = x * BAKEDPOINTS;
+    const int   INDEX = std::min((int)POS, BAKEDPOINTS - 1);
+    const float LOWER = m_aTForX[INDEX];
+    const float UPPER = m_aTForX[INDEX + 1];
 
-    int lowerIndex = index - (!below || index == BAKEDPOINTS - 1);
+    float       t = LOWER + (UPPER - LOWER) * (POS - INDEX);
 
-    // in the name of performance i shall make a hack
-    const auto LOWERPOINT = &m_aPointsBaked[lowerIndex];
-    const auto UPPERPOINT = &m_aPointsBaked[lowerIndex + 1];
+    // refine with newton's method. The guess is already close, so this usually converges in one or two steps.
+    for (int i = 0; i < 4; ++i) {
+        const float ERROR = getXForT(t) - x;
 
-    const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+        if (std::abs(ERROR) < 1e-6f)
+            return getYForT(t);
 
-    if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA)) // can sometimes happen for VERY small x
-        return 0.f;
+        const float NEXT = t - ERROR / getXDerivativeForT(t);
+
+        // flat spots or a jump to another crossing on weird curves
+        if (!(NEXT >= LOWER && NEXT <= UPPER))
+            break;
+
+        t = NEXT;
+    }
 
-    return LOWERPOINT->y + (UPPERPOINT->y - LOWERPOINT->y) * PERCINDELTA;
+    // didn't converge, bisect instead
+    return getYForT(bisectT(x, LOWER, UPPER));
 }
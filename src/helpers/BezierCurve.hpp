@@ -21,8 +21,15 @@ class CBezierCurve {
     float getYForPoint(float x);
 
   private:
+    float getXDerivativeForT(float t);
+    float bisectT(float x, float lower, float upper); // t for x, with x(lower) < x <= x(upper)
+
     // this INCLUDES the 0,0 and 1,1 points.
-    std::deque<Vector2D>              m_dPoints;
+    std::deque<Vector2D> m_dPoints;
+
+    // polynomial coefficients, x(t) = ((a * t + b) * t + c) * t
+    Vector2D m_vCoeffA, m_vCoeffB, m_vCoeffC;
 
-    std::array<Vector2D, BAKEDPOINTS> m_aPointsBaked;
+    // t for x = i / BAKEDPOINTS, used as the starting guess for newton's method
+    std::array<float, BAKEDPOINTS + 1> m_aTForX;
 };
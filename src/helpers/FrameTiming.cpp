@@ -0,0 +1,105 @@
+#include "FrameTiming.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void CFrameTimingModel::CSampleWindow::add(float value) {
+    if (m_iCount == SAMPLES)
+        m_fSum -= m_aValues[m_iPos];
+    else
+        m_iCount++;
+
+    m_fSum += value;
+
+    m_aValues[m_iPos] = value;
+    m_iPos            = (m_iPos + 1) % SAMPLES;
+    m_bSorted         = false;
+}
+
+float CFrameTimingModel::CSampleWindow::percentile(float percentile) {
+    if (m_iCount == 0)
+        return 0.f;
+
+    // sorted lazily, at most once per new sample no matter how many percentiles are asked for
+    if (!m_bSorted) {
+        std::copy_n(m_aValues.begin(), m_iCount, m_aSorted.begin());
+        std::sort(m_aSorted.begin(), m_aSorted.begin() + m_iCount);
+        m_bSorted = true;
+    }
+
+    const size_t INDEX = std::clamp((size_t)std::ceil(percentile / 100.f * m_iCount), (size_t)1, m_iCount) - 1;
+    return m_aSorted[INDEX];
+}
+
+float CFrameTimingModel::CSampleWindow::average() const {
+    return m_iCount == 0 ? 0.f : m_fSum / m_iCount;
+}
+
+size_t CFrameTimingModel::CSampleWindow::size() const {
+    return m_iCount;
+}
+
+void CFrameTimingModel::onCommit(float renderMs) {
+    const auto NOW = std::chrono::steady_clock::now();
+
+    m_sRenderTimes.add(renderMs);
+    m_tLastCommit = NOW;
+
+    if (m_tPredictedDeadline) {
+        if (NOW > *m_tPredictedDeadline)
+            m_sPredictions.missed++;
+
+        m_tPredictedDeadline.reset();
+    }
+}
+
+void CFrameTimingModel::onFrame() {
+    const auto NOW = std::chrono::steady_clock::now();
+
+    if (m_tLastCommit) {
+        m_sPresentLatencies.add(std::chrono::duration_cast<std::chrono::microseconds>(NOW - *m_tLastCommit).count() / 1000.f);
+        m_tLastCommit.reset();
+    }
+
+    // the vblank came and the scheduled render didn't make it in
+    if (m_tPredictedDeadline && NOW >= *m_tPredictedDeadline) {
+        m_sPredictions.missed++;
+        m_tPredictedDeadline.reset();
+    }
+}
+
+void CFrameTimingModel::onPredicted(float renderMs, float sleepMs, float msToVblank) {
+    m_sPredictions.scheduled++;
+    m_sPredictions.lastRenderMs = renderMs;
+    m_sPredictions.lastSleepMs  = sleepMs;
+
+    m_tPredictedDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(msToVblank * 1000.f));
+}
+
+void CFrameTimingModel::onPredictedRenderDone() {
+    m_tPredictedDeadline.reset();
+}
+
+float CFrameTimingModel::renderTimePercentile(float percentile) {
+    return m_sRenderTimes.percentile(percentile);
+}
+
+float CFrameTimingModel::renderTimeAverage() const {
+    return m_sRenderTimes.average();
+}
+
+float CFrameTimingModel::presentLatencyPercentile(float percentile) {
+    return m_sPresentLatencies.percentile(percentile);
+}
+
+float CFrameTimingModel::presentLatencyAverage() const {
+    return m_sPresentLatencies.average();
+}
+
+const CFrameTimingModel::SPredictionStats& CFrameTimingModel::predictionStats() const {
+    return m_sPredictions;
+}
+
+size_t CFrameTimingModel::samples() const {
+    return m_sRenderTimes.size();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+/*
+    Per-monitor frame timing model, fed by the renderer and the frame events.
+    Keeps a window of the last samples and answers percentile queries,
+    which the render-ahead-of-time scheduler uses to predict the next frame.
+*/
+class CFrameTimingModel {
+  public:
+    // called after a successful commit, with the CPU time the frame took to render
+    void onCommit(float renderMs);
+    // called on every frame event of the output
+    void onFrame();
+
+    // a render-ahead-of-time render was scheduled. Resolved as a hit or miss by the next commit or frame event.
+    void  onPredicted(float renderMs, float sleepMs, float msToVblank);
+    void  onPredictedRenderDone();
+
+    float renderTimePercentile(float percentile);
+    float renderTimeAverage() const;
+    float presentLatencyPercentile(float percentile);
+    float presentLatencyAverage() const;
+
+    struct SPredictionStats {
+        uint64_t scheduled    = 0;
+        uint64_t missed       = 0; // committed after the vblank it was scheduled for, or not at all
+        float    lastRenderMs = 0.f;
+        float    lastSleepMs  = 0.f;
+    };
+
+    const SPredictionStats& predictionStats() const;
+    size_t                  samples() const;
+
+  private:
+    class CSampleWindow {
+      public:
+        void   add(float value);
+        float  percentile(float percentile);
+        float  average() const;
+        size_t size() const;
+
+      private:
+        static constexpr size_t    SAMPLES = 128;
+
+        std::array<float, SAMPLES> m_aValues = {};
+        std::array<float, SAMPLES> m_aSorted = {};
+        size_t                     m_iPos    = 0;
+        size_t                     m_iCount  = 0;
+        double                     m_fSum    = 0.0;
+        bool                       m_bSorted = true;
+    };
+
+    CSampleWindow                                        m_sRenderTimes;
+    CSampleWindow                                        m_sPresentLatencies; // commit -> next frame event
+
+    std::optional<std::chrono::steady_clock::time_point> m_tLastCommit;
+    std::optional<std::chrono::steady_clock::time_point> m_tPredictedDeadline;
+
+    SPredictionStats                                     m_sPredictions;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <utility>
+
+/*
+    A lock-free multi-producer single-consumer queue.
+    Producers push onto an atomic singly-linked stack, the consumer
+    takes the whole stack at once and reverses it to restore FIFO order.
+*/
+template <typename T>
+class CMPSCQueue {
+  public:
+    CMPSCQueue() = default;
+    CMPSCQueue(const CMPSCQueue&) = delete;
+    CMPSCQueue& operator=(const CMPSCQueue&) = delete;
+
+    ~CMPSCQueue() {
+        freeList(m_pHead.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    // safe to call from any thread
+    void push(T&& data) {
+        const auto NODE = new SNode{std::move(data), m_pHead.load(std::memory_order_relaxed)};
+
+        while (!m_pHead.compare_exchange_weak(NODE->next, NODE, std::memory_order_release, std::memory_order_relaxed)) {
+            ;
+        }
+    }
+
+    // consumer only. Appends all queued elements, oldest first, to out.
+    // Returns the amount of elements taken.
+    size_t popAll(std::vector<T>& out) {
+        SNode* head = m_pHead.exchange(nullptr, std::memory_order_acquire);
+
+        if (!head)
+            return 0;
+
+        // reverse into FIFO order
+        SNode* reversed = nullptr;
+        size_t count    = 0;
+        while (head) {
+            const auto NEXT = head->next;
+            head->next      = reversed;
+            reversed        = head;
+            head            = NEXT;
+            count++;
+        }
+
+        out.reserve(out.size() + count);
+
+        while (reversed) {
+            const auto NEXT = reversed->next;
+            out.emplace_back(std::move(reversed->data));
+            delete reversed;
+            reversed = NEXT;
+        }
+
+        return count;
+    }
+
+    // consumer only. Hands all queued elements to fn, oldest first, without allocating or freeing anything.
+    // The nodes are leaked, this is meant for crash handlers, where nothing else is safe.
+    template <typename F>
+    size_t drainWithoutFreeing(F&& fn) {
+        SNode* head = m_pHead.exchange(nullptr, std::memory_order_acquire);
+
+        SNode* reversed = nullptr;
+        size_t count    = 0;
+        while (head) {
+            const auto NEXT = head->next;
+            head->next      = reversed;
+            reversed        = head;
+            head            = NEXT;
+            count++;
+        }
+
+        for (; reversed; reversed = reversed->next) {
+            fn(reversed->data);
+        }
+
+        return count;
+    }
+
+    bool empty() const {
+        return m_pHead.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    struct SNode {
+        T      data;
+        SNode* next = nullptr;
+    };
+
+    void freeList(SNode* node) {
+        while (node) {
+            const auto NEXT = node->next;
+            delete node;
+            node = NEXT;
+        }
+    }
+
+    std::atomic<SNode*> m_pHead = nullptr;
+};
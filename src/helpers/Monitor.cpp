@@ -5,7 +5,12 @@
 #include "../protocols/GammaControl.hpp"
 
 int ratHandler(void* data) {
-    g_pHyprRenderer->renderMonitor((CMonitor*)data);
+    const auto PMONITOR = (CMonitor*)data;
+
+    g_pHyprRenderer->renderMonitor(PMONITOR);
+
+    // nothing was committed (e.g. no damage), so there was nothing to be late with either
+    PMONITOR->frameTiming.onPredictedRenderDone();
 
     return 1;
 }
@@ -137,6 +142,8 @@ void CMonitor::onConnect(bool noRule) {
     if (std::find_if(g_pCompositor->m_vMonitors.begin(), g_pCompositor->m_vMonitors.end(), [&](auto& other) { return other.get() == this; }) == g_pCompositor->m_vMonitors.end())
         g_pCompositor->m_vMonitors.push_back(*thisWrapper);
 
+    g_pCompositor->invalidateMonitorIndex();
+
     m_bEnabled = true;
 
     wlr_output_state_set_enabled(state.wlr(), 1);
@@ -311,6 +318,7 @@ void CMonitor::onDisconnect(bool destroy) {
     if (activeWorkspace)
         activeWorkspace->m_bVisible = false;
     activeWorkspace.reset();
+    g_pCompositor->invalidateWindowIndex();
 
     if (!destroy)
         wlr_output_layout_remove(g_pCompositor->m_sWLROutputLayout, output);
@@ -337,6 +345,7 @@ void CMonitor::onDisconnect(bool destroy) {
         g_pHyprRenderer->m_pMostHzMonitor = pMonitorMostHz;
     }
     std::erase_if(g_pCompositor->m_vMonitors, [&](std::shared_ptr<CMonitor>& el) { return el.get() == this; });
+    g_pCompositor->invalidateMonitorIndex();
 }
 
 void CMonitor::addDamage(const pixman_region32_t* rg) {
@@ -422,6 +431,7 @@ void CMonitor::setupDefaultWS(const SMonitorRule& monitorRule) {
             newDefaultWorkspaceName = std::to_string(WORKSPACEID);
 
         PNEWWORKSPACE = g_pCompositor->m_vWorkspaces.emplace_back(CWorkspace::create(WORKSPACEID, ID, newDefaultWorkspaceName));
+        g_pCompositor->invalidateWorkspaceIndex();
     }
 
     activeWorkspace = PNEWWORKSPACE;
@@ -429,6 +439,7 @@ void CMonitor::setupDefaultWS(const SMonitorRule& monitorRule) {
     PNEWWORKSPACE->setActive(true);
     PNEWWORKSPACE->m_bVisible      = true;
     PNEWWORKSPACE->m_szLastMonitor = "";
+    g_pCompositor->invalidateWindowIndex();
 }
 
 void CMonitor::setMirror(const std::string& mirrorOf) {
@@ -478,6 +489,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
         if (std::find_if(g_pCompositor->m_vMonitors.begin(), g_pCompositor->m_vMonitors.end(), [&](auto& other) { return other.get() == this; }) ==
             g_pCompositor->m_vMonitors.end()) {
             g_pCompositor->m_vMonitors.push_back(*thisWrapper);
+            g_pCompositor->invalidateMonitorIndex();
         }
 
         setupDefaultWS(RULE);
@@ -517,6 +529,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
 
         // remove from mvmonitors
         std::erase_if(g_pCompositor->m_vMonitors, [&](const auto& other) { return other.get() == this; });
+        g_pCompositor->invalidateMonitorIndex();
 
         g_pCompositor->arrangeMonitors();
 
@@ -564,6 +577,7 @@ void CMonitor::changeWorkspace(const PHLWORKSPACE& pWorkspace, bool internal, bo
     pWorkspace->m_bVisible    = true;
 
     activeWorkspace = pWorkspace;
+    g_pCompositor->invalidateWindowIndex();
 
     if (!internal) {
         const auto ANIMTOLEFT = pWorkspace->m_iID > POLDWORKSPACE->m_iID;
@@ -629,6 +643,7 @@ void CMonitor::setSpecialWorkspace(const PHLWORKSPACE& pWorkspace) {
         if (activeSpecialWorkspace) {
             activeSpecialWorkspace->m_bVisible = false;
             activeSpecialWorkspace->startAnim(false, false);
+            g_pCompositor->invalidateWindowIndex();
             g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", "," + szName});
         }
         activeSpecialWorkspace.reset();
@@ -674,6 +689,7 @@ void CMonitor::setSpecialWorkspace(const PHLWORKSPACE& pWorkspace) {
     pWorkspace->m_iMonitorID           = ID;
     activeSpecialWorkspace             = pWorkspace;
     activeSpecialWorkspace->m_bVisible = true;
+    g_pCompositor->invalidateWindowIndex();
     if (animate)
         pWorkspace->startAnim(true, true);
 
@@ -8,6 +8,7 @@
 #include <memory>
 #include <xf86drmMode.h>
 #include "Timer.hpp"
+#include "FrameTiming.hpp"
 #include "Region.hpp"
 #include <optional>
 #include "signal/Signal.hpp"
@@ -110,6 +111,7 @@ class CMonitor {
     wl_event_source*        renderTimer  = nullptr; // for RAT
     bool                    RATScheduled = false;
     CTimer                  lastPresentationTimer;
+    CFrameTimingModel       frameTiming;
 
     SMonitorRule            activeMonitorRule;
 
@@ -129,6 +131,12 @@ class CMonitor {
         bool frameScheduledWhileBusy = false;
     } tearingState;
 
+    // what changed in the frame the renderer is committing, in buffer coordinates. Unknown for commits done elsewhere.
+    struct {
+        CRegion region;
+        bool    known = false;
+    } commitDamage;
+
     struct {
         CSignal destroy;
         CSignal connect;
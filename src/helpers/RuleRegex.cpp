@@ -0,0 +1,127 @@
+#include "RuleRegex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+static bool isRegexSpecial(char c) {
+    return std::string_view{".[]{}()*+?^$|\\"}.find(c) != std::string_view::npos;
+}
+
+CRuleRegex::CRuleRegex(const std::string& pattern) : m_szPattern(pattern) {
+    if (parseLiterals())
+        return;
+
+    m_eMode = MATCH_REGEX;
+    m_vLiterals.clear();
+
+    try {
+        m_rRegex = std::regex(pattern, std::regex::ECMAScript | std::regex::optimize);
+    } catch (std::regex_error& e) { m_szError = e.what(); }
+}
+
+bool CRuleRegex::parseLiterals() {
+    std::string_view pattern     = m_szPattern;
+    bool             anchorStart = false;
+    bool             anchorEnd   = false;
+
+    if (pattern.starts_with('^')) {
+        anchorStart = true;
+        pattern.remove_prefix(1);
+    }
+
+    // a trailing $ is an anchor, unless it's escaped
+    if (pattern.ends_with('$')) {
+        size_t backslashes = 0;
+        for (size_t i = pattern.size() - 1; i > 0 && pattern[i - 1] == '\\'; --i) {
+            backslashes++;
+        }
+
+        if (backslashes % 2 == 0) {
+            anchorEnd = true;
+            pattern.remove_suffix(1);
+        }
+    }
+
+    // one group around everything, e.g. ^(firefox)$. Anything else using parentheses is left to the regex engine.
+    bool grouped = false;
+    if (pattern.size() >= 2 && pattern.front() == '(' && pattern.back() == ')') {
+        grouped = true;
+        pattern = pattern.substr(1, pattern.size() - 2);
+    }
+
+    std::vector<std::string> literals;
+    std::string              current;
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+
+        if (c == '\\') {
+            // only escaped punctuation is a literal, \d, \w and friends are not
+            if (i + 1 >= pattern.size() || std::isalnum((unsigned char)pattern[i + 1]))
+                return false;
+
+            current += pattern[++i];
+            continue;
+        }
+
+        if (c == '|') {
+            // ^a|b$ means (^a)|(b$), don't bother
+            if (!grouped && (anchorStart || anchorEnd))
+                return false;
+
+            literals.emplace_back(std::move(current));
+            current.clear();
+            continue;
+        }
+
+        if (isRegexSpecial(c))
+            return false;
+
+        current += c;
+    }
+
+    literals.emplace_back(std::move(current));
+
+    if (anchorStart && anchorEnd)
+        m_eMode = MATCH_EXACT;
+    else if (anchorStart)
+        m_eMode = MATCH_PREFIX;
+    else if (anchorEnd)
+        m_eMode = MATCH_SUFFIX;
+    else
+        m_eMode = MATCH_CONTAINS;
+
+    m_vLiterals = std::move(literals);
+
+    return true;
+}
+
+bool CRuleRegex::passes(const std::string& str) const {
+    switch (m_eMode) {
+        case MATCH_REGEX: return m_rRegex && std::regex_search(str, *m_rRegex);
+        case MATCH_CONTAINS: return std::ranges::any_of(m_vLiterals, [&](const auto& l) { return str.contains(l); });
+        case MATCH_PREFIX: return std::ranges::any_of(m_vLiterals, [&](const auto& l) { return str.starts_with(l); });
+        case MATCH_SUFFIX: return std::ranges::any_of(m_vLiterals, [&](const auto& l) { return str.ends_with(l); });
+        case MATCH_EXACT: return std::ranges::any_of(m_vLiterals, [&](const auto& l) { return str == l; });
+        default: break;
+    }
+
+    return false;
+}
+
+const std::vector<std::string>* CRuleRegex::getExactLiterals() const {
+    return m_eMode == MATCH_EXACT ? &m_vLiterals : nullptr;
+}
+
+bool CRuleRegex::isValid() const {
+    return m_szError.empty();
+}
+
+const std::string& CRuleRegex::getError() const {
+    return m_szError;
+}
+
+const std::string& CRuleRegex::getPattern() const {
+    return m_szPattern;
+}
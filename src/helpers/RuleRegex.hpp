@@ -0,0 +1,44 @@
+#pragma once
+
+#include <regex>
+#include <string>
+#include <vector>
+#include <optional>
+
+/*
+    A rule pattern compiled once at config parse time.
+    Matches like std::regex_search, but patterns made of plain literals,
+    e.g. "kitty", "^(firefox)$", "^(foot|kitty)$" or "^steam_app_",
+    are matched with string comparisons instead of the regex engine.
+*/
+class CRuleRegex {
+  public:
+    CRuleRegex(const std::string& pattern);
+
+    bool                            passes(const std::string& str) const;
+
+    // literals this pattern matches exactly (e.g. ^(foot|kitty)$), nullptr if it can match anything else
+    const std::vector<std::string>* getExactLiterals() const;
+
+    bool                            isValid() const;
+    const std::string&              getError() const;
+    const std::string&              getPattern() const;
+
+  private:
+    enum eMatchMode {
+        MATCH_REGEX = 0,
+        MATCH_CONTAINS,
+        MATCH_PREFIX,
+        MATCH_SUFFIX,
+        MATCH_EXACT,
+    };
+
+    bool                      parseLiterals();
+
+    std::string               m_szPattern;
+    std::string               m_szError;
+
+    eMatchMode                m_eMode = MATCH_REGEX;
+    std::vector<std::string>  m_vLiterals;
+    std::optional<std::regex> m_rRegex;
+};
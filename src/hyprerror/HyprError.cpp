@@ -34,7 +34,7 @@ void CHyprError::queueCreate(std::string message, const CColor& color) {
 
 void CHyprError::createQueued() {
     if (m_bIsCreated) {
-        m_tTexture.destroyTexture();
+        m_tOverlay.destroy();
     }
 
     m_fFadeOpacity.setConfig(g_pConfigManager->getAnimationPropertyConfig("fadeIn"));
@@ -48,16 +48,6 @@ void CHyprError::createQueued() {
 
     const auto FONTSIZE = std::clamp((int)(10.f * ((PMONITOR->vecPixelSize.x * SCALE) / 1920.f)), 8, 40);
 
-    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
-
-    const auto CAIRO = cairo_create(CAIROSURFACE);
-
-    // clear the pixmap
-    cairo_save(CAIRO);
-    cairo_set_operator(CAIRO, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(CAIRO);
-    cairo_restore(CAIRO);
-
     const auto   LINECOUNT = Hyprlang::INT{1} + std::count(m_szQueued.begin(), m_szQueued.end(), '\n');
     static auto  LINELIMIT = CConfigValue<Hyprlang::INT>("debug:error_limit");
 
@@ -76,6 +66,12 @@ void CHyprError::createQueued() {
 
     m_bDamageBox = {0, 0, (int)PMONITOR->vecPixelSize.x, (int)HEIGHT + (int)PAD * 2};
 
+    // only as big as the box, not the whole monitor
+    if (!m_tOverlay.resize({PMONITOR->vecPixelSize.x, HEIGHT + PAD * 2}))
+        m_tOverlay.clear({{0, 0}, m_tOverlay.m_vSize});
+
+    const auto CAIRO = m_tOverlay.cairo();
+
     cairo_new_sub_path(CAIRO);
     cairo_arc(CAIRO, X + WIDTH - RADIUS, Y + RADIUS, RADIUS, -90 * DEGREES, 0 * DEGREES);
     cairo_arc(CAIRO, X + WIDTH - RADIUS, Y + HEIGHT - RADIUS, RADIUS, 0 * DEGREES, 90 * DEGREES);
@@ -116,25 +112,7 @@ void CHyprError::createQueued() {
     }
     m_szQueued = "";
 
-    cairo_surface_flush(CAIROSURFACE);
-
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    m_tTexture.allocate();
-    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    // delete cairo
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
+    m_tOverlay.upload();
 
     m_bIsCreated = true;
     m_szQueued   = "";
@@ -154,7 +132,7 @@ void CHyprError::draw() {
         if (!m_fFadeOpacity.isBeingAnimated()) {
             if (m_fFadeOpacity.value() == 0.f) {
                 m_bQueuedDestroy = false;
-                m_tTexture.destroyTexture();
+                m_tOverlay.destroy();
                 m_bIsCreated = false;
                 m_szQueued   = "";
                 return;
@@ -167,7 +145,7 @@ void CHyprError::draw() {
 
     const auto PMONITOR = g_pHyprOpenGL->m_RenderData.pMonitor;
 
-    CBox       monbox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
+    CBox       monbox = {{0, 0}, m_tOverlay.m_vSize};
 
     m_bDamageBox.x = (int)PMONITOR->vecPosition.x;
     m_bDamageBox.y = (int)PMONITOR->vecPosition.y;
@@ -177,7 +155,7 @@ void CHyprError::draw() {
 
     m_bMonitorChanged = false;
 
-    g_pHyprOpenGL->renderTexture(m_tTexture, &monbox, m_fFadeOpacity.value(), 0);
+    g_pHyprOpenGL->renderTexture(m_tOverlay.m_tTexture, &monbox, m_fFadeOpacity.value(), 0);
 }
 
 void CHyprError::destroy() {
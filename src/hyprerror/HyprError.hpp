@@ -1,11 +1,9 @@
 #pragma once
 
 #include "../defines.hpp"
-#include "../render/Texture.hpp"
+#include "../render/OverlayTexture.hpp"
 #include "../helpers/AnimatedVariable.hpp"
 
-#include <cairo/cairo.h>
-
 class CHyprError {
   public:
     CHyprError();
@@ -21,7 +19,7 @@ class CHyprError {
     CColor                   m_cQueued;
     bool                     m_bQueuedDestroy = false;
     bool                     m_bIsCreated     = false;
-    CTexture                 m_tTexture;
+    COverlayTexture          m_tOverlay;
     CAnimatedVariable<float> m_fFadeOpacity;
     CBox                     m_bDamageBox = {0, 0, 0, 0};
 
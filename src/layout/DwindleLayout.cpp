@@ -971,7 +971,10 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_iMonitorID, pWindow->m_iMonitorID);
-        std::swap(pWindow2->m_pWorkspace, pWindow->m_pWorkspace);
+
+        const auto PWORKSPACE = pWindow->m_pWorkspace;
+        pWindow->setWorkspace(pWindow2->m_pWorkspace);
+        pWindow2->setWorkspace(PWORKSPACE);
     }
 
     pWindow->setAnimationsToMove();
@@ -468,7 +468,7 @@ void IHyprLayout::changeWindowFloatingMode(PHLWINDOW pWindow) {
         g_pCompositor->setWindowFullscreen(pWindow, false, FULLSCREEN_FULL);
     }
 
-    pWindow->m_bPinned = false;
+    pWindow->setPinned(false);
 
     const auto TILED = isWindowTiled(pWindow);
 
@@ -24,36 +24,72 @@ int wlTick(std::shared_ptr<CEventLoopTimer> self, void* data) {
 }
 
 CAnimationManager::CAnimationManager() {
-    std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
-    m_mBezierCurves["default"].setup(&points);
+    removeAllBeziers();
 
     m_pAnimationTimer = std::make_unique<CEventLoopTimer>(std::chrono::microseconds(500), wlTick, nullptr);
     g_pEventLoopManager->addTimer(m_pAnimationTimer);
 }
 
 void CAnimationManager::removeAllBeziers() {
-    m_mBezierCurves.clear();
+    m_vBezierCurves.clear();
+    m_mBezierIndices.clear();
 
-    // add the default one
-    std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
-    m_mBezierCurves["default"].setup(&points);
+    // add the default one, always at index 0
+    addBezierWithName("default", Vector2D(0, 0.75f), Vector2D(0.15f, 1.f));
 }
 
 void CAnimationManager::addBezierWithName(std::string name, const Vector2D& p1, const Vector2D& p2) {
     std::vector points = {p1, p2};
-    m_mBezierCurves[name].setup(&points);
+
+    const auto IT = m_mBezierIndices.find(name);
+    if (IT != m_mBezierIndices.end()) {
+        m_vBezierCurves[IT->second].setup(&points);
+        return;
+    }
+
+    m_mBezierIndices[name] = m_vBezierCurves.size();
+    m_vBezierCurves.emplace_back().setup(&points);
 }
 
 void CAnimationManager::onTicked() {
     m_bTickScheduled = false;
 }
 
+std::vector<CBaseAnimatedVariable*>& CAnimationManager::getActiveLane(ANIMATEDVARTYPE type) {
+    switch (type) {
+        case AVARTYPE_FLOAT: return m_sActiveAnimatedVariables.floats;
+        case AVARTYPE_VECTOR: return m_sActiveAnimatedVariables.vectors;
+        case AVARTYPE_COLOR: return m_sActiveAnimatedVariables.colors;
+        default: break;
+    }
+
+    UNREACHABLE();
+    return m_sActiveAnimatedVariables.floats;
+}
+
+void CAnimationManager::addActiveVariable(CBaseAnimatedVariable* av) {
+    auto& lane         = getActiveLane(av->m_Type);
+    av->m_iActiveIndex = lane.size();
+    lane.push_back(av);
+}
+
+void CAnimationManager::removeActiveVariable(CBaseAnimatedVariable* av) {
+    auto& lane = getActiveLane(av->m_Type);
+
+    RASSERT(av->m_iActiveIndex < lane.size() && lane[av->m_iActiveIndex] == av, "Active animated variable index out of sync");
+
+    // swap with the last one, order in the lanes doesn't matter
+    lane[av->m_iActiveIndex]                 = lane.back();
+    lane[av->m_iActiveIndex]->m_iActiveIndex = av->m_iActiveIndex;
+    lane.pop_back();
+}
+
 void CAnimationManager::tick() {
     static std::chrono::time_point lastTick = std::chrono::high_resolution_clock::now();
     m_fLastTickTime                         = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - lastTick).count() / 1000.0;
     lastTick                                = std::chrono::high_resolution_clock::now();
 
-    if (m_vActiveAnimatedVariables.empty())
+    if (!shouldTickForNext())
         return;
 
     bool        animGlobalDisabled = false;
@@ -63,208 +99,267 @@ void CAnimationManager::tick() {
     if (!*PANIMENABLED)
         animGlobalDisabled = true;
 
-    static auto* const                  PSHADOWSENABLED = (Hyprlang::INT* const*)g_pConfigManager->getConfigValuePtr("decoration:drop_shadow");
+    const auto NOW = std::chrono::system_clock::now();
 
-    const auto                          DEFAULTBEZIER = m_mBezierCurves.find("default");
+    m_vTickData.clear();
+    m_vTickEndedVars.clear();
+    m_vTickPreDamagedWorkspaces.clear();
+    m_vTickUpdatedWorkspaces.clear();
 
-    std::vector<CBaseAnimatedVariable*> animationEndedVars;
+    // phase 1: resolve owners and monitors, damage the old state. Lanes are kept contiguous in m_vTickData.
+    size_t laneBegin[3], laneEnd[3];
+    size_t lane = 0;
+    for (auto* vars : {&m_sActiveAnimatedVariables.floats, &m_sActiveAnimatedVariables.vectors, &m_sActiveAnimatedVariables.colors}) {
+        laneBegin[lane] = m_vTickData.size();
 
-    for (auto& av : m_vActiveAnimatedVariables) {
-
-        if (av->m_eDamagePolicy == AVARDAMAGE_SHADOW && !*PSHADOWSENABLED) {
-            av->warp(false);
-            animationEndedVars.push_back(av);
-            continue;
+        // index-based, prepareVariable may run update callbacks
+        const size_t COUNT = vars->size();
+        for (size_t i = 0; i < COUNT && i < vars->size(); ++i) {
+            prepareVariable(vars->at(i), NOW, animGlobalDisabled);
         }
 
-        // get the spent % (0 - 1)
-        const float SPENT = av->getPercent();
+        laneEnd[lane++] = m_vTickData.size();
+    }
 
-        // window stuff
-        PHLWINDOW    PWINDOW            = av->m_pWindow.lock();
-        PHLWORKSPACE PWORKSPACE         = av->m_pWorkspace.lock();
-        PHLLS        PLAYER             = av->m_pLayer.lock();
-        CMonitor*    PMONITOR           = nullptr;
-        bool         animationsDisabled = animGlobalDisabled;
+    // phase 2: step the values, one type at a time
+    updateVariables<float>(laneBegin[0], laneEnd[0]);
+    updateVariables<Vector2D>(laneBegin[1], laneEnd[1]);
+    updateVariables<CColor>(laneBegin[2], laneEnd[2]);
 
-        if (PWINDOW) {
-            if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE) {
-                g_pHyprRenderer->damageWindow(PWINDOW);
-            } else if (av->m_eDamagePolicy == AVARDAMAGE_BORDER) {
-                const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
-                PDECO->damageEntire();
-            } else if (av->m_eDamagePolicy == AVARDAMAGE_SHADOW) {
-                const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
-                PDECO->damageEntire();
-            }
+    // phase 3: callbacks and damage of the new state
+    for (auto& data : m_vTickData) {
+        finishVariable(data);
+    }
 
-            PMONITOR = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
-            if (!PMONITOR)
-                continue;
-            animationsDisabled = animationsDisabled || PWINDOW->m_sAdditionalConfigData.forceNoAnims;
-        } else if (PWORKSPACE) {
-            PMONITOR = g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
-            if (!PMONITOR)
-                continue;
-
-            // dont damage the whole monitor on workspace change, unless it's a special workspace, because dim/blur etc
-            if (PWORKSPACE->m_bIsSpecialWorkspace)
-                g_pHyprRenderer->damageMonitor(PMONITOR);
-
-            // TODO: just make this into a damn callback already vax...
-            for (auto& w : g_pCompositor->m_vWindows) {
-                if (!w->m_bIsMapped || w->isHidden() || w->m_pWorkspace != PWORKSPACE)
-                    continue;
-
-                if (w->m_bIsFloating && !w->m_bPinned) {
-                    // still doing the full damage hack for floating because sometimes when the window
-                    // goes through multiple monitors the last rendered frame is missing damage somehow??
-                    const CBox windowBoxNoOffset = w->getFullWindowBoundingBox();
-                    const CBox monitorBox        = {PMONITOR->vecPosition, PMONITOR->vecSize};
-                    if (windowBoxNoOffset.intersection(monitorBox) != windowBoxNoOffset) // on edges between multiple monitors
-                        g_pHyprRenderer->damageWindow(w, true);
-                }
+    for (auto& ws : m_vTickUpdatedWorkspaces) {
+        updateWorkspace(ws);
+    }
 
-                if (PWORKSPACE->m_bIsSpecialWorkspace)
-                    g_pHyprRenderer->damageWindow(w, true); // hack for special too because it can cross multiple monitors
-            }
+    // do it here, because if this alters the active lanes we would be in trouble above.
+    for (auto& ave : m_vTickEndedVars) {
+        ave->onAnimationEnd();
+    }
 
-            // damage any workspace window that is on any monitor
-            for (auto& w : g_pCompositor->m_vWindows) {
-                if (!validMapped(w) || w->m_pWorkspace != PWORKSPACE || w->m_bPinned)
-                    continue;
+    // don't hold the owners until the next tick
+    m_vTickData.clear();
+    m_vTickPreDamagedWorkspaces.clear();
+    m_vTickUpdatedWorkspaces.clear();
+}
 
-                g_pHyprRenderer->damageWindow(w);
-            }
-        } else if (PLAYER) {
-            // "some fucking layers miss 1 pixel???" -- vaxry
-            CBox expandBox = CBox{PLAYER->realPosition.value(), PLAYER->realSize.value()};
-            expandBox.expand(5);
-            g_pHyprRenderer->damageBox(&expandBox);
-
-            PMONITOR = g_pCompositor->getMonitorFromVector(PLAYER->realPosition.goal() + PLAYER->realSize.goal() / 2.F);
-            if (!PMONITOR)
-                continue;
-            animationsDisabled = animationsDisabled || PLAYER->noAnimations;
+void CAnimationManager::prepareVariable(CBaseAnimatedVariable* av, const std::chrono::system_clock::time_point& now, bool animGlobalDisabled) {
+    static auto* const PSHADOWSENABLED = (Hyprlang::INT* const*)g_pConfigManager->getConfigValuePtr("decoration:drop_shadow");
+
+    if (av->m_eDamagePolicy == AVARDAMAGE_SHADOW && !*PSHADOWSENABLED) {
+        av->warp(false);
+        m_vTickEndedVars.push_back(av);
+        return;
+    }
+
+    SAnimationTickData data;
+    data.av                 = av;
+    data.animationsDisabled = animGlobalDisabled;
+
+    // get the spent % (0 - 1)
+    data.spent = av->getPercent(now);
+
+    // only one of these is set, don't lock the ones that aren't
+    if ((data.window = av->m_pWindow.lock())) {
+        const auto PWINDOW = data.window;
+
+        if (av->m_eDamagePolicy == AVARDAMAGE_ENTIRE) {
+            g_pHyprRenderer->damageWindow(PWINDOW);
+        } else if (av->m_eDamagePolicy == AVARDAMAGE_BORDER) {
+            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
+            PDECO->damageEntire();
+        } else if (av->m_eDamagePolicy == AVARDAMAGE_SHADOW) {
+            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
+            PDECO->damageEntire();
         }
 
-        const bool VISIBLE = PWINDOW && PWINDOW->m_pWorkspace ? g_pCompositor->isWorkspaceVisible(PWINDOW->m_pWorkspace) : true;
+        data.monitor = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
+        if (!data.monitor)
+            return;
+        data.animationsDisabled = data.animationsDisabled || PWINDOW->m_sAdditionalConfigData.forceNoAnims;
+        data.visible            = PWINDOW->m_pWorkspace ? g_pCompositor->isWorkspaceVisible(PWINDOW->m_pWorkspace) : true;
+    } else if ((data.workspace = av->m_pWorkspace.lock())) {
+        const auto PWORKSPACE = data.workspace;
+
+        data.monitor = g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
+        if (!data.monitor)
+            return;
+
+        if (std::ranges::find(m_vTickPreDamagedWorkspaces, PWORKSPACE) == m_vTickPreDamagedWorkspaces.end()) {
+            m_vTickPreDamagedWorkspaces.emplace_back(PWORKSPACE);
+            preDamageWorkspace(PWORKSPACE, data.monitor);
+        }
+    } else if ((data.layer = av->m_pLayer.lock())) {
+        const auto PLAYER = data.layer;
+
+        // "some fucking layers miss 1 pixel???" -- vaxry
+        CBox expandBox = CBox{PLAYER->realPosition.value(), PLAYER->realSize.value()};
+        expandBox.expand(5);
+        g_pHyprRenderer->damageBox(&expandBox);
+
+        data.monitor = g_pCompositor->getMonitorFromVector(PLAYER->realPosition.goal() + PLAYER->realSize.goal() / 2.F);
+        if (!data.monitor)
+            return;
+        data.animationsDisabled = data.animationsDisabled || PLAYER->noAnimations;
+    }
 
-        // beziers are with a switch unforto
-        // TODO: maybe do something cleaner
+    m_vTickData.emplace_back(std::move(data));
+}
 
-        auto updateVariable = [&]<Animable T>(CAnimatedVariable<T>& av) {
-            // for disabled anims just warp
-            if (av.m_pConfig->pValues->internalEnabled == 0 || animationsDisabled) {
-                av.warp(false);
-                return;
-            }
+void CAnimationManager::preDamageWorkspace(PHLWORKSPACE pWorkspace, CMonitor* pMonitor) {
+    // dont damage the whole monitor on workspace change, unless it's a special workspace, because dim/blur etc
+    if (pWorkspace->m_bIsSpecialWorkspace)
+        g_pHyprRenderer->damageMonitor(pMonitor);
 
-            if (SPENT >= 1.f || av.m_Begun == av.m_Goal) {
-                av.warp(false);
-                return;
-            }
+    std::vector<PHLWINDOW> forceDamage;
+    std::vector<PHLWINDOW> damage;
 
-            const auto DELTA  = av.m_Goal - av.m_Begun;
-            const auto BEZIER = m_mBezierCurves.find(av.m_pConfig->pValues->internalBezier);
+    // copied, the index may be invalidated and rebuilt while we iterate
+    for (auto& ref : std::vector<PHLWINDOWREF>{g_pCompositor->getWindowsOnWorkspaceID(pWorkspace->m_iID)}) {
+        const auto w = ref.lock();
 
-            if (BEZIER != m_mBezierCurves.end())
-                av.m_Value = av.m_Begun + DELTA * BEZIER->second.getYForPoint(SPENT);
-            else
-                av.m_Value = av.m_Begun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
-        };
+        if (!validMapped(w) || w->m_pWorkspace != pWorkspace)
+            continue;
 
-        switch (av->m_Type) {
-            case AVARTYPE_FLOAT: {
-                auto typedAv = static_cast<CAnimatedVariable<float>*>(av);
-                updateVariable(*typedAv);
-                break;
+        // TODO: just make this into a damn callback already vax...
+        if (!w->isHidden()) {
+            if (w->m_bIsFloating && !w->m_bPinned) {
+                // still doing the full damage hack for floating because sometimes when the window
+                // goes through multiple monitors the last rendered frame is missing damage somehow??
+                const CBox windowBoxNoOffset = w->getFullWindowBoundingBox();
+                const CBox monitorBox        = {pMonitor->vecPosition, pMonitor->vecSize};
+                if (windowBoxNoOffset.intersection(monitorBox) != windowBoxNoOffset) // on edges between multiple monitors
+                    forceDamage.emplace_back(w);
             }
-            case AVARTYPE_VECTOR: {
-                auto typedAv = static_cast<CAnimatedVariable<Vector2D>*>(av);
-                updateVariable(*typedAv);
-                break;
-            }
-            case AVARTYPE_COLOR: {
-                auto typedAv = static_cast<CAnimatedVariable<CColor>*>(av);
-                updateVariable(*typedAv);
-                break;
-            }
-            default: UNREACHABLE();
+
+            if (pWorkspace->m_bIsSpecialWorkspace)
+                forceDamage.emplace_back(w); // hack for special too because it can cross multiple monitors
         }
-        // set size and pos if valid, but only if damage policy entire (dont if border for example)
-        if (validMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE && PWINDOW->m_iX11Type != 2)
-            g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.goal());
 
-        // check if we did not finish animating. If so, trigger onAnimationEnd.
-        if (!av->isBeingAnimated())
-            animationEndedVars.push_back(av);
+        // damage any workspace window that is on any monitor
+        if (!w->m_bPinned)
+            damage.emplace_back(w);
+    }
 
-        // lastly, handle damage, but only if whatever we are animating is visible.
-        if (!VISIBLE)
+    g_pHyprRenderer->damageWindows(forceDamage, true);
+    g_pHyprRenderer->damageWindows(damage);
+}
+
+void CAnimationManager::updateWorkspace(PHLWORKSPACE pWorkspace) {
+    std::vector<PHLWINDOW> damage;
+
+    for (auto& ref : std::vector<PHLWINDOWREF>{g_pCompositor->getWindowsOnWorkspaceID(pWorkspace->m_iID)}) {
+        const auto w = ref.lock();
+
+        if (!validMapped(w) || w->m_pWorkspace != pWorkspace)
             continue;
 
-        if (av->m_fUpdateCallback)
-            av->m_fUpdateCallback(av);
-
-        switch (av->m_eDamagePolicy) {
-            case AVARDAMAGE_ENTIRE: {
-                if (PWINDOW) {
-                    PWINDOW->updateWindowDecos();
-                    g_pHyprRenderer->damageWindow(PWINDOW);
-                } else if (PWORKSPACE) {
-                    for (auto& w : g_pCompositor->m_vWindows) {
-                        if (!validMapped(w) || w->m_pWorkspace != PWORKSPACE)
-                            continue;
-
-                        w->updateWindowDecos();
-
-                        // damage any workspace window that is on any monitor
-                        if (!w->m_bPinned)
-                            g_pHyprRenderer->damageWindow(w);
-                    }
-                } else if (PLAYER) {
-                    if (PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
-                        g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
-
-                    // some fucking layers miss 1 pixel???
-                    CBox expandBox = CBox{PLAYER->realPosition.value(), PLAYER->realSize.value()};
-                    expandBox.expand(5);
-                    g_pHyprRenderer->damageBox(&expandBox);
-                }
-                break;
-            }
-            case AVARDAMAGE_BORDER: {
-                RASSERT(PWINDOW, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
+        w->updateWindowDecos();
 
-                const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
-                PDECO->damageEntire();
+        // damage any workspace window that is on any monitor
+        if (!w->m_bPinned)
+            damage.emplace_back(w);
+    }
 
-                break;
-            }
-            case AVARDAMAGE_SHADOW: {
-                RASSERT(PWINDOW, "Tried to AVARDAMAGE_SHADOW a non-window AVAR!");
+    g_pHyprRenderer->damageWindows(damage);
+}
 
-                const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
+template <Animable VarType>
+void CAnimationManager::updateVariables(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const auto& DATA = m_vTickData[i];
+        auto&       av   = *static_cast<CAnimatedVariable<VarType>*>(DATA.av);
 
-                PDECO->damageEntire();
+        // for disabled anims just warp
+        if (av.m_pConfig->pValues->internalEnabled == 0 || DATA.animationsDisabled) {
+            av.warp(false);
+            continue;
+        }
 
-                break;
-            }
-            default: {
-                break;
-            }
+        if (DATA.spent >= 1.f || av.m_Begun == av.m_Goal) {
+            av.warp(false);
+            continue;
         }
 
-        // manually schedule a frame
-        if (PMONITOR)
-            g_pCompositor->scheduleFrameForMonitor(PMONITOR);
+        // an index from before the beziers were last rebuilt falls back to the default curve, like getBezier
+        const auto  BEZIERINDEX = av.m_pConfig->pValues->internalBezierIndex;
+        auto&       BEZIER      = BEZIERINDEX < m_vBezierCurves.size() ? m_vBezierCurves[BEZIERINDEX] : m_vBezierCurves[0];
+
+        const auto  DELTA = av.m_Goal - av.m_Begun;
+        av.m_Value        = av.m_Begun + DELTA * BEZIER.getYForPoint(DATA.spent);
     }
+}
 
-    // do it here, because if this alters the animation vars deque we would be in trouble above.
-    for (auto& ave : animationEndedVars) {
-        ave->onAnimationEnd();
+void CAnimationManager::finishVariable(SAnimationTickData& data) {
+    const auto av         = data.av;
+    const auto PWINDOW    = data.window;
+    const auto PWORKSPACE = data.workspace;
+    const auto PLAYER     = data.layer;
+    const auto PMONITOR   = data.monitor;
+
+    // set size and pos if valid, but only if damage policy entire (dont if border for example)
+    if (validMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE && PWINDOW->m_iX11Type != 2)
+        g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.goal());
+
+    // check if we did not finish animating. If so, trigger onAnimationEnd.
+    if (!av->isBeingAnimated())
+        m_vTickEndedVars.push_back(av);
+
+    // lastly, handle damage, but only if whatever we are animating is visible.
+    if (!data.visible)
+        return;
+
+    if (av->m_fUpdateCallback)
+        av->m_fUpdateCallback(av);
+
+    switch (av->m_eDamagePolicy) {
+        case AVARDAMAGE_ENTIRE: {
+            if (PWINDOW) {
+                PWINDOW->updateWindowDecos();
+                g_pHyprRenderer->damageWindow(PWINDOW);
+            } else if (PWORKSPACE) {
+                // done once per workspace after all variables are stepped, see updateWorkspace
+                if (std::ranges::find(m_vTickUpdatedWorkspaces, PWORKSPACE) == m_vTickUpdatedWorkspaces.end())
+                    m_vTickUpdatedWorkspaces.emplace_back(PWORKSPACE);
+            } else if (PLAYER) {
+                if (PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+                    g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
+
+                // some fucking layers miss 1 pixel???
+                CBox expandBox = CBox{PLAYER->realPosition.value(), PLAYER->realSize.value()};
+                expandBox.expand(5);
+                g_pHyprRenderer->damageBox(&expandBox);
+            }
+            break;
+        }
+        case AVARDAMAGE_BORDER: {
+            RASSERT(PWINDOW, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
+
+            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
+            PDECO->damageEntire();
+
+            break;
+        }
+        case AVARDAMAGE_SHADOW: {
+            RASSERT(PWINDOW, "Tried to AVARDAMAGE_SHADOW a non-window AVAR!");
+
+            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
+
+            PDECO->damageEntire();
+
+            break;
+        }
+        default: {
+            break;
+        }
     }
+
+    // manually schedule a frame
+    if (PMONITOR)
+        g_pCompositor->scheduleFrameForMonitor(PMONITOR);
 }
 
 bool CAnimationManager::deltaSmallToFlip(const Vector2D& a, const Vector2D& b) {
@@ -292,12 +387,7 @@ bool CAnimationManager::deltazero(const CColor& a, const CColor& b) {
 }
 
 bool CAnimationManager::bezierExists(const std::string& bezier) {
-    for (auto& [bc, bz] : m_mBezierCurves) {
-        if (bc == bezier)
-            return true;
-    }
-
-    return false;
+    return m_mBezierIndices.contains(bezier);
 }
 
 //
@@ -525,17 +615,29 @@ std::string CAnimationManager::styleValidInConfigVar(const std::string& config,
 }
 
 CBezierCurve* CAnimationManager::getBezier(const std::string& name) {
-    const auto BEZIER = std::find_if(m_mBezierCurves.begin(), m_mBezierCurves.end(), [&](const auto& other) { return other.first == name; });
+    return &m_vBezierCurves[getBezierIndex(name)];
+}
+
+CBezierCurve* CAnimationManager::getBezier(size_t index) {
+    return index < m_vBezierCurves.size() ? &m_vBezierCurves[index] : &m_vBezierCurves[0];
+}
 
-    return BEZIER == m_mBezierCurves.end() ? &m_mBezierCurves["default"] : &BEZIER->second;
+size_t CAnimationManager::getBezierIndex(const std::string& name) {
+    const auto IT = m_mBezierIndices.find(name);
+    return IT == m_mBezierIndices.end() ? 0 : IT->second;
 }
 
 std::unordered_map<std::string, CBezierCurve> CAnimationManager::getAllBeziers() {
-    return m_mBezierCurves;
+    std::unordered_map<std::string, CBezierCurve> beziers;
+    for (auto& [name, index] : m_mBezierIndices) {
+        beziers[name] = m_vBezierCurves[index];
+    }
+
+    return beziers;
 }
 
 bool CAnimationManager::shouldTickForNext() {
-    return !m_vActiveAnimatedVariables.empty();
+    return !m_sActiveAnimatedVariables.floats.empty() || !m_sActiveAnimatedVariables.vectors.empty() || !m_sActiveAnimatedVariables.colors.empty();
 }
 
 void CAnimationManager::scheduleTick() {
@@ -9,6 +9,7 @@
 #include "eventLoop/EventLoopTimer.hpp"
 
 class CWindow;
+class CMonitor;
 
 class CAnimationManager {
   public:
@@ -25,13 +26,24 @@ class CAnimationManager {
 
     bool                                          bezierExists(const std::string&);
     CBezierCurve*                                 getBezier(const std::string&);
+    CBezierCurve*                                 getBezier(size_t index);
+    size_t                                        getBezierIndex(const std::string&); // 0 ("default") if it doesn't exist
 
     std::string                                   styleValidInConfigVar(const std::string&, const std::string&);
 
     std::unordered_map<std::string, CBezierCurve> getAllBeziers();
 
     std::vector<CBaseAnimatedVariable*>           m_vAnimatedVariables;
-    std::vector<CBaseAnimatedVariable*>           m_vActiveAnimatedVariables;
+
+    // active variables, split by type so that the tick never has to downcast per variable
+    struct {
+        std::vector<CBaseAnimatedVariable*> floats;
+        std::vector<CBaseAnimatedVariable*> vectors;
+        std::vector<CBaseAnimatedVariable*> colors;
+    } m_sActiveAnimatedVariables;
+
+    void                                          addActiveVariable(CBaseAnimatedVariable*);
+    void                                          removeActiveVariable(CBaseAnimatedVariable*);
 
     std::shared_ptr<CEventLoopTimer>              m_pAnimationTimer;
 
@@ -45,10 +57,39 @@ class CAnimationManager {
     bool                                          deltazero(const CColor& a, const CColor& b);
     bool                                          deltazero(const float& a, const float& b);
 
-    std::unordered_map<std::string, CBezierCurve> m_mBezierCurves;
+    // beziers are referred to by index, see SAnimationPropertyConfig::internalBezierIndex
+    std::vector<CBezierCurve>                     m_vBezierCurves;
+    std::unordered_map<std::string, size_t>       m_mBezierIndices;
 
     bool                                          m_bTickScheduled = false;
 
+    struct SAnimationTickData {
+        CBaseAnimatedVariable* av = nullptr;
+        PHLWINDOW              window;
+        PHLWORKSPACE           workspace;
+        PHLLS                  layer;
+        CMonitor*              monitor            = nullptr;
+        bool                   animationsDisabled = false;
+        bool                   visible            = true;
+        float                  spent              = 0.f;
+    };
+
+    // reused between ticks
+    std::vector<SAnimationTickData>               m_vTickData;
+    std::vector<CBaseAnimatedVariable*>           m_vTickEndedVars;
+
+    // workspaces with animating variables, damaged once per tick no matter how many of their variables animate
+    std::vector<PHLWORKSPACE>                     m_vTickPreDamagedWorkspaces;
+    std::vector<PHLWORKSPACE>                     m_vTickUpdatedWorkspaces;
+
+    std::vector<CBaseAnimatedVariable*>&          getActiveLane(ANIMATEDVARTYPE type);
+    void                                          prepareVariable(CBaseAnimatedVariable* av, const std::chrono::system_clock::time_point& now, bool animGlobalDisabled);
+    template <Animable VarType>
+    void                                          updateVariables(size_t begin, size_t end);
+    void                                          finishVariable(SAnimationTickData& data);
+    void                                          preDamageWorkspace(PHLWORKSPACE pWorkspace, CMonitor* pMonitor);
+    void                                          updateWorkspace(PHLWORKSPACE pWorkspace);
+
     // Anim stuff
     void animationPopin(PHLWINDOW, bool close = false, float minPerc = 0.f);
     void animationSlide(PHLWINDOW, std::string force = "", bool close = false);
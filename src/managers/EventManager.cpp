@@ -1,5 +1,7 @@
 #include "EventManager.hpp"
 #include "../Compositor.hpp"
+#include "../config/ConfigValue.hpp"
+#include "../helpers/VarList.hpp"
 
 #include <errno.h>
 #include <fcntl.h>
@@ -7,31 +9,52 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <sys/ioctl.h>
 
+#include <array>
 #include <string>
 #include <algorithm>
 
 CEventManager::CEventManager() {}
 
-int fdHandleWrite(int fd, uint32_t mask, void* data) {
-    const auto PEVMGR = (CEventManager*)data;
-    return PEVMGR->onFDWrite(fd, mask);
-}
+CEventManager::~CEventManager() {
+    if (m_tThread.joinable()) {
+        m_bExitThread = true;
+        eventfd_write(m_iWakeupFD, 1);
+        m_tThread.join();
+    }
 
-int socket2HandleWrite(int fd, uint32_t mask, void* data) {
-    const auto PEVMGR = (CEventManager*)data;
-    return PEVMGR->onSocket2Write(fd, mask);
+    for (auto& c : m_vClients) {
+        wl_event_source_remove(c->source);
+        close(c->fd);
+    }
+
+    m_vClients.clear();
+
+    if (m_pWakeupSource)
+        wl_event_source_remove(m_pWakeupSource);
+
+    if (m_pAcceptSource)
+        wl_event_source_remove(m_pAcceptSource);
+
+    if (m_pEventLoop)
+        wl_event_loop_destroy(m_pEventLoop);
+
+    if (m_iWakeupFD >= 0)
+        close(m_iWakeupFD);
+
+    if (m_iSocketFD >= 0)
+        close(m_iSocketFD);
 }
 
 void CEventManager::startThread() {
 
-    m_iSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    m_iSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
 
     if (m_iSocketFD < 0) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (1) IPC will not work.");
@@ -47,89 +70,330 @@ void CEventManager::startThread() {
     // 10 max queued.
     listen(m_iSocketFD, 10);
 
-    m_pEventSource = wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, m_iSocketFD, WL_EVENT_READABLE, socket2HandleWrite, this);
-}
+    m_iWakeupFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
 
-int CEventManager::onSocket2Write(int fd, uint32_t mask) {
+    if (m_iWakeupFD < 0) {
+        Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (2) IPC will not work.");
+        return;
+    }
 
-    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
-        Debug::log(ERR, "Socket2 hangup?? IPC broke");
-        wl_event_source_remove(m_pEventSource);
-        close(fd);
-        return 0;
+    // the dispatcher gets its own loop, so that slow clients never touch the compositor's one.
+    m_pEventLoop = wl_event_loop_create();
+
+    if (!m_pEventLoop) {
+        Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (3) IPC will not work.");
+        return;
     }
 
-    sockaddr_in clientAddress;
-    socklen_t   clientSize         = sizeof(clientAddress);
-    const auto  ACCEPTEDCONNECTION = accept4(m_iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK);
+    m_pAcceptSource = wl_event_loop_add_fd(m_pEventLoop, m_iSocketFD, WL_EVENT_READABLE, onSocket2Accept, this);
+    m_pWakeupSource = wl_event_loop_add_fd(m_pEventLoop, m_iWakeupFD, WL_EVENT_READABLE, onWakeup, this);
 
-    if (ACCEPTEDCONNECTION > 0) {
-        Debug::log(LOG, "Socket2 accepted a new client at FD {}", ACCEPTEDCONNECTION);
+    m_tThread = std::thread([this]() { dispatcherThread(); });
+
+    Debug::log(LOG, "Socket 2 started at {}", socketPath);
+}
 
-        // add to event loop so we can close it when we need to
-        m_dAcceptedSocketFDs.push_back(
-            std::make_pair<>(ACCEPTEDCONNECTION, wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, ACCEPTEDCONNECTION, WL_EVENT_READABLE, fdHandleWrite, this)));
-    } else {
-        Debug::log(ERR, "Socket2 failed receiving connection, errno: {}", errno);
-        close(fd);
+void CEventManager::dispatcherThread() {
+    while (!m_bExitThread) {
+        wl_event_loop_dispatch(m_pEventLoop, -1);
     }
+}
+
+int CEventManager::onWakeup(int fd, uint32_t mask, void* data) {
+    const auto PEVMGR = (CEventManager*)data;
+
+    eventfd_t  val = 0;
+    eventfd_read(fd, &val);
+
+    // clear before draining, so that a producer pushing past our popAll always wakes us again
+    PEVMGR->m_bWakeupPending = false;
+
+    std::lock_guard<std::mutex> lg(PEVMGR->m_mClientsMutex);
+    PEVMGR->dispatchQueuedEvents();
 
     return 0;
 }
 
-int CEventManager::onFDWrite(int fd, uint32_t mask) {
-    auto removeFD = [this](int fd) -> void {
-        for (auto it = m_dAcceptedSocketFDs.begin(); it != m_dAcceptedSocketFDs.end();) {
-            if (it->first == fd) {
-                wl_event_source_remove(it->second); // remove this fd listener
-                it = m_dAcceptedSocketFDs.erase(it);
-            } else {
-                it++;
-            }
-        }
+int CEventManager::onSocket2Accept(int fd, uint32_t mask, void* data) {
+    const auto PEVMGR = (CEventManager*)data;
+
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
+        wl_event_source_remove(PEVMGR->m_pAcceptSource);
+        PEVMGR->m_pAcceptSource = nullptr;
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lg(PEVMGR->m_mClientsMutex);
+    PEVMGR->acceptClient();
+
+    return 0;
+}
+
+int CEventManager::onClientFD(int fd, uint32_t mask, void* data) {
+    const auto                  PEVMGR = (CEventManager*)data;
+
+    std::lock_guard<std::mutex> lg(PEVMGR->m_mClientsMutex);
+
+    const auto                  PCLIENT = PEVMGR->getClient(fd);
 
-        close(fd);
-    };
+    if (!PCLIENT)
+        return 0;
 
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
         // remove, hanged up
-        removeFD(fd);
+        PEVMGR->removeClient(fd);
         return 0;
     }
 
-    int availableBytes;
-    if (ioctl(fd, FIONREAD, &availableBytes) == -1) {
-        Debug::log(ERR, "fd {} sent invalid data (1)", fd);
-        removeFD(fd);
-        return 0;
+    if (mask & WL_EVENT_READABLE) {
+        std::array<char, 1024> buf;
+        while (true) {
+            const auto RECEIVED = recv(fd, buf.data(), buf.size(), 0);
+
+            if (RECEIVED > 0) {
+                PCLIENT->readBuffer.append(buf.data(), RECEIVED);
+
+                size_t newline = 0;
+                while ((newline = PCLIENT->readBuffer.find('\n')) != std::string::npos) {
+                    PCLIENT->handleRequest(PCLIENT->readBuffer.substr(0, newline));
+                    PCLIENT->readBuffer.erase(0, newline + 1);
+                }
+
+                // the limit is per request, only a single unterminated line can go over it
+                if (PCLIENT->readBuffer.size() > MAX_CLIENT_REQUEST_SIZE) {
+                    PEVMGR->removeClient(fd);
+                    return 0;
+                }
+
+                continue;
+            }
+
+            if (RECEIVED == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                PEVMGR->removeClient(fd);
+                return 0;
+            }
+
+            if (errno != EINTR)
+                break;
+        }
     }
 
-    char       buf[availableBytes];
-    const auto RECEIVED = recv(fd, buf, availableBytes, 0);
-    if (RECEIVED == -1) {
-        Debug::log(ERR, "fd {} sent invalid data (2)", fd);
-        removeFD(fd);
-        return 0;
+    if (mask & WL_EVENT_WRITABLE) {
+        if (!PEVMGR->flushClient(PCLIENT))
+            PEVMGR->removeClient(fd);
     }
 
     return 0;
 }
 
-void CEventManager::flushEvents() {
-    eventQueueMutex.lock();
+void CEventManager::acceptClient() {
+    while (true) {
+        sockaddr_in clientAddress;
+        socklen_t   clientSize = sizeof(clientAddress);
+
+        const auto ACCEPTEDCONNECTION = accept4(m_iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+        if (ACCEPTEDCONNECTION < 0)
+            break;
+
+        auto& client   = m_vClients.emplace_back(std::make_unique<SClient>());
+        client->fd     = ACCEPTEDCONNECTION;
+        client->source = wl_event_loop_add_fd(m_pEventLoop, ACCEPTEDCONNECTION, WL_EVENT_READABLE, onClientFD, this);
+
+        m_iClients = m_vClients.size();
+    }
+}
+
+bool CEventManager::SClient::wantsEvent(const std::string& event) const {
+    if (filtered)
+        return allowed.contains(event);
+
+    return !denied.contains(event);
+}
+
+/*
+    Clients can send newline-terminated requests to narrow down what they receive:
+    subscribe <event> [event...]   -> only receive the listed events
+    unsubscribe <event> [event...] -> stop receiving the listed events
+    reset                          -> receive everything again
+    format json|plain              -> frame events as JSON objects or as event>>data
+*/
+void CEventManager::SClient::handleRequest(std::string request) {
+    // events can be separated by spaces or commas
+    std::replace(request.begin(), request.end(), ',', ' ');
+
+    CVarList args(request, 0, 's', true);
+
+    if (args[0] == "subscribe") {
+        // an explicit subscription turns this into an allow-list client
+        if (!filtered) {
+            filtered = true;
+            denied.clear();
+        }
 
-    for (auto& ev : m_dQueuedEvents) {
-        std::string eventString = (ev.event + ">>" + ev.data).substr(0, 1022) + "\n";
-        for (auto& fd : m_dAcceptedSocketFDs) {
-            try {
-                write(fd.first, eventString.c_str(), eventString.length());
-            } catch (...) {}
+        for (size_t i = 1; i < args.size(); ++i) {
+            allowed.emplace(args[i]);
+        }
+    } else if (args[0] == "unsubscribe") {
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (filtered)
+                allowed.erase(args[i]);
+            else
+                denied.emplace(args[i]);
         }
+    } else if (args[0] == "reset") {
+        filtered = false;
+        allowed.clear();
+        denied.clear();
+    } else if (args[0] == "format")
+        json = args[1] == "json";
+}
+
+std::string CEventManager::SClient::describeFilter() const {
+    if (!filtered && denied.empty())
+        return "all";
+
+    std::string result = filtered ? "allow:" : "deny:";
+    for (auto& e : filtered ? allowed : denied) {
+        result += " " + e;
+    }
+
+    return result;
+}
+
+std::string CEventManager::formatEvent(SHyprIPCEvent ev) {
+    std::replace(ev.data.begin(), ev.data.end(), '\n', ' ');
+    return (ev.event + ">>" + ev.data).substr(0, 1022) + "\n";
+}
+
+std::string CEventManager::formatEventJSON(const SHyprIPCEvent& ev) {
+    return std::format("{{\"event\":\"{}\",\"data\":\"{}\"}}\n", escapeJSONStrings(ev.event), escapeJSONStrings(ev.data));
+}
+
+CEventManager::SClient* CEventManager::getClient(int fd) {
+    for (auto& c : m_vClients) {
+        if (c->fd == fd)
+            return c.get();
+    }
+
+    return nullptr;
+}
+
+void CEventManager::removeClient(int fd) {
+    std::erase_if(m_vClients, [fd](const auto& c) {
+        if (c->fd != fd)
+            return false;
+
+        wl_event_source_remove(c->source);
+        close(c->fd);
+        return true;
+    });
+
+    m_iClients = m_vClients.size();
+}
+
+bool CEventManager::flushClient(SClient* client) {
+    while (!client->partial.empty() || !client->queue.empty()) {
+        const bool         PARTIAL = !client->partial.empty();
+        const std::string& DATA    = PARTIAL ? client->partial : *client->queue.front();
+
+        const auto         WRITTEN = send(client->fd, DATA.c_str(), DATA.length(), MSG_NOSIGNAL);
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            return false;
+        }
+
+        if ((size_t)WRITTEN < DATA.length()) {
+            // socket buffer is full, keep the rest and wait for EPOLLOUT
+            client->partial = DATA.substr(WRITTEN);
+
+            if (!PARTIAL)
+                client->queue.pop_front();
+
+            break;
+        }
+
+        if (PARTIAL)
+            client->partial.clear();
+        else
+            client->queue.pop_front();
     }
 
-    m_dQueuedEvents.clear();
+    const bool WANTSWRITABLE = !client->partial.empty() || !client->queue.empty();
+
+    if (WANTSWRITABLE != client->wantsWritable) {
+        client->wantsWritable = WANTSWRITABLE;
+        wl_event_source_fd_update(client->source, WANTSWRITABLE ? WL_EVENT_READABLE | WL_EVENT_WRITABLE : WL_EVENT_READABLE);
+    }
 
-    eventQueueMutex.unlock();
+    return true;
+}
+
+void CEventManager::dispatchQueuedEvents() {
+    std::vector<SHyprIPCEvent> events;
+
+    if (m_qQueuedEvents.popAll(events) == 0)
+        return;
+
+    const auto       MAXQUEUED = std::max(m_iMaxQueued.load(), (size_t)1);
+    const auto       POLICY    = m_iOverflowPolicy.load();
+
+    std::vector<int> overflown;
+
+    for (auto& ev : events) {
+        // formatted lazily, only if at least one client wants this event in that framing
+        SP<const std::string> plainString;
+        SP<const std::string> jsonString;
+
+        for (auto& c : m_vClients) {
+            if (!c->wantsEvent(ev.event))
+                continue;
+
+            if (c->queue.size() >= MAXQUEUED) {
+                if (POLICY == SOCKET2_OVERFLOW_DISCONNECT) {
+                    if (std::find(overflown.begin(), overflown.end(), c->fd) == overflown.end())
+                        overflown.push_back(c->fd);
+                    continue;
+                }
+
+                c->queue.pop_front();
+                c->dropped++;
+                m_iDroppedEvents++;
+            }
+
+            auto& eventString = c->json ? jsonString : plainString;
+            if (!eventString)
+                eventString = std::make_shared<const std::string>(c->json ? formatEventJSON(ev) : formatEvent(ev));
+
+            c->queue.push_back(eventString);
+        }
+    }
+
+    for (auto& fd : overflown) {
+        removeClient(fd);
+        m_iDisconnectedClients++;
+    }
+
+    std::vector<int> dead;
+
+    for (auto& c : m_vClients) {
+        // clients waiting on EPOLLOUT will be flushed once they're writable
+        if (c->wantsWritable)
+            continue;
+
+        if (!flushClient(c.get()))
+            dead.push_back(c->fd);
+    }
+
+    for (auto& fd : dead) {
+        removeClient(fd);
+    }
 }
 
 void CEventManager::postEvent(const SHyprIPCEvent event) {
@@ -139,16 +403,36 @@ void CEventManager::postEvent(const SHyprIPCEvent event) {
         return;
     }
 
-    std::thread(
-        [this](SHyprIPCEvent ev) {
-            std::replace(ev.data.begin(), ev.data.end(), '\n', ' ');
+    if (!m_tThread.joinable() || m_iClients == 0)
+        return;
+
+    static auto PMAXQUEUED = CConfigValue<Hyprlang::INT>("misc:socket2_max_queued");
+    static auto POVERFLOW  = CConfigValue<Hyprlang::INT>("misc:socket2_overflow_policy");
 
-            eventQueueMutex.lock();
-            m_dQueuedEvents.push_back(ev);
-            eventQueueMutex.unlock();
+    // config is not thread-safe, hand the current values over to the dispatcher
+    m_iMaxQueued      = (size_t)std::max(*PMAXQUEUED, (Hyprlang::INT)1);
+    m_iOverflowPolicy = *POVERFLOW == SOCKET2_OVERFLOW_DISCONNECT ? SOCKET2_OVERFLOW_DISCONNECT : SOCKET2_OVERFLOW_DROP_OLDEST;
+
+    m_qQueuedEvents.push(SHyprIPCEvent{event});
+    m_iPostedEvents++;
+
+    // coalesce wakeups, one eventfd write per drained batch
+    if (!m_bWakeupPending.exchange(true))
+        eventfd_write(m_iWakeupFD, 1);
+}
+
+CEventManager::SStats CEventManager::getStats() {
+    SStats stats;
+    stats.posted       = m_iPostedEvents;
+    stats.dropped      = m_iDroppedEvents;
+    stats.disconnected = m_iDisconnectedClients;
+
+    std::lock_guard<std::mutex> lg(m_mClientsMutex);
+
+    for (auto& c : m_vClients) {
+        stats.clients.push_back(
+            SClientStats{.fd = c->fd, .queued = c->queue.size() + (c->partial.empty() ? 0 : 1), .dropped = c->dropped, .json = c->json, .filter = c->describeFilter()});
+    }
 
-            flushEvents();
-        },
-        event)
-        .detach();
+    return stats;
 }
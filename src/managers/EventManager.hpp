@@ -1,40 +1,114 @@
 #pragma once
+#include <atomic>
 #include <deque>
 #include <fstream>
 #include <mutex>
+#include <thread>
+#include <unordered_set>
 
 #include "../defines.hpp"
 #include "../helpers/MiscFunctions.hpp"
+#include "../helpers/MPSCQueue.hpp"
 
 struct SHyprIPCEvent {
     std::string event;
     std::string data;
 };
 
+// maximum size of a pending, not newline-terminated client request
+#define MAX_CLIENT_REQUEST_SIZE 4096
+
+enum eSocket2OverflowPolicy {
+    SOCKET2_OVERFLOW_DROP_OLDEST = 0,
+    SOCKET2_OVERFLOW_DISCONNECT,
+};
+
 class CEventManager {
   public:
     CEventManager();
+    ~CEventManager();
 
-    void        postEvent(const SHyprIPCEvent event);
+    void postEvent(const SHyprIPCEvent event);
 
-    void        startThread();
+    void startThread();
 
-    std::thread m_tThread;
+    int  m_iSocketFD = -1;
 
-    int         m_iSocketFD = -1;
+    struct SClientStats {
+        int         fd      = -1;
+        size_t      queued  = 0;
+        uint64_t    dropped = 0;
+        bool        json    = false;
+        std::string filter;
+    };
 
-    int         onSocket2Write(int fd, uint32_t mask);
-    int         onFDWrite(int fd, uint32_t mask);
+    struct SStats {
+        uint64_t                  posted       = 0;
+        uint64_t                  dropped      = 0;
+        uint64_t                  disconnected = 0;
+        std::vector<SClientStats> clients;
+    };
+
+    // thread-safe snapshot of the dispatcher counters
+    SStats getStats();
 
   private:
-    void                                         flushEvents();
+    struct SClient {
+        int                               fd     = -1;
+        wl_event_source*                  source = nullptr;
+        std::deque<SP<const std::string>> queue;
+        std::string                       partial; // unwritten tail of a message that was only partially written
+        std::string                       readBuffer;
+        uint64_t                          dropped       = 0;
+        bool                              wantsWritable = false;
+
+        // subscription state, see handleRequest
+        bool                              filtered = false; // if set, only events in allowed are sent
+        bool                              json     = false;
+        std::unordered_set<std::string>   allowed;
+        std::unordered_set<std::string>   denied;
+
+        bool                              wantsEvent(const std::string& event) const;
+        void                              handleRequest(std::string request);
+        std::string                       describeFilter() const;
+    };
+
+    // dispatcher thread only
+    void                      dispatcherThread();
+    void                      dispatchQueuedEvents();
+    void                      acceptClient();
+    bool                      flushClient(SClient* client);
+    void                      removeClient(int fd);
+    SClient*                  getClient(int fd);
+
+    static std::string        formatEvent(SHyprIPCEvent ev);
+    static std::string        formatEventJSON(const SHyprIPCEvent& ev);
+
+    static int                onWakeup(int fd, uint32_t mask, void* data);
+    static int                onSocket2Accept(int fd, uint32_t mask, void* data);
+    static int                onClientFD(int fd, uint32_t mask, void* data);
+
+    CMPSCQueue<SHyprIPCEvent> m_qQueuedEvents;
+    std::atomic<bool>         m_bWakeupPending = false;
+    std::atomic<bool>         m_bExitThread    = false;
+
+    std::atomic<size_t>       m_iMaxQueued      = 1024;
+    std::atomic<int>          m_iOverflowPolicy = SOCKET2_OVERFLOW_DROP_OLDEST;
 
-    std::mutex                                   eventQueueMutex;
-    std::deque<SHyprIPCEvent>                    m_dQueuedEvents;
+    std::atomic<uint64_t>     m_iPostedEvents        = 0;
+    std::atomic<uint64_t>     m_iDroppedEvents       = 0;
+    std::atomic<uint64_t>     m_iDisconnectedClients = 0;
+    std::atomic<size_t>       m_iClients             = 0;
 
-    std::deque<std::pair<int, wl_event_source*>> m_dAcceptedSocketFDs;
+    int                       m_iWakeupFD     = -1;
+    wl_event_loop*            m_pEventLoop    = nullptr;
+    wl_event_source*          m_pAcceptSource = nullptr;
+    wl_event_source*          m_pWakeupSource = nullptr;
+    std::thread               m_tThread;
 
-    wl_event_source*                             m_pEventSource = nullptr;
+    // owned by the dispatcher thread, guarded by m_mClientsMutex only for stat reads
+    std::vector<UP<SClient>>  m_vClients;
+    std::mutex                m_mClientsMutex;
 };
 
 inline std::unique_ptr<CEventManager> g_pEventManager;
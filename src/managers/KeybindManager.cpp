@@ -117,14 +117,24 @@ CKeybindManager::CKeybindManager() {
 }
 
 void CKeybindManager::addKeybind(SKeybind kb) {
+    kb.order = m_iNextKeybindOrder++;
+
+    if (!kb.key.empty()) {
+        // resolved once here, every key press used to pay for this per bind
+        kb.keysym      = xkb_keysym_from_name(kb.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+        kb.keysymUpper = xkb_keysym_to_upper(kb.keysym);
+    }
+
     m_lKeybinds.push_back(kb);
 
-    m_pActiveKeybind = nullptr;
+    m_pActiveKeybind     = nullptr;
+    m_bKeybindIndexDirty = true;
 }
 
 void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
     for (auto it = m_lKeybinds.begin(); it != m_lKeybinds.end(); ++it) {
         if (it->modmask == mod && it->key == key.key && it->keycode == key.keycode && it->catchAll == key.catchAll) {
+            std::erase(m_vPressedSpecialBinds, &*it);
             it = m_lKeybinds.erase(it);
 
             if (it == m_lKeybinds.end())
@@ -132,7 +142,50 @@ void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
         }
     }
 
-    m_pActiveKeybind = nullptr;
+    m_pActiveKeybind     = nullptr;
+    m_bKeybindIndexDirty = true;
+}
+
+void CKeybindManager::rebuildKeybindIndex() {
+    m_mKeybindIndex.clear();
+
+    for (auto& k : m_lKeybinds) {
+        auto& submap = m_mKeybindIndex[k.submap];
+        auto& lookup = k.ignoreMods ? submap.ignoreMods : submap.mods[k.modmask];
+
+        if (k.keycode != 0)
+            lookup.keycodes[k.keycode].push_back(&k);
+        else if (k.catchAll)
+            lookup.catchAll.push_back(&k);
+        else {
+            lookup.names[k.key].push_back(&k);
+
+            // binds that failed to resolve never match a keysym, see handleKeybinds
+            if (k.keysym != 0) {
+                lookup.keysyms[k.keysym].push_back(&k);
+                if (k.keysymUpper != k.keysym)
+                    lookup.keysyms[k.keysymUpper].push_back(&k);
+            }
+        }
+    }
+
+    m_bKeybindIndexDirty = false;
+}
+
+void CKeybindManager::collectKeybinds(const SKeybindLookup& lookup, const SPressedKeyWithMods& key, std::vector<SKeybind*>& out) {
+    const auto APPEND = [&out](const auto& map, const auto& value) {
+        if (const auto IT = map.find(value); IT != map.end())
+            out.insert(out.end(), IT->second.begin(), IT->second.end());
+    };
+
+    if (!key.keyName.empty()) {
+        APPEND(lookup.names, key.keyName);
+        return;
+    }
+
+    APPEND(lookup.keycodes, key.keycode);
+    APPEND(lookup.keysyms, key.keysym);
+    out.insert(out.end(), lookup.catchAll.begin(), lookup.catchAll.end());
 }
 
 uint32_t CKeybindManager::stringToModMask(std::string mods) {
@@ -542,7 +595,27 @@ bool CKeybindManager::handleKeybinds(const uint32_t modmask, const SPressedKeyWi
         return false;
     }
 
-    for (auto& k : m_lKeybinds) {
+    if (m_bKeybindIndexDirty)
+        rebuildKeybindIndex();
+
+    // only the binds that can match this key, the checks below still apply to them
+    std::vector<SKeybind*> candidates;
+    if (const auto IT = m_mKeybindIndex.find(m_szCurrentSelectedSubmap); IT != m_mKeybindIndex.end()) {
+        if (const auto MODSIT = IT->second.mods.find(modmask); MODSIT != IT->second.mods.end())
+            collectKeybinds(MODSIT->second, key, candidates);
+
+        collectKeybinds(IT->second.ignoreMods, key, candidates);
+    }
+
+    // pressed special binds are released regardless of mods and submap
+    if (!pressed)
+        candidates.insert(candidates.end(), m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end());
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a->order < b->order; });
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (auto& pKeybind : candidates) {
+        auto&      k                 = *pKeybind;
         const bool SPECIALDISPATCHER = k.handler == "global" || k.handler == "pass" || k.handler == "mouse";
         const bool SPECIALTRIGGERED =
             std::find_if(m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end(), [&](const auto& other) { return other == &k; }) != m_vPressedSpecialBinds.end();
@@ -563,11 +636,7 @@ bool CKeybindManager::handleKeybinds(const uint32_t modmask, const SPressedKeyWi
             if (found)
                 continue;
         } else {
-            // oMg such performance hit!!11!
-            // this little maneouver is gonna cost us 4µs
-            const auto KBKEY = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
-
-            if (KBKEY == 0) {
+            if (k.keysym == 0) {
                 // Keysym failed to resolve from the key name of the currently iterated bind.
                 // This happens for names such as `switch:off:Lid Switch` as well as some keys
                 // (such as yen and ro).
@@ -578,9 +647,7 @@ bool CKeybindManager::handleKeybinds(const uint32_t modmask, const SPressedKeyWi
                 continue;
             }
 
-            const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
-
-            if (key.keysym != KBKEY && key.keysym != KBKEYUPPER)
+            if (key.keysym != k.keysym && key.keysym != k.keysymUpper)
                 continue;
         }
 
@@ -667,11 +734,8 @@ void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const uint3
         if (k.handler == "global" || k.transparent)
             continue; // can't be shadowed
 
-        const auto KBKEY      = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
-        const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
-
         for (auto& pk : m_dPressedKeys) {
-            if ((pk.keysym != 0 && (pk.keysym == KBKEY || pk.keysym == KBKEYUPPER))) {
+            if ((pk.keysym != 0 && (pk.keysym == k.keysym || pk.keysym == k.keysymUpper))) {
                 shadow = true;
 
                 if (pk.keysym == doesntHave && doesntHave != 0) {
@@ -864,6 +928,10 @@ void CKeybindManager::kill(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_lKeybinds.clear();
+    m_vPressedSpecialBinds.clear();
+
+    m_pActiveKeybind     = nullptr;
+    m_bKeybindIndexDirty = true;
 }
 
 static void toggleActiveFloatingCore(std::string args, std::optional<bool> floatState) {
@@ -2075,8 +2143,8 @@ void CKeybindManager::pinActive(std::string args) {
     if (!PWINDOW->m_bIsFloating || PWINDOW->m_bIsFullscreen)
         return;
 
-    PWINDOW->m_bPinned    = !PWINDOW->m_bPinned;
-    PWINDOW->m_pWorkspace = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID)->activeWorkspace;
+    PWINDOW->setPinned(!PWINDOW->m_bPinned);
+    PWINDOW->setWorkspace(g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID)->activeWorkspace);
 
     PWINDOW->updateDynamicRules();
     g_pCompositor->updateWindowAnimatedDecorationValues(PWINDOW);
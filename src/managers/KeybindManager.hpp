@@ -27,7 +27,10 @@ struct SKeybind {
     bool        ignoreMods   = false;
 
     // DO NOT INITIALIZE
-    bool shadowed = false;
+    bool         shadowed    = false;
+    xkb_keysym_t keysym      = 0; // resolved from key once, when the bind is added
+    xkb_keysym_t keysymUpper = 0;
+    uint64_t     order       = 0; // binds are dispatched in the order they were added
 };
 
 enum eFocusWindowMode {
@@ -115,6 +118,26 @@ class CKeybindManager {
     static void                     moveWindowIntoGroup(PHLWINDOW pWindow, PHLWINDOW pWindowInDirection);
     static void                     switchToWindow(PHLWINDOW PWINDOWTOCHANGETO);
 
+    // binds that can match a key, so a key press doesn't have to look at every bind
+    struct SKeybindLookup {
+        std::unordered_map<std::string, std::vector<SKeybind*>>  names; // mouse buttons, axes and switches
+        std::unordered_map<xkb_keysym_t, std::vector<SKeybind*>> keysyms;
+        std::unordered_map<uint32_t, std::vector<SKeybind*>>     keycodes;
+        std::vector<SKeybind*>                                   catchAll;
+    };
+
+    struct SSubmapKeybinds {
+        std::unordered_map<uint32_t, SKeybindLookup> mods; // by modmask
+        SKeybindLookup                               ignoreMods;
+    };
+
+    std::unordered_map<std::string, SSubmapKeybinds> m_mKeybindIndex; // by submap
+    bool                                             m_bKeybindIndexDirty = true;
+    uint64_t                                         m_iNextKeybindOrder  = 0;
+
+    void                                             rebuildKeybindIndex();
+    void                                             collectKeybinds(const SKeybindLookup& lookup, const SPressedKeyWithMods& key, std::vector<SKeybind*>& out);
+
     // -------------- Dispatchers -------------- //
     static void     killActive(std::string);
     static void     kill(std::string);
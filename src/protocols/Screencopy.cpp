@@ -4,9 +4,17 @@
 #include <algorithm>
 
 #include "ToplevelExportWlrFuncs.hpp"
+#include "../render/AsyncReadback.hpp"
 
 #define SCREENCOPY_VERSION 3
 
+// buffers a client rotates through that we remember the contents of
+constexpr size_t MAX_TRACKED_BUFFERS = 4;
+// regions a client copies that we keep the damage of, usually just the whole monitor
+constexpr size_t MAX_TRACKED_REGIONS = 8;
+// past this, the damage is sent as its extents
+constexpr size_t MAX_DAMAGE_RECTS = 32;
+
 static void bindManagerInt(wl_client* client, void* data, uint32_t version, uint32_t id) {
     g_pProtocolManager->m_pScreencopyProtocolManager->bindManager(client, data, version, id);
 }
@@ -154,6 +162,74 @@ void CScreencopyClient::onTick() {
     }
 }
 
+void CScreencopyClient::addDamage(CMonitor* pMonitor, const CRegion& region) {
+    for (auto& f : frameDamage) {
+        if (f.monitorID == pMonitor->ID)
+            f.damage.add(region);
+    }
+
+    std::erase_if(bufferDamage, [](const auto& other) { return !other.buffer; });
+
+    for (auto& b : bufferDamage) {
+        if (b.monitorID == pMonitor->ID)
+            b.damage.add(region);
+    }
+}
+
+void CScreencopyClient::onFrameCopied(SScreencopyFrame* frame) {
+    // only this region is up to date now, frames of other regions still need what changed in theirs
+    auto region = getFrameDamage(frame);
+
+    if (!region) {
+        if (frameDamage.size() >= MAX_TRACKED_REGIONS)
+            frameDamage.pop_front();
+
+        region = &frameDamage.emplace_back(SFrameDamage{frame->pMonitor->ID, frame->box, {}});
+    }
+
+    region->damage.clear();
+
+    if (frame->bufferCap != WLR_BUFFER_CAP_SHM)
+        return;
+
+    auto it = std::find_if(bufferDamage.begin(), bufferDamage.end(), [frame](const auto& other) { return other.buffer == frame->buffer; });
+
+    if (it == bufferDamage.end()) {
+        if (bufferDamage.size() >= MAX_TRACKED_BUFFERS)
+            bufferDamage.pop_front();
+
+        auto& entry  = bufferDamage.emplace_back();
+        entry.buffer = frame->buffer;
+        entry.destroyListener.initCallback(
+            &frame->buffer->events.destroy,
+            [&entry](void* owner, void* data) {
+                entry.destroyListener.removeCallback();
+                entry.buffer = nullptr;
+            },
+            this, "CScreencopyClient");
+
+        it = std::prev(bufferDamage.end());
+    }
+
+    it->monitorID = frame->pMonitor->ID;
+    it->box       = frame->box;
+    it->damage.clear();
+}
+
+CScreencopyClient::SFrameDamage* CScreencopyClient::getFrameDamage(SScreencopyFrame* frame) {
+    const auto IT = std::find_if(frameDamage.begin(), frameDamage.end(), [frame](const auto& other) { return other.monitorID == frame->pMonitor->ID && other.box == frame->box; });
+
+    return IT == frameDamage.end() ? nullptr : &*IT;
+}
+
+void CScreencopyClient::forgetFrame(SScreencopyFrame* frame) {
+    // what's in the buffer is unknown now, the next frame has to be complete
+    std::erase_if(bufferDamage, [frame](const auto& other) { return other.buffer == frame->buffer; });
+
+    if (frame->pMonitor)
+        std::erase_if(frameDamage, [frame](const auto& other) { return other.monitorID == frame->pMonitor->ID && other.box == frame->box; });
+}
+
 void CScreencopyProtocolManager::bindManager(wl_client* client, void* data, uint32_t version, uint32_t id) {
     const auto PCLIENT = &m_lClients.emplace_back();
 
@@ -185,6 +261,9 @@ void CScreencopyProtocolManager::removeFrame(SScreencopyFrame* frame, bool force
 
     std::erase_if(m_vFramesAwaitingWrite, [&](const auto& other) { return other == frame; });
 
+    if (frame->readbackID && g_pAsyncReadback)
+        g_pAsyncReadback->cancel(frame->readbackID);
+
     wl_resource_set_user_data(frame->resource, nullptr);
     if (frame->buffer && frame->buffer->n_locks > 0)
         wlr_buffer_unlock(frame->buffer);
@@ -360,6 +439,12 @@ void CScreencopyProtocolManager::copyFrame(wl_client* client, wl_resource* resou
 }
 
 void CScreencopyProtocolManager::onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e) {
+    const CRegion DAMAGE = pMonitor->commitDamage.known ? pMonitor->commitDamage.region : CRegion{0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y};
+
+    for (auto& c : m_lClients) {
+        c.addDamage(pMonitor, DAMAGE);
+    }
+
     m_pLastMonitorBackBuffer = e->state->buffer;
     shareAllFrames(pMonitor);
     m_pLastMonitorBackBuffer = nullptr;
@@ -381,6 +466,10 @@ void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
         if (f->pMonitor != pMonitor)
             continue;
 
+        // copy_with_damage waits until something in the captured region changed
+        if (!prepareFrameDamage(f))
+            continue;
+
         shareFrame(f);
 
         f->client->lastFrame.reset();
@@ -390,6 +479,12 @@ void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
     }
 
     for (auto& f : framesToRemove) {
+        // still being read back, removed once the pixels land
+        if (f->readbackID) {
+            std::erase(m_vFramesAwaitingWrite, f);
+            continue;
+        }
+
         removeFrame(f);
     }
 
@@ -407,6 +502,35 @@ void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
     }
 }
 
+bool CScreencopyProtocolManager::prepareFrameDamage(SScreencopyFrame* frame) {
+    const auto PCLIENT   = frame->client;
+    const auto ID        = frame->pMonitor->ID;
+    const CBox BUFFERBOX = {0, 0, frame->box.w, frame->box.h};
+
+    const auto PREGION = PCLIENT ? PCLIENT->getFrameDamage(frame) : nullptr;
+
+    if (PREGION)
+        frame->damage = CRegion{PREGION->damage}.translate(-frame->box.pos()).intersect(BUFFERBOX);
+    else
+        frame->damage = BUFFERBOX;
+
+    if (frame->withDamage && frame->damage.empty())
+        return false;
+
+    frame->copyRegion = BUFFERBOX;
+
+    // only for clients asking for damage, those keep their buffers as we left them
+    if (!frame->withDamage || !PCLIENT || frame->bufferCap != WLR_BUFFER_CAP_SHM)
+        return true;
+
+    const auto IT = std::find_if(PCLIENT->bufferDamage.begin(), PCLIENT->bufferDamage.end(), [frame](const auto& other) { return other.buffer == frame->buffer; });
+
+    if (IT != PCLIENT->bufferDamage.end() && IT->monitorID == ID && IT->box == frame->box)
+        frame->copyRegion = CRegion{IT->damage}.translate(-frame->box.pos()).intersect(BUFFERBOX);
+
+    return true;
+}
+
 void CScreencopyProtocolManager::shareFrame(SScreencopyFrame* frame) {
     if (!frame->buffer)
         return;
@@ -414,7 +538,6 @@ void CScreencopyProtocolManager::shareFrame(SScreencopyFrame* frame) {
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
-    uint32_t flags = 0;
     if (frame->bufferCap == WLR_BUFFER_CAP_DMABUF) {
         if (!copyFrameDmabuf(frame)) {
             Debug::log(ERR, "[sc] dmabuf copy failed in {:x}", (uintptr_t)frame);
@@ -429,6 +552,17 @@ void CScreencopyProtocolManager::shareFrame(SScreencopyFrame* frame) {
         }
     }
 
+    if (frame->client)
+        frame->client->onFrameCopied(frame);
+
+    if (frame->readbackID)
+        return;
+
+    sendFrameReady(frame, now);
+}
+
+void CScreencopyProtocolManager::sendFrameReady(SScreencopyFrame* frame, const timespec& now) {
+    uint32_t flags = 0;
     zwlr_screencopy_frame_v1_send_flags(frame->resource, flags);
     sendFrameDamage(frame);
     uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
@@ -440,21 +574,17 @@ void CScreencopyProtocolManager::sendFrameDamage(SScreencopyFrame* frame) {
     if (!frame->withDamage)
         return;
 
-    // TODO:
-    // add a damage ring for this.
+    const auto RECTS = frame->damage.getRects();
 
-    // for (auto& RECT : frame->pMonitor->lastFrameDamage.getRects()) {
-
-    //     if (frame->buffer->width < 1 || frame->buffer->height < 1 || frame->buffer->width - RECT.x1 < 1 || frame->buffer->height - RECT.y1 < 1) {
-    //         Debug::log(ERR, "[sc] Failed to send damage");
-    //         break;
-    //     }
-
-    //     zwlr_screencopy_frame_v1_send_damage(frame->resource, std::clamp(RECT.x1, 0, frame->buffer->width), std::clamp(RECT.y1, 0, frame->buffer->height),
-    //                                          std::clamp(RECT.x2 - RECT.x1, 0, frame->buffer->width - RECT.x1), std::clamp(RECT.y2 - RECT.y1, 0, frame->buffer->height - RECT.y1));
-    // }
+    if (RECTS.size() > MAX_DAMAGE_RECTS) {
+        const auto EXTENTS = frame->damage.getExtents();
+        zwlr_screencopy_frame_v1_send_damage(frame->resource, EXTENTS.x, EXTENTS.y, EXTENTS.w, EXTENTS.h);
+        return;
+    }
 
-    zwlr_screencopy_frame_v1_send_damage(frame->resource, 0, 0, frame->buffer->width, frame->buffer->height);
+    for (auto& RECT : RECTS) {
+        zwlr_screencopy_frame_v1_send_damage(frame->resource, RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1);
+    }
 }
 
 bool CScreencopyProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec* now) {
@@ -474,7 +604,7 @@ bool CScreencopyProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec*
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer fb;
+    CFramebuffer fb{FB_CATEGORY_CAPTURE};
     fb.alloc(frame->box.w, frame->box.h, g_pHyprRenderer->isNvidia() ? DRM_FORMAT_XBGR8888 : frame->pMonitor->drmFormat);
 
     if (!g_pHyprRenderer->beginRender(frame->pMonitor, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &fb)) {
@@ -511,17 +641,72 @@ bool CScreencopyProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec*
     g_pHyprOpenGL->m_RenderData.pMonitor = frame->pMonitor;
     fb.bind();
 
+    // the client gets ready once the pixels land, without the main thread waiting on the gpu here
+    CAsyncReadback::SRequest request;
+    request.buffer    = frame->buffer;
+    request.width     = frame->box.w;
+    request.height    = frame->box.h;
+    request.drmFormat = format;
+    request.glFormat  = PFORMAT;
+    request.region    = frame->copyRegion;
+    request.onDone    = [this, frame, NOW = *now](bool success) {
+        frame->readbackID = 0;
+
+        if (success)
+            sendFrameReady(frame, NOW);
+        else {
+            Debug::log(ERR, "[sc] async shm copy failed in {:x}", (uintptr_t)frame);
+            zwlr_screencopy_frame_v1_send_failed(frame->resource);
+
+            if (frame->client)
+                frame->client->forgetFrame(frame);
+        }
+
+        removeFrame(frame);
+    };
+
+    frame->readbackID = g_pAsyncReadback->read(&fb, std::move(request));
+
+    if (frame->readbackID) {
+        g_pHyprOpenGL->m_RenderData.pMonitor = nullptr;
+
+        wlr_buffer_end_data_ptr_access(frame->buffer);
+        wlr_texture_destroy(sourceTex);
+
+        return true;
+    }
+
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
 
     const wlr_pixel_format_info* drmFmtWlr  = drm_get_pixel_format_info(format);
     uint32_t                     packStride = pixel_format_info_min_stride(drmFmtWlr, frame->box.w);
 
-    if (packStride == stride) {
-        glReadPixels(0, 0, frame->box.w, frame->box.h, PFORMAT->glFormat, PFORMAT->glType, data);
+    const auto                   RECTS      = frame->copyRegion.getRects();
+
+    if (packStride == stride && RECTS.size() == 1 && RECTS[0].x1 == 0 && RECTS[0].x2 == frame->box.w) {
+        const auto& RECT = RECTS[0];
+        glReadPixels(0, RECT.y1, frame->box.w, RECT.y2 - RECT.y1, PFORMAT->glFormat, PFORMAT->glType, ((unsigned char*)data) + RECT.y1 * stride);
     } else {
-        for (size_t i = 0; i < frame->box.h; ++i) {
-            uint32_t y = i;
-            glReadPixels(0, y, frame->box.w, 1, PFORMAT->glFormat, PFORMAT->glType, ((unsigned char*)data) + i * stride);
+        const size_t BPP = drmFmtWlr->bytes_per_block;
+#ifndef GLES2
+        // one read per rect, the row length lets gl step over the rest of each row in the client's buffer
+        if (stride % BPP == 0) {
+            glPixelStorei(GL_PACK_ROW_LENGTH, stride / BPP);
+
+            for (auto& RECT : RECTS) {
+                glReadPixels(RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1, PFORMAT->glFormat, PFORMAT->glType, ((unsigned char*)data) + RECT.y1 * stride + RECT.x1 * BPP);
+            }
+
+            glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+        } else
+#endif
+        {
+            // no row length to pack with, one read per row
+            for (auto& RECT : RECTS) {
+                for (int y = RECT.y1; y < RECT.y2; ++y) {
+                    glReadPixels(RECT.x1, y, RECT.x2 - RECT.x1, 1, PFORMAT->glFormat, PFORMAT->glType, ((unsigned char*)data) + y * stride + RECT.x1 * BPP);
+                }
+            }
         }
     }
 
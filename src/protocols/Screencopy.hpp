@@ -7,8 +7,11 @@
 #include <vector>
 #include "../managers/HookSystemManager.hpp"
 #include "../helpers/Timer.hpp"
+#include "../helpers/Region.hpp"
+#include "../helpers/WLListener.hpp"
 
 class CMonitor;
+struct SScreencopyFrame;
 
 enum eClientOwners {
     CLIENT_SCREENCOPY = 0,
@@ -37,6 +40,30 @@ class CScreencopyClient {
     bool                              operator==(const CScreencopyClient& other) const {
         return resource == other.resource;
     }
+
+    // damage since the last frame sent for each region of a monitor a client copies, in monitor buffer coordinates.
+    // Regions without an entry count as fully damaged.
+    struct SFrameDamage {
+        uint64_t monitorID = 0;
+        CBox     box;
+        CRegion  damage;
+    };
+    std::list<SFrameDamage> frameDamage;
+
+    // shm buffers that still hold a frame we copied, only what changed since then has to be copied into them again
+    struct SBufferDamage {
+        wlr_buffer*     buffer    = nullptr; // reset when the buffer is destroyed
+        uint64_t        monitorID = 0;
+        CBox            box;
+        CRegion         damage;
+        CHyprWLListener destroyListener;
+    };
+    std::list<SBufferDamage> bufferDamage;
+
+    void                     addDamage(CMonitor* pMonitor, const CRegion& region);
+    void                     onFrameCopied(SScreencopyFrame* frame);
+    void                     forgetFrame(SScreencopyFrame* frame);
+    SFrameDamage*            getFrameDamage(SScreencopyFrame* frame);
 };
 
 struct SScreencopyFrame {
@@ -58,6 +85,11 @@ struct SScreencopyFrame {
     CMonitor*          pMonitor = nullptr;
     PHLWINDOWREF       pWindow;
 
+    uint64_t           readbackID = 0; // async shm readback in flight, ready is sent once it lands
+
+    CRegion            damage;     // reported to the client, in buffer coordinates of the client buffer
+    CRegion            copyRegion; // what has to be written into the client buffer, same coordinates
+
     bool               operator==(const SScreencopyFrame& other) const {
         return resource == other.resource && client == other.client;
     }
@@ -90,7 +122,9 @@ class CScreencopyProtocolManager {
     wlr_buffer*                    m_pLastMonitorBackBuffer = nullptr;
 
     void                           shareAllFrames(CMonitor* pMonitor);
+    bool                           prepareFrameDamage(SScreencopyFrame* frame);
     void                           shareFrame(SScreencopyFrame* frame);
+    void                           sendFrameReady(SScreencopyFrame* frame, const timespec& now);
     void                           sendFrameDamage(SScreencopyFrame* frame);
     bool                           copyFrameDmabuf(SScreencopyFrame* frame);
     bool                           copyFrameShm(SScreencopyFrame* frame, timespec* now);
@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "ToplevelExportWlrFuncs.hpp"
+#include "../render/AsyncReadback.hpp"
 
 #define TOPLEVEL_EXPORT_VERSION 2
 
@@ -129,6 +130,9 @@ void CToplevelExportProtocolManager::removeFrame(SScreencopyFrame* frame, bool f
 
     std::erase_if(m_vFramesAwaitingWrite, [&](const auto& other) { return other == frame; });
 
+    if (frame->readbackID && g_pAsyncReadback)
+        g_pAsyncReadback->cancel(frame->readbackID);
+
     wl_resource_set_user_data(frame->resource, nullptr);
     if (frame->buffer && frame->buffer->n_locks > 0)
         wlr_buffer_unlock(frame->buffer);
@@ -325,6 +329,12 @@ void CToplevelExportProtocolManager::onOutputCommit(CMonitor* pMonitor, wlr_outp
     }
 
     for (auto& f : framesToRemove) {
+        // still being read back, removed once the pixels land
+        if (f->readbackID) {
+            std::erase(m_vFramesAwaitingWrite, f);
+            continue;
+        }
+
         removeFrame(f);
     }
 }
@@ -336,7 +346,6 @@ void CToplevelExportProtocolManager::shareFrame(SScreencopyFrame* frame) {
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
-    uint32_t flags = 0;
     if (frame->bufferCap == WLR_BUFFER_CAP_DMABUF) {
         if (!copyFrameDmabuf(frame, &now)) {
             hyprland_toplevel_export_frame_v1_send_failed(frame->resource);
@@ -347,8 +356,16 @@ void CToplevelExportProtocolManager::shareFrame(SScreencopyFrame* frame) {
             hyprland_toplevel_export_frame_v1_send_failed(frame->resource);
             return;
         }
+
+        if (frame->readbackID)
+            return;
     }
 
+    sendFrameReady(frame, now);
+}
+
+void CToplevelExportProtocolManager::sendFrameReady(SScreencopyFrame* frame, const timespec& now) {
+    uint32_t flags = 0;
     hyprland_toplevel_export_frame_v1_send_flags(frame->resource, flags);
     sendDamage(frame);
     uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
@@ -374,7 +391,7 @@ bool CToplevelExportProtocolManager::copyFrameShm(SScreencopyFrame* frame, times
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer outFB;
+    CFramebuffer outFB{FB_CATEGORY_CAPTURE};
     outFB.alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, g_pHyprRenderer->isNvidia() ? DRM_FORMAT_XBGR8888 : PMONITOR->drmFormat);
 
     if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &outFB)) {
@@ -413,9 +430,31 @@ bool CToplevelExportProtocolManager::copyFrameShm(SScreencopyFrame* frame, times
     glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB.m_iFb);
 #endif
 
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    CAsyncReadback::SRequest request;
+    request.buffer    = frame->buffer;
+    request.width     = frame->box.width;
+    request.height    = frame->box.height;
+    request.drmFormat = format;
+    request.glFormat  = PFORMAT;
+    request.region    = CBox{0, 0, frame->box.width, frame->box.height};
+    request.onDone    = [this, frame, NOW = *now](bool success) {
+        frame->readbackID = 0;
+
+        if (success)
+            sendFrameReady(frame, NOW);
+        else
+            hyprland_toplevel_export_frame_v1_send_failed(frame->resource);
+
+        removeFrame(frame);
+    };
 
-    glReadPixels(0, 0, frame->box.width, frame->box.height, PFORMAT->glFormat, PFORMAT->glType, data);
+    frame->readbackID = g_pAsyncReadback->read(&outFB, std::move(request));
+
+    if (!frame->readbackID) {
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        glReadPixels(0, 0, frame->box.width, frame->box.height, PFORMAT->glFormat, PFORMAT->glType, data);
+    }
 
     wlr_buffer_end_data_ptr_access(frame->buffer);
 
@@ -33,6 +33,7 @@ class CToplevelExportProtocolManager {
     std::vector<SScreencopyFrame*> m_vFramesAwaitingWrite;
 
     void                           shareFrame(SScreencopyFrame* frame);
+    void                           sendFrameReady(SScreencopyFrame* frame, const timespec& now);
     bool                           copyFrameDmabuf(SScreencopyFrame* frame, timespec* now);
     bool                           copyFrameShm(SScreencopyFrame* frame, timespec* now);
     void                           sendDamage(SScreencopyFrame* frame);
@@ -0,0 +1,278 @@
+#include "AsyncReadback.hpp"
+#include "OpenGL.hpp"
+#include "Renderer.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../protocols/ToplevelExportWlrFuncs.hpp"
+
+#include <cstring>
+
+// a 4k frame is ~32MB, don't keep more than a few of these around
+constexpr size_t MAX_PIXEL_BUFFERS = 3;
+
+CAsyncReadback::CAsyncReadback() {
+    m_pPollTimer = std::make_shared<CEventLoopTimer>(std::nullopt, [this](std::shared_ptr<CEventLoopTimer> self, void* data) { poll(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_pPollTimer);
+
+#ifndef GLES2
+    m_tWorker = std::thread([this]() { workerThread(); });
+#endif
+}
+
+CAsyncReadback::~CAsyncReadback() {
+    g_pHyprRenderer->makeEGLCurrent();
+
+    if (m_tWorker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lg(m_mWorkerMutex);
+            m_bWorkerExit = true;
+        }
+        m_cvWorker.notify_one();
+        m_tWorker.join();
+    }
+
+    while (!m_lJobs.empty()) {
+        cancel(m_lJobs.front().id);
+    }
+
+    g_pEventLoopManager->removeTimer(m_pPollTimer);
+
+    for (auto& pb : m_vPixelBuffers) {
+        glDeleteBuffers(1, &pb.id);
+    }
+}
+
+uint64_t CAsyncReadback::read(CFramebuffer* fb, SRequest&& request) {
+#ifdef GLES2
+    return 0;
+#else
+    const auto PFMTINFO = drm_get_pixel_format_info(request.drmFormat);
+    if (!PFMTINFO || pixel_format_info_pixels_per_block(PFMTINFO) != 1 || !request.glFormat || !request.buffer)
+        return 0;
+
+    const size_t PACKSTRIDE = pixel_format_info_min_stride(PFMTINFO, request.width);
+    const size_t SIZE       = PACKSTRIDE * request.height;
+    const size_t BPP        = PFMTINFO->bytes_per_block;
+    const auto   RECTS      = request.region.getRects();
+
+    // find a free pixel buffer, prefer one that's big enough already
+    SPixelBuffer* pb    = nullptr;
+    size_t        index = 0;
+    for (size_t i = 0; i < m_vPixelBuffers.size(); ++i) {
+        auto& other = m_vPixelBuffers[i];
+
+        if (other.busy || (pb && pb->size >= SIZE))
+            continue;
+
+        pb    = &other;
+        index = i;
+    }
+
+    if (!pb) {
+        // all busy, the caller reads synchronously instead
+        if (m_vPixelBuffers.size() >= MAX_PIXEL_BUFFERS)
+            return 0;
+
+        pb = &m_vPixelBuffers.emplace_back();
+        glGenBuffers(1, &pb->id);
+        index = m_vPixelBuffers.size() - 1;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pb->id);
+
+    if (pb->size < SIZE) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, SIZE, nullptr, GL_STREAM_READ);
+        pb->size = SIZE;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->m_iFb);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, request.width);
+
+    // with a pack buffer bound, these only queue the transfers. Each rect lands where it would in a tightly packed frame.
+    for (auto& RECT : RECTS) {
+        const auto OFFSET = RECT.y1 * PACKSTRIDE + RECT.x1 * BPP;
+        glReadPixels(RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1, request.glFormat->glFormat, request.glFormat->glType, (void*)OFFSET);
+    }
+
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    const auto FENCE = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!FENCE)
+        return 0;
+
+    pb->busy = true;
+
+    auto& job      = m_lJobs.emplace_back();
+    job.id         = m_iNextID++;
+    job.request    = std::move(request);
+    job.pbo        = index;
+    job.packStride = PACKSTRIDE;
+    job.bpp        = BPP;
+    job.rects      = RECTS;
+    job.fence      = FENCE;
+
+    m_pPollTimer->updateTimeout(std::chrono::milliseconds(1));
+
+    return job.id;
+#endif
+}
+
+void CAsyncReadback::cancel(uint64_t id) {
+    const auto IT = std::find_if(m_lJobs.begin(), m_lJobs.end(), [id](const auto& job) { return job.id == id; });
+
+    if (IT == m_lJobs.end())
+        return;
+
+    if (IT->state == JOB_COPYING) {
+        // the worker might be writing to the client's buffer right now, it has to be done before the caller drops it
+        std::unique_lock<std::mutex> lk(m_mWorkerMutex);
+        std::erase(m_vWorkerQueue, &*IT);
+        m_cvCopied.wait(lk, [&]() { return m_pWorkerJob != &*IT; });
+    }
+
+    IT->request.onDone = nullptr;
+    finishJob(*IT, false);
+}
+
+void CAsyncReadback::poll() {
+#ifndef GLES2
+    if (m_lJobs.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // ids, not pointers: finishing a job runs its callback, which may cancel the others
+    std::vector<uint64_t> done;
+
+    for (auto& job : m_lJobs) {
+        if (job.state == JOB_COPYING) {
+            if (job.copied)
+                done.push_back(job.id);
+            continue;
+        }
+
+        const auto RESULT = glClientWaitSync(job.fence, 0, 0);
+
+        if (RESULT == GL_TIMEOUT_EXPIRED)
+            continue;
+
+        glDeleteSync(job.fence);
+        job.fence = nullptr;
+
+        if (RESULT == GL_WAIT_FAILED) {
+            done.push_back(job.id);
+            continue;
+        }
+
+        uint32_t format;
+        if (!wlr_buffer_begin_data_ptr_access(job.request.buffer, WLR_BUFFER_DATA_PTR_ACCESS_WRITE, &job.dst, &format, &job.dstStride)) {
+            job.dst = nullptr;
+            done.push_back(job.id);
+            continue;
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_vPixelBuffers[job.pbo].id);
+        job.src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, job.packStride * job.request.height, GL_MAP_READ_BIT);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (!job.src) {
+            done.push_back(job.id);
+            continue;
+        }
+
+        job.state = JOB_COPYING;
+
+        {
+            std::lock_guard<std::mutex> lg(m_mWorkerMutex);
+            m_vWorkerQueue.push_back(&job);
+        }
+        m_cvWorker.notify_one();
+    }
+
+    for (const auto& ID : done) {
+        const auto IT = std::find_if(m_lJobs.begin(), m_lJobs.end(), [ID](const auto& job) { return job.id == ID; });
+
+        if (IT == m_lJobs.end())
+            continue;
+
+        finishJob(*IT, IT->copied);
+    }
+
+    if (!m_lJobs.empty())
+        m_pPollTimer->updateTimeout(std::chrono::milliseconds(1));
+#endif
+}
+
+void CAsyncReadback::finishJob(SJob& job, bool success) {
+#ifndef GLES2
+    g_pHyprRenderer->makeEGLCurrent();
+
+    if (job.fence)
+        glDeleteSync(job.fence);
+
+    if (job.src) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_vPixelBuffers[job.pbo].id);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+#endif
+
+    if (job.dst)
+        wlr_buffer_end_data_ptr_access(job.request.buffer);
+
+    m_vPixelBuffers[job.pbo].busy = false;
+
+    // the callback is allowed to cancel other readbacks, don't keep any references into the list
+    const auto CALLBACK = std::move(job.request.onDone);
+    const auto ID       = job.id;
+    std::erase_if(m_lJobs, [ID](const auto& other) { return other.id == ID; });
+
+    if (CALLBACK)
+        CALLBACK(success);
+}
+
+void CAsyncReadback::workerThread() {
+    while (true) {
+        SJob* job = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lk(m_mWorkerMutex);
+            m_cvWorker.wait(lk, [this]() { return m_bWorkerExit || !m_vWorkerQueue.empty(); });
+
+            if (m_bWorkerExit)
+                return;
+
+            job = m_vWorkerQueue.front();
+            m_vWorkerQueue.erase(m_vWorkerQueue.begin());
+            m_pWorkerJob = job;
+        }
+
+        const auto SRC = (const uint8_t*)job->src;
+        const auto DST = (uint8_t*)job->dst;
+
+        for (auto& RECT : job->rects) {
+            const size_t X   = RECT.x1 * job->bpp;
+            const size_t LEN = (RECT.x2 - RECT.x1) * job->bpp;
+
+            if (job->packStride == job->dstStride && LEN == job->packStride) {
+                memcpy(DST + RECT.y1 * job->dstStride, SRC + RECT.y1 * job->packStride, LEN * (RECT.y2 - RECT.y1));
+                continue;
+            }
+
+            for (int y = RECT.y1; y < RECT.y2; ++y) {
+                memcpy(DST + y * job->dstStride + X, SRC + y * job->packStride + X, LEN);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(m_mWorkerMutex);
+            job->copied  = true;
+            m_pWorkerJob = nullptr;
+        }
+        m_cvCopied.notify_all();
+    }
+}
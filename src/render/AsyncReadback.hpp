@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Region.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+class CFramebuffer;
+class CEventLoopTimer;
+struct SGLPixelFormat;
+
+/*
+    Reads framebuffers back into shm buffers without stalling the main thread.
+    The pixels are read into a pixel buffer object, the transfer is waited on with a fence
+    from the event loop, and the (possibly strided) copy into the client buffer happens on a worker thread.
+    Not available on the legacy GLES2 renderer, callers are expected to fall back to glReadPixels.
+*/
+class CAsyncReadback {
+  public:
+    CAsyncReadback();
+    ~CAsyncReadback();
+
+    struct SRequest {
+        wlr_buffer*                       buffer    = nullptr; // kept locked by the caller until onDone or cancel
+        int                               width     = 0;
+        int                               height    = 0;
+        uint32_t                          drmFormat = 0;
+        const SGLPixelFormat*             glFormat  = nullptr;
+        CRegion                           region; // parts of the buffer to read, in buffer coordinates
+        std::function<void(bool success)> onDone; // called on the main thread, not called if cancelled
+    };
+
+    // Starts reading the given framebuffer. The EGL context has to be current.
+    // Returns 0 if the readback can't be done asynchronously right now, an id to cancel() it otherwise.
+    uint64_t read(CFramebuffer* fb, SRequest&& request);
+
+    // Drops a readback. Waits for the worker if it's writing to the buffer already.
+    void     cancel(uint64_t id);
+
+  private:
+    enum eJobState {
+        JOB_WAITING_FENCE = 0,
+        JOB_COPYING,
+    };
+
+    struct SPixelBuffer {
+        GLuint id   = 0;
+        size_t size = 0;
+        bool   busy = false;
+    };
+
+    struct SJob {
+        uint64_t                    id = 0;
+        SRequest                    request;
+        size_t                      pbo        = 0;
+        size_t                      packStride = 0;
+        size_t                      bpp        = 0;
+        std::vector<pixman_box32_t> rects;
+        eJobState                   state = JOB_WAITING_FENCE;
+#ifndef GLES2
+        GLsync fence = nullptr;
+#endif
+
+        // set once the buffer is being written to
+        void*             dst       = nullptr;
+        size_t            dstStride = 0;
+        const void*       src       = nullptr;
+        std::atomic<bool> copied    = false;
+    };
+
+    void                             poll();
+    void                             finishJob(SJob& job, bool success);
+    void                             workerThread();
+
+    std::vector<SPixelBuffer>        m_vPixelBuffers;
+    std::list<SJob>                  m_lJobs;
+    uint64_t                         m_iNextID = 1;
+
+    std::shared_ptr<CEventLoopTimer> m_pPollTimer;
+
+    std::thread                      m_tWorker;
+    std::mutex                       m_mWorkerMutex;
+    std::condition_variable          m_cvWorker;
+    std::condition_variable          m_cvCopied;
+    std::vector<SJob*>               m_vWorkerQueue;
+    SJob*                            m_pWorkerJob  = nullptr; // being copied right now
+    bool                             m_bWorkerExit = false;
+};
+
+inline std::unique_ptr<CAsyncReadback> g_pAsyncReadback;
@@ -1,34 +1,46 @@
 #include "Framebuffer.hpp"
 #include "OpenGL.hpp"
 
+CFramebuffer::CFramebuffer(eFramebufferCategory category) : m_eCategory(category) {
+    ;
+}
+
 bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
-    bool firstAlloc = false;
     RASSERT((w > 1 && h > 1), "cannot alloc a FB with negative / zero size! (attempted {}x{})", w, h);
 
     uint32_t glFormat = drmFormatToGL(drmFormat);
     uint32_t glType   = glFormatToType(glFormat);
 
-    if (m_iFb == (uint32_t)-1) {
-        firstAlloc = true;
-        glGenFramebuffers(1, &m_iFb);
-    }
+    // pooled buffers keep their size and format, one that doesn't fit anymore goes back for another
+    if (m_iBytes && (m_vSize != Vector2D(w, h) || m_iDrmFormat != drmFormat))
+        release();
 
-    if (m_cTex.m_iTexID == 0) {
-        firstAlloc = true;
-        glGenTextures(1, &m_cTex.m_iTexID);
-        glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    }
+    if (!m_iBytes) {
+        const auto POOLED = g_pFramebufferPool->take(w, h, drmFormat);
+
+        if (POOLED) {
+            m_iFb           = POOLED->fb;
+            m_cTex.m_iTexID = POOLED->tex;
+        } else {
+            glGenFramebuffers(1, &m_iFb);
+
+            glGenTextures(1, &m_cTex.m_iTexID);
+            glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, glFormat, w, h, 0, GL_RGBA, glType, 0);
+
+            glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_cTex.m_iTexID, 0);
+        }
 
-    if (firstAlloc || m_vSize != Vector2D(w, h)) {
-        glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
-        glTexImage2D(GL_TEXTURE_2D, 0, glFormat, w, h, 0, GL_RGBA, glType, 0);
+        m_iBytes     = CFramebufferPool::bytesFor(w, h);
+        m_iDrmFormat = drmFormat;
+        g_pFramebufferPool->add(m_eCategory, m_iBytes);
 
         glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_cTex.m_iTexID, 0);
 
 // TODO: Allow this with gles2
 #ifndef GLES2
@@ -45,7 +57,7 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
         auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
         RASSERT((status == GL_FRAMEBUFFER_COMPLETE), "Framebuffer incomplete, couldn't create! (FB status: {}, GL Error: 0x{:x})", status, (int)glGetError());
 
-        Debug::log(LOG, "Framebuffer created, status {}", status);
+        Debug::log(LOG, "Framebuffer {}, status {}", POOLED ? "reused" : "created", status);
     }
 
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -84,15 +96,28 @@ void CFramebuffer::bind() {
 }
 
 void CFramebuffer::release() {
-    if (m_iFb != (uint32_t)-1 && m_iFb)
-        glDeleteFramebuffers(1, &m_iFb);
+    if (m_iBytes && g_pFramebufferPool) {
+        // the stencil belongs to a monitor, whoever gets this next attaches their own
+#ifndef GLES2
+        glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, g_pHyprOpenGL->m_iCurrentOutputFb);
+#endif
+
+        g_pFramebufferPool->remove(m_eCategory, m_iBytes);
+        g_pFramebufferPool->give({m_iFb, m_cTex.m_iTexID, (int)m_vSize.x, (int)m_vSize.y, m_iDrmFormat, m_iBytes});
+    } else {
+        if (m_iFb != (uint32_t)-1 && m_iFb)
+            glDeleteFramebuffers(1, &m_iFb);
 
-    if (m_cTex.m_iTexID)
-        glDeleteTextures(1, &m_cTex.m_iTexID);
+        if (m_cTex.m_iTexID)
+            glDeleteTextures(1, &m_cTex.m_iTexID);
+    }
 
     m_cTex.m_iTexID = 0;
     m_iFb           = -1;
     m_vSize         = Vector2D();
+    m_iBytes        = 0;
 }
 
 CFramebuffer::~CFramebuffer() {
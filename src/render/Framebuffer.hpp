@@ -2,9 +2,11 @@
 
 #include "../defines.hpp"
 #include "Texture.hpp"
+#include "FramebufferPool.hpp"
 
 class CFramebuffer {
   public:
+    CFramebuffer(eFramebufferCategory category = FB_CATEGORY_OTHER);
     ~CFramebuffer();
 
     bool      alloc(int w, int h, uint32_t format = GL_RGBA);
@@ -20,4 +22,12 @@ class CFramebuffer {
     GLuint    m_iFb = -1;
 
     CTexture* m_pStencilTex = nullptr;
+
+    // what its memory is accounted as in g_pFramebufferPool, set before alloc()
+    eFramebufferCategory m_eCategory;
+
+  private:
+    // taken from g_pFramebufferPool by alloc(), 0 if allocated elsewhere
+    size_t   m_iBytes     = 0;
+    uint32_t m_iDrmFormat = 0;
 };
\ No newline at end of file
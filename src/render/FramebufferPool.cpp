@@ -0,0 +1,101 @@
+#include "FramebufferPool.hpp"
+#include "../Compositor.hpp"
+#include "../config/ConfigValue.hpp"
+
+// long enough for the next window to close or the next screencopy frame, short enough not to sit on a resized monitor's old buffers
+constexpr std::chrono::seconds FREE_BUFFER_TIMEOUT{10};
+// a monitor sized buffer is ~33MB at 4K
+constexpr size_t MAX_FREE_BUFFERS = 4;
+
+CFramebufferPool::~CFramebufferPool() {
+    clear();
+}
+
+std::optional<CFramebufferPool::SBuffer> CFramebufferPool::take(int w, int h, uint32_t drmFormat) {
+    const auto IT = std::find_if(m_lFree.begin(), m_lFree.end(), [&](const auto& f) { return f.buffer.w == w && f.buffer.h == h && f.buffer.drmFormat == drmFormat; });
+
+    if (IT == m_lFree.end()) {
+        m_iCreated++;
+        return {};
+    }
+
+    SBuffer buffer = IT->buffer;
+    m_iFreeBytes -= buffer.bytes;
+    m_lFree.erase(IT);
+
+    m_iReused++;
+    return buffer;
+}
+
+void CFramebufferPool::give(SBuffer&& buffer) {
+    m_iFreeBytes += buffer.bytes;
+    m_lFree.emplace_front(SFree{buffer, std::chrono::steady_clock::now()});
+
+    trim();
+}
+
+void CFramebufferPool::add(eFramebufferCategory category, size_t bytes) {
+    m_aBytes[category] += bytes;
+}
+
+void CFramebufferPool::remove(eFramebufferCategory category, size_t bytes) {
+    m_aBytes[category] -= std::min(bytes, m_aBytes[category]);
+}
+
+size_t CFramebufferPool::budget() const {
+    static auto PBUDGET = CConfigValue<Hyprlang::INT>("opengl:memory_budget");
+
+    return (size_t)std::max(*PBUDGET, (Hyprlang::INT)0) * 1024 * 1024;
+}
+
+size_t CFramebufferPool::totalBytes() const {
+    size_t total = m_iFreeBytes;
+    for (const auto& b : m_aBytes) {
+        total += b;
+    }
+    return total;
+}
+
+bool CFramebufferPool::overBudget() const {
+    const auto BUDGET = budget();
+    return BUDGET && totalBytes() > BUDGET;
+}
+
+void CFramebufferPool::trim() {
+    const auto NOW = std::chrono::steady_clock::now();
+
+    while (!m_lFree.empty() && (m_lFree.size() > MAX_FREE_BUFFERS || NOW - m_lFree.back().released > FREE_BUFFER_TIMEOUT || overBudget())) {
+        m_iFreeBytes -= m_lFree.back().buffer.bytes;
+        destroy(m_lFree.back().buffer);
+        m_lFree.pop_back();
+    }
+}
+
+void CFramebufferPool::clear() {
+    if (m_lFree.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    for (auto& f : m_lFree) {
+        destroy(f.buffer);
+    }
+
+    m_lFree.clear();
+    m_iFreeBytes = 0;
+}
+
+void CFramebufferPool::destroy(SBuffer& buffer) {
+    glDeleteFramebuffers(1, &buffer.fb);
+    glDeleteTextures(1, &buffer.tex);
+
+    m_iDeleted++;
+}
+
+size_t CFramebufferPool::bytesFor(int w, int h) {
+    return (size_t)w * h * 4;
+}
+
+CFramebufferPool::SStats CFramebufferPool::stats() const {
+    return SStats{m_aBytes, m_iFreeBytes, m_lFree.size(), m_iReused, m_iCreated, m_iDeleted, budget()};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <array>
+#include <chrono>
+#include <list>
+#include <optional>
+
+enum eFramebufferCategory {
+    FB_CATEGORY_OTHER = 0, // plugins and anything else
+    FB_CATEGORY_MONITOR,   // offload, output mirroring and the background
+    FB_CATEGORY_EFFECT,    // blur, shadow mattes and off-main passes
+    FB_CATEGORY_SNAPSHOT,  // closing windows and layers
+    FB_CATEGORY_CAPTURE,   // screencopy and toplevel export
+    FB_CATEGORY_END,
+};
+
+/*
+    Color buffers of every CFramebuffer::alloc(), with how much GPU memory each category takes.
+    Released buffers are kept for a while and handed to the next alloc() of the exact same size and format,
+    e.g. the snapshot of the next window to close or the next screencopy frame, instead of going through glTexImage2D again.
+    Everything counts towards opengl:memory_budget, the free buffers are the first to go when it's exceeded.
+*/
+class CFramebufferPool {
+  public:
+    ~CFramebufferPool();
+
+    struct SBuffer {
+        GLuint   fb        = 0;
+        GLuint   tex       = 0;
+        int      w         = 0;
+        int      h         = 0;
+        uint32_t drmFormat = 0;
+        size_t   bytes     = 0;
+    };
+
+    // a free buffer of exactly that size and format, if there is one
+    std::optional<SBuffer> take(int w, int h, uint32_t drmFormat);
+    // keeps a buffer that's no longer used, or deletes it if it doesn't fit
+    void give(SBuffer&& buffer);
+
+    // buffers in use, accounted by whoever allocated them
+    void add(eFramebufferCategory category, size_t bytes);
+    void remove(eFramebufferCategory category, size_t bytes);
+
+    // bytes, 0 for none
+    size_t budget() const;
+    // in use and free
+    size_t totalBytes() const;
+    bool   overBudget() const;
+
+    // deletes free buffers that have been unused for a while, and then the oldest ones until the pool fits the budget
+    void trim();
+    void clear();
+
+    // every format alloc() takes is 32 bits per pixel
+    static size_t bytesFor(int w, int h);
+
+    struct SStats {
+        std::array<size_t, FB_CATEGORY_END> bytes     = {}; // in use
+        size_t                              freeBytes = 0;
+        size_t                              freeCount = 0;
+        uint64_t                            reused    = 0; // alloc()s that got a free buffer
+        uint64_t                            created   = 0; // and those that didn't
+        uint64_t                            deleted   = 0;
+        size_t                              budget    = 0;
+    };
+
+    SStats stats() const;
+
+  private:
+    struct SFree {
+        SBuffer                               buffer;
+        std::chrono::steady_clock::time_point released;
+    };
+
+    void                                destroy(SBuffer& buffer);
+
+    std::list<SFree>                    m_lFree; // most recently released first
+    std::array<size_t, FB_CATEGORY_END> m_aBytes     = {};
+    size_t                              m_iFreeBytes = 0;
+    uint64_t                            m_iReused    = 0;
+    uint64_t                            m_iCreated   = 0;
+    uint64_t                            m_iDeleted   = 0;
+};
+
+inline std::unique_ptr<CFramebufferPool> g_pFramebufferPool;
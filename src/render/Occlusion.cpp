@@ -0,0 +1,271 @@
+#include "Occlusion.hpp"
+#include "../Compositor.hpp"
+#include "../config/ConfigValue.hpp"
+
+void COcclusion::build(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+    static auto PBLUR        = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+    static auto PBLURSPECIAL = CConfigValue<Hyprlang::INT>("decoration:blur:special");
+
+    reset();
+
+    // regions can't follow rotations, better to cull nothing than the wrong parts
+    if (!g_pHyprOpenGL->m_RenderData.renderModif.isTranslateScale())
+        return;
+
+    m_pMonitor = pMonitor;
+    m_bBuilt   = true;
+
+    // front to back, the reverse of renderAllClientsForWorkspace. Layer popups, IME popups and the drag icon are drawn above everything and never culled.
+    const auto& OVERLAY = pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY];
+    for (auto it = OVERLAY.rbegin(); it != OVERLAY.rend(); ++it) {
+        visitLayer(*it);
+    }
+
+    const auto& TOP = pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_TOP];
+    for (auto it = TOP.rbegin(); it != TOP.rend(); ++it) {
+        visitLayer(*it);
+    }
+
+    const auto PINNED = g_pHyprRenderer->getPinnedWindowDraws(pMonitor);
+    for (auto it = PINNED.rbegin(); it != PINNED.rend(); ++it) {
+        visitWindow(it->window, it->mode != RENDER_PASS_POPUP, it->mode != RENDER_PASS_MAIN);
+    }
+
+    std::vector<PHLWORKSPACE> specials;
+    bool                      specialBlur = false;
+    for (auto& ws : g_pCompositor->m_vWorkspaces) {
+        if (ws->m_fAlpha.value() > 0.f && ws->m_bIsSpecialWorkspace)
+            specials.push_back(ws);
+
+        if (ws->m_iMonitorID == pMonitor->ID && ws->m_fAlpha.value() > 0.f && ws->m_bIsSpecialWorkspace)
+            specialBlur = *PBLURSPECIAL && *PBLUR;
+    }
+
+    for (auto ws = specials.rbegin(); ws != specials.rend(); ++ws) {
+        const auto DRAWS = g_pHyprRenderer->getWorkspaceWindowDraws(pMonitor, *ws);
+        for (auto it = DRAWS.rbegin(); it != DRAWS.rend(); ++it) {
+            visitWindow(it->window, it->mode != RENDER_PASS_POPUP, it->mode != RENDER_PASS_MAIN);
+        }
+    }
+
+    // the special workspace's blur covers the whole monitor
+    if (specialBlur) {
+        CRegion monitor = CBox{{}, pMonitor->vecTransformedSize};
+        g_pHyprOpenGL->m_RenderData.renderModif.applyToRegion(monitor);
+        readsBelow(monitor.subtract(m_rOpaque));
+    }
+
+    const auto DRAWS = g_pHyprRenderer->getWorkspaceWindowDraws(pMonitor, pWorkspace);
+    for (auto it = DRAWS.rbegin(); it != DRAWS.rend(); ++it) {
+        visitWindow(it->window, it->mode != RENDER_PASS_POPUP, it->mode != RENDER_PASS_MAIN);
+    }
+
+    // the blur framebuffer is made from everything below the windows, so it all has to be drawn when it's rendered
+    if (g_pHyprOpenGL->m_RenderData.pCurrentMonData->blurFBShouldRender)
+        return;
+
+    const auto& BOTTOM = pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM];
+    for (auto it = BOTTOM.rbegin(); it != BOTTOM.rend(); ++it) {
+        visitLayer(*it);
+    }
+
+    const auto& BACKGROUND = pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND];
+    for (auto it = BACKGROUND.rbegin(); it != BACKGROUND.rend(); ++it) {
+        visitLayer(*it);
+    }
+
+    m_rBackground = m_rOpaque;
+}
+
+void COcclusion::reset() {
+    m_pMonitor = nullptr;
+    m_bBuilt   = false;
+    m_rOpaque.clear();
+    m_rBackground.clear();
+    m_mWindows.clear();
+    m_mWindowPopups.clear();
+    m_mLayers.clear();
+}
+
+void COcclusion::visitWindow(PHLWINDOW pWindow, bool main, bool popups) {
+    static auto PBLUR       = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+    static auto PBLURPOPUPS = CConfigValue<Hyprlang::INT>("decoration:blur:popups");
+
+    // a window drawn twice is culled by what's above its top-most draw
+    auto& map = main ? m_mWindows : m_mWindowPopups;
+    if (map.contains(pWindow.get()))
+        return;
+
+    const auto PWORKSPACE = pWindow->m_pWorkspace;
+    const auto POS        = pWindow->m_vRealPosition.value() + pWindow->m_vFloatingOffset + (pWindow->m_bPinned || !PWORKSPACE ? Vector2D{} : PWORKSPACE->m_vRenderOffset.value());
+    const auto SIZE       = pWindow->m_vRealSize.value();
+    const bool MAPPED     = pWindow->m_bIsMapped && !pWindow->m_bFadingOut && !pWindow->isHidden();
+
+    // popups are drawn after the window, so they're visited first
+    if (popups && MAPPED && !pWindow->m_bIsX11) {
+        CBox geom;
+        wlr_xdg_surface_get_geometry(pWindow->m_uSurface.xdg, geom.pWlr());
+        geom.applyFromWlr();
+
+        std::vector<CBox> boxes;
+        wlr_xdg_surface_for_each_popup_surface(
+            pWindow->m_uSurface.xdg, [](wlr_surface* s, int x, int y, void* data) { ((std::vector<CBox>*)data)->emplace_back(x, y, s->current.width, s->current.height); },
+            &boxes);
+
+        CRegion drawn;
+        for (auto& box : boxes) {
+            drawn.add(outer(box.translate(POS - geom.pos())));
+        }
+
+        if (!main)
+            map[pWindow.get()] = {m_rOpaque, drawn};
+
+        if (*PBLUR && *PBLURPOPUPS)
+            readsBelow(drawn.subtract(m_rOpaque));
+    }
+
+    if (!main)
+        return;
+
+    CRegion drawn = outer(pWindow->getFullWindowBoundingBox().translate(POS - pWindow->m_vRealPosition.value()));
+
+    map[pWindow.get()] = {m_rOpaque, drawn};
+
+    drawn.subtract(m_rOpaque);
+
+    // the rounded corners aren't opaque
+    const auto ROUNDING = pWindow->rounding();
+    CRegion    opaque;
+
+    if (MAPPED && PWORKSPACE && pWindow->m_vTransformers.empty() && pWindow->opaque() && SIZE.x > ROUNDING * 2 && SIZE.y > ROUNDING * 2) {
+        opaque.add(inner({POS.x + ROUNDING, POS.y, SIZE.x - ROUNDING * 2, SIZE.y}));
+        opaque.add(inner({POS.x, POS.y + ROUNDING, SIZE.x, SIZE.y - ROUNDING * 2}));
+        m_rOpaque.add(opaque);
+    }
+
+    if (*PBLUR && !pWindow->m_sAdditionalConfigData.forceNoBlur)
+        readsBelow(drawn.subtract(opaque));
+}
+
+void COcclusion::visitLayer(PHLLS pLayer) {
+    static auto PBLUR = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+
+    if (m_mLayers.contains(pLayer.get()))
+        return;
+
+    const auto POS  = pLayer->realPosition.value();
+    const auto SIZE = pLayer->realSize.value();
+
+    CRegion    drawn = outer({POS, SIZE});
+
+    m_mLayers[pLayer.get()] = {m_rOpaque, drawn};
+
+    drawn.subtract(m_rOpaque);
+
+    CRegion    opaque;
+    const auto PSURFACE = pLayer->layerSurface ? pLayer->layerSurface->surface : nullptr;
+
+    // a resizing layer is stretched, its opaque region doesn't line up with what's drawn
+    if (PSURFACE && pLayer->mapped && !pLayer->fadingOut && pLayer->alpha.value() == 1.f && Vector2D(PSURFACE->current.width, PSURFACE->current.height) == SIZE) {
+        if (PSURFACE->opaque)
+            opaque.add(inner({POS, SIZE}));
+        else {
+            for (auto& rect : CRegion{&PSURFACE->opaque_region}.getRects()) {
+                opaque.add(inner({POS.x + rect.x1, POS.y + rect.y1, (double)rect.x2 - rect.x1, (double)rect.y2 - rect.y1}));
+            }
+        }
+
+        m_rOpaque.add(opaque);
+    }
+
+    if (*PBLUR && pLayer->forceBlur)
+        readsBelow(drawn.subtract(opaque));
+}
+
+void COcclusion::readsBelow(CRegion visible) {
+    static auto PBLURSIZE   = CConfigValue<Hyprlang::INT>("decoration:blur:size");
+    static auto PBLURPASSES = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
+
+    if (visible.empty())
+        return;
+
+    // blur samples this far around what it covers, which has to be drawn below it
+    const auto BLURRADIUS = *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES);
+    wlr_region_expand(visible.pixman(), visible.pixman(), BLURRADIUS);
+
+    m_rOpaque.subtract(visible);
+}
+
+CRegion COcclusion::inner(CBox box) {
+    box.translate(-m_pMonitor->vecPosition).scale(m_pMonitor->scale);
+    g_pHyprOpenGL->m_RenderData.renderModif.applyToBox(box);
+
+    const double X1 = std::ceil(box.x), Y1 = std::ceil(box.y), X2 = std::floor(box.x + box.w), Y2 = std::floor(box.y + box.h);
+
+    if (X2 <= X1 || Y2 <= Y1)
+        return {};
+
+    return CRegion{X1, Y1, X2 - X1, Y2 - Y1};
+}
+
+CRegion COcclusion::outer(CBox box) {
+    box.translate(-m_pMonitor->vecPosition).scale(m_pMonitor->scale);
+    g_pHyprOpenGL->m_RenderData.renderModif.applyToBox(box);
+
+    const double X1 = std::floor(box.x), Y1 = std::floor(box.y), X2 = std::ceil(box.x + box.w), Y2 = std::ceil(box.y + box.h);
+
+    return CRegion{X1, Y1, X2 - X1, Y2 - Y1};
+}
+
+void COcclusion::occlude(CRegion& damage, PHLWINDOW pWindow, bool popups) {
+    if (!m_bBuilt)
+        return;
+
+    const auto& MAP = popups ? m_mWindowPopups : m_mWindows;
+    const auto  IT  = MAP.find(pWindow.get());
+
+    if (IT != MAP.end())
+        occlude(damage, IT->second);
+}
+
+void COcclusion::occlude(CRegion& damage, PHLLS pLayer) {
+    if (!m_bBuilt)
+        return;
+
+    const auto IT = m_mLayers.find(pLayer.get());
+
+    if (IT != m_mLayers.end())
+        occlude(damage, IT->second);
+}
+
+void COcclusion::occludeBackground(CRegion& damage) {
+    if (!m_bBuilt)
+        return;
+
+    occlude(damage, SHidden{m_rBackground, CBox{{}, m_pMonitor->vecTransformedSize}});
+}
+
+void COcclusion::occlude(CRegion& damage, const SHidden& hidden) {
+    // snapshots and anything drawing to another monitor in the meantime aren't part of the frame
+    if (g_pHyprOpenGL->m_RenderData.pMonitor != m_pMonitor || g_pHyprRenderer->m_bRenderingSnapshot || hidden.hidden.empty())
+        return;
+
+    auto& frame = m_mFrames[m_pMonitor->ID];
+
+    for (auto& rect : damage.copy().intersect(hidden.hidden).intersect(hidden.drawn).getRects()) {
+        frame.culledPixels += (uint64_t)(rect.x2 - rect.x1) * (rect.y2 - rect.y1);
+    }
+
+    if (!hidden.drawn.empty() && hidden.drawn.copy().subtract(hidden.hidden).empty())
+        frame.hidden++;
+
+    damage.subtract(hidden.hidden);
+}
+
+void COcclusion::beginFrame(CMonitor* pMonitor) {
+    m_mFrames[pMonitor->ID] = {};
+}
+
+const std::unordered_map<int, COcclusion::SFrameInfo>& COcclusion::frames() const {
+    return m_mFrames;
+}
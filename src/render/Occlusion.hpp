@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Region.hpp"
+#include <unordered_map>
+
+class CMonitor;
+class CWindow;
+class CLayerSurface;
+
+/*
+    What each window, popup and layer surface can skip drawing because opaque surfaces drawn after it cover it.
+    Built front to back once per renderAllClientsForWorkspace, walking the same draws in reverse, so nothing is ever culled by what's below it.
+    Anything that blurs what's below it makes that area (plus the blur radius) visible again for whatever is under it.
+*/
+class COcclusion {
+  public:
+    // with the render modif renderAllClientsForWorkspace draws with
+    void build(CMonitor* pMonitor, PHLWORKSPACE pWorkspace);
+    // nothing is culled until the next build()
+    void reset();
+
+    // subtract what's hidden from the damage, the caller restores it after drawing
+    void occlude(CRegion& damage, PHLWINDOW pWindow, bool popups);
+    void occlude(CRegion& damage, PHLLS pLayer);
+    void occludeBackground(CRegion& damage);
+
+    // starts a new frame's stats for the monitor
+    void beginFrame(CMonitor* pMonitor);
+
+    struct SFrameInfo {
+        uint64_t culledPixels = 0; // damaged pixels that weren't drawn because they were covered
+        size_t   hidden       = 0; // windows, popups and layers that were covered entirely
+    };
+
+    // the last frame per monitor ID
+    const std::unordered_map<int, SFrameInfo>& frames() const;
+
+  private:
+    struct SHidden {
+        CRegion hidden; // covered by opaque surfaces above, monitor pixels
+        CRegion drawn;  // what it draws to, for the stats
+    };
+
+    CMonitor*                                   m_pMonitor = nullptr;
+    CRegion                                     m_rOpaque; // while building, what's covered by everything visited so far
+    CRegion                                     m_rBackground;
+    bool                                        m_bBuilt = false;
+
+    std::unordered_map<CWindow*, SHidden>       m_mWindows;
+    std::unordered_map<CWindow*, SHidden>       m_mWindowPopups;
+    std::unordered_map<CLayerSurface*, SHidden> m_mLayers;
+    std::unordered_map<int, SFrameInfo>         m_mFrames;
+
+    void                                        visitWindow(PHLWINDOW pWindow, bool main, bool popups);
+    void                                        visitLayer(PHLLS pLayer);
+    void                                        readsBelow(CRegion visible);
+    void                                        occlude(CRegion& damage, const SHidden& hidden);
+
+    // logical, global boxes to monitor pixels. inner() only has the pixels the box covers entirely.
+    CRegion                                     inner(CBox box);
+    CRegion                                     outer(CBox box);
+};
@@ -7,6 +7,11 @@
 #include "../config/ConfigValue.hpp"
 #include "../desktop/LayerSurface.hpp"
 
+// nothing has blurred, built a shadow matte or rendered off main for this long
+constexpr float EFFECT_FB_IDLE_SECONDS = 5.f;
+// snapshots drawn more recently than this are still fading out, or about to
+constexpr int SNAPSHOT_IDLE_MS = 1000;
+
 inline void loadGLProc(void* pProc, const char* name) {
     void* proc = (void*)eglGetProcAddress(name);
     if (proc == NULL) {
@@ -286,20 +291,20 @@ void CHyprOpenGLImpl::begin(CMonitor* pMonitor, const CRegion& damage_, CFramebu
     if (m_RenderData.pCurrentMonData->offloadFB.m_vSize != pMonitor->vecPixelSize) {
         m_RenderData.pCurrentMonData->stencilTex.allocate();
 
-        m_RenderData.pCurrentMonData->offloadFB.m_pStencilTex    = &m_RenderData.pCurrentMonData->stencilTex;
-        m_RenderData.pCurrentMonData->mirrorFB.m_pStencilTex     = &m_RenderData.pCurrentMonData->stencilTex;
-        m_RenderData.pCurrentMonData->mirrorSwapFB.m_pStencilTex = &m_RenderData.pCurrentMonData->stencilTex;
-        m_RenderData.pCurrentMonData->offMainFB.m_pStencilTex    = &m_RenderData.pCurrentMonData->stencilTex;
+        m_RenderData.pCurrentMonData->offloadFB.m_pStencilTex = &m_RenderData.pCurrentMonData->stencilTex;
 
         m_RenderData.pCurrentMonData->offloadFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->drmFormat);
-        m_RenderData.pCurrentMonData->mirrorFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->drmFormat);
-        m_RenderData.pCurrentMonData->mirrorSwapFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->drmFormat);
-        m_RenderData.pCurrentMonData->offMainFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->drmFormat);
     }
 
     if (m_RenderData.pCurrentMonData->monitorMirrorFB.isAllocated() && m_RenderData.pMonitor->mirrors.empty())
         m_RenderData.pCurrentMonData->monitorMirrorFB.release();
 
+    // snapshots and screencopy render with their own fb, and might disable effects while they do
+    if (!fb)
+        releaseIdleEffectFBs();
+
+    enforceMemoryBudget();
+
     m_RenderData.damage.set(damage_);
     m_RenderData.finalDamage.set(finalDamage.value_or(damage_));
 
@@ -648,6 +653,16 @@ void CHyprOpenGLImpl::blend(bool enabled) {
     m_bBlend = enabled;
 }
 
+void CHyprOpenGLImpl::useProgram(GLuint program) {
+    if (m_bSkipRedundantPrograms && program == m_iCurrentProgram)
+        return;
+
+    glUseProgram(program);
+
+    m_iCurrentProgram = program;
+    m_iProgramSwitches++;
+}
+
 void CHyprOpenGLImpl::scissor(const CBox* pBox, bool transform) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
@@ -758,7 +773,7 @@ void CHyprOpenGLImpl::renderRectWithDamage(CBox* box, const CColor& col, CRegion
     float glMatrix[9];
     wlr_matrix_multiply(glMatrix, m_RenderData.projection, matrix);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shQUAD.program);
+    useProgram(m_RenderData.pCurrentMonData->m_shQUAD.program);
 
 #ifndef GLES2
     glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shQUAD.proj, 1, GL_TRUE, glMatrix);
@@ -888,7 +903,7 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, CBox*
         glTexParameteri(tex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     }
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
 #ifndef GLES2
     glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix);
@@ -1016,7 +1031,7 @@ void CHyprOpenGLImpl::renderTexturePrimitive(const CTexture& tex, CBox* pBox) {
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(tex.m_iTarget, tex.m_iTexID);
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
 #ifndef GLES2
     glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix);
@@ -1067,7 +1082,7 @@ void CHyprOpenGLImpl::renderTextureMatte(const CTexture& tex, CBox* pBox, CFrame
 
     CShader* shader = &m_RenderData.pCurrentMonData->m_shMATTE;
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
 #ifndef GLES2
     glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix);
@@ -1137,8 +1152,8 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     wlr_region_expand(damage.pixman(), damage.pixman(), *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES));
 
     // helper
-    const auto    PMIRRORFB     = &m_RenderData.pCurrentMonData->mirrorFB;
-    const auto    PMIRRORSWAPFB = &m_RenderData.pCurrentMonData->mirrorSwapFB;
+    const auto    PMIRRORFB     = useEffectFB(m_RenderData.pCurrentMonData->mirrorFB);
+    const auto    PMIRRORSWAPFB = useEffectFB(m_RenderData.pCurrentMonData->mirrorSwapFB);
 
     CFramebuffer* currentRenderToFB = PMIRRORFB;
 
@@ -1156,7 +1171,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         glTexParameteri(m_RenderData.currentFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_RenderData.pCurrentMonData->m_shBLURPREPARE.program);
+        useProgram(m_RenderData.pCurrentMonData->m_shBLURPREPARE.program);
 
 #ifndef GLES2
         glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURPREPARE.proj, 1, GL_TRUE, glMatrix);
@@ -1200,7 +1215,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         glTexParameteri(currentRenderToFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(pShader->program);
+        useProgram(pShader->program);
 
         // prep two shaders
 #ifndef GLES2
@@ -1278,7 +1293,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         glTexParameteri(currentRenderToFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_RenderData.pCurrentMonData->m_shBLURFINISH.program);
+        useProgram(m_RenderData.pCurrentMonData->m_shBLURFINISH.program);
 
 #ifndef GLES2
         glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBLURFINISH.proj, 1, GL_TRUE, glMatrix);
@@ -1623,7 +1638,7 @@ void CHyprOpenGLImpl::renderBorder(CBox* box, const CGradientValueData& grad, in
     const auto BLEND = m_bBlend;
     blend(true);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shBORDER1.program);
+    useProgram(m_RenderData.pCurrentMonData->m_shBORDER1.program);
 
 #ifndef GLES2
     glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shBORDER1.proj, 1, GL_TRUE, glMatrix);
@@ -1749,7 +1764,10 @@ void CHyprOpenGLImpl::makeWindowSnapshot(PHLWINDOW pWindow) {
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    const auto PFRAMEBUFFER = &m_mWindowFramebuffers[ref];
+    auto&      snapshot     = m_mWindowFramebuffers[ref];
+    const auto PFRAMEBUFFER = &snapshot.fb;
+
+    snapshot.lastDrawn.reset();
 
     PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->drmFormat);
 
@@ -1796,7 +1814,10 @@ void CHyprOpenGLImpl::makeLayerSnapshot(PHLLS pLayer) {
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    const auto PFRAMEBUFFER = &m_mLayerFramebuffers[pLayer];
+    auto&      snapshot     = m_mLayerFramebuffers[pLayer];
+    const auto PFRAMEBUFFER = &snapshot.fb;
+
+    snapshot.lastDrawn.reset();
 
     PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->drmFormat);
 
@@ -1832,11 +1853,14 @@ void CHyprOpenGLImpl::renderSnapshot(PHLWINDOW pWindow) {
     if (!m_mWindowFramebuffers.contains(ref))
         return;
 
-    const auto FBDATA = &m_mWindowFramebuffers.at(ref);
+    auto&      snapshot = m_mWindowFramebuffers.at(ref);
+    const auto FBDATA   = &snapshot.fb;
 
     if (!FBDATA->m_cTex.m_iTexID)
         return;
 
+    snapshot.lastDrawn.reset();
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(pWindow->m_iMonitorID);
 
     CBox       windowBox;
@@ -1871,11 +1895,14 @@ void CHyprOpenGLImpl::renderSnapshot(PHLLS pLayer) {
     if (!m_mLayerFramebuffers.contains(pLayer))
         return;
 
-    const auto FBDATA = &m_mLayerFramebuffers.at(pLayer);
+    auto&      snapshot = m_mLayerFramebuffers.at(pLayer);
+    const auto FBDATA   = &snapshot.fb;
 
     if (!FBDATA->m_cTex.m_iTexID)
         return;
 
+    snapshot.lastDrawn.reset();
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(pLayer->monitorID);
 
     CBox       layerBox;
@@ -1928,7 +1955,7 @@ void CHyprOpenGLImpl::renderRoundedShadow(CBox* box, int round, int range, const
 
     glEnable(GL_BLEND);
 
-    glUseProgram(m_RenderData.pCurrentMonData->m_shSHADOW.program);
+    useProgram(m_RenderData.pCurrentMonData->m_shSHADOW.program);
 
 #ifndef GLES2
     glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shSHADOW.proj, 1, GL_TRUE, glMatrix);
@@ -1977,6 +2004,113 @@ void CHyprOpenGLImpl::renderRoundedShadow(CBox* box, int round, int range, const
     glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib);
 }
 
+void CHyprOpenGLImpl::renderNineSlice(const CTexture& tex, CBox* box, int corner, const CColor& tint, float a, bool drawCenter) {
+    RASSERT(m_RenderData.pMonitor, "Tried to render nine-slice without begin()!");
+    RASSERT((tex.m_iTexID > 0), "Attempted to draw NULL texture!");
+    RASSERT((box->width >= 2 * corner && box->height >= 2 * corner), "Tried to render nine-slice smaller than its corners!");
+
+    if (m_RenderData.damage.empty())
+        return;
+
+    TRACY_GPU_ZONE("RenderNineSlice");
+
+    CBox newBox = *box;
+    m_RenderData.renderModif.applyToBox(newBox);
+
+    float matrix[9];
+    wlr_matrix_project_box(matrix, newBox.pWlr(), wlr_output_transform_invert(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform), newBox.rot,
+                           m_RenderData.pMonitor->projMatrix.data()); // TODO: write own, don't use WLR here
+
+    float glMatrix[9];
+    wlr_matrix_multiply(glMatrix, m_RenderData.projection, matrix);
+
+    // corners are drawn 1:1 (before modifs), the middle row and column of the texture are stretched over the rest.
+    // Edges sample the middle texel's center only, so filtering never mixes in the corners.
+    const float POSX[4]   = {0.f, (float)(corner / box->width), (float)(1.0 - corner / box->width), 1.f};
+    const float POSY[4]   = {0.f, (float)(corner / box->height), (float)(1.0 - corner / box->height), 1.f};
+    const float MIDU      = (corner + 0.5) / tex.m_vSize.x;
+    const float MIDV      = (corner + 0.5) / tex.m_vSize.y;
+    const float UVX[3][2] = {{0.f, (float)(corner / tex.m_vSize.x)}, {MIDU, MIDU}, {(float)((tex.m_vSize.x - corner) / tex.m_vSize.x), 1.f}};
+    const float UVY[3][2] = {{0.f, (float)(corner / tex.m_vSize.y)}, {MIDV, MIDV}, {(float)((tex.m_vSize.y - corner) / tex.m_vSize.y), 1.f}};
+
+    std::vector<float> verts;
+    std::vector<float> uvs;
+    verts.reserve(9 * 12);
+    uvs.reserve(9 * 12);
+
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 3; ++x) {
+            if (x == 1 && y == 1 && !drawCenter)
+                continue;
+
+            // two triangles per slice
+            for (const auto& [px, py] : {std::pair{0, 0}, std::pair{1, 0}, std::pair{0, 1}, std::pair{1, 0}, std::pair{1, 1}, std::pair{0, 1}}) {
+                verts.push_back(POSX[x + px]);
+                verts.push_back(POSY[y + py]);
+                uvs.push_back(UVX[x][px]);
+                uvs.push_back(UVY[y][py]);
+            }
+        }
+    }
+
+    CShader* shader = &m_RenderData.pCurrentMonData->m_shRGBA;
+
+    glEnable(GL_BLEND);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(tex.m_iTarget, tex.m_iTexID);
+    glTexParameteri(tex.m_iTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(tex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    useProgram(shader->program);
+
+#ifndef GLES2
+    glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix);
+#else
+    wlr_matrix_transpose(glMatrix, glMatrix);
+    glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix);
+#endif
+    glUniform1i(shader->tex, 0);
+    glUniform1f(shader->alpha, std::clamp(tint.a * a, 0.f, 1.f));
+    glUniform1i(shader->discardOpaque, 0);
+    glUniform1i(shader->discardAlpha, 0);
+    glUniform1f(shader->radius, 0);
+
+    // the texture is premultiplied white, tinting it gives the premultiplied color
+    glUniform1i(shader->applyTint, 1);
+    glUniform3f(shader->tint, tint.r, tint.g, tint.b);
+
+    glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, verts.data());
+    glVertexAttribPointer(shader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, uvs.data());
+
+    glEnableVertexAttribArray(shader->posAttrib);
+    glEnableVertexAttribArray(shader->texAttrib);
+
+    const auto VERTCOUNT = verts.size() / 2;
+
+    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
+        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
+        damageClip.intersect(m_RenderData.damage);
+
+        if (!damageClip.empty()) {
+            for (auto& RECT : damageClip.getRects()) {
+                scissor(&RECT);
+                glDrawArrays(GL_TRIANGLES, 0, VERTCOUNT);
+            }
+        }
+    } else {
+        for (auto& RECT : m_RenderData.damage.getRects()) {
+            scissor(&RECT);
+            glDrawArrays(GL_TRIANGLES, 0, VERTCOUNT);
+        }
+    }
+
+    glDisableVertexAttribArray(shader->posAttrib);
+    glDisableVertexAttribArray(shader->texAttrib);
+
+    glBindTexture(tex.m_iTarget, 0);
+}
+
 void CHyprOpenGLImpl::saveBufferForMirror(CBox* box) {
 
     if (!m_RenderData.pCurrentMonData->monitorMirrorFB.isAllocated())
@@ -2069,6 +2203,7 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(CMonitor* pMonitor) {
     const auto PFB = &m_mMonitorBGFBs[pMonitor];
     PFB->release();
 
+    PFB->m_eCategory = FB_CATEGORY_MONITOR;
     PFB->alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, pMonitor->drmFormat);
     Debug::log(LOG, "Allocated texture for BGTex");
 
@@ -2226,6 +2361,68 @@ void CHyprOpenGLImpl::destroyMonitorResources(CMonitor* pMonitor) {
     Debug::log(LOG, "Monitor {} -> destroyed all render data", pMonitor->szName);
 }
 
+CFramebuffer* CHyprOpenGLImpl::useEffectFB(CFramebuffer& fb) {
+    RASSERT(m_RenderData.pMonitor, "Tried to use an effect FB without begin()!");
+
+    m_RenderData.pCurrentMonData->effectFBsLastUsed.reset();
+
+    if (!fb.isAllocated()) {
+        fb.m_pStencilTex = &m_RenderData.pCurrentMonData->stencilTex;
+        fb.alloc(m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y, m_RenderData.pMonitor->drmFormat);
+    }
+
+    return &fb;
+}
+
+void CHyprOpenGLImpl::releaseIdleEffectFBs() {
+    static auto PBLUR            = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
+    static auto PBLURNEWOPTIMIZE = CConfigValue<Hyprlang::INT>("decoration:blur:new_optimizations");
+
+    const auto  PMONDATA = m_RenderData.pCurrentMonData;
+
+    if (PMONDATA->effectFBsLastUsed.getSeconds() > EFFECT_FB_IDLE_SECONDS) {
+        for (auto* fb : {&PMONDATA->mirrorFB, &PMONDATA->mirrorSwapFB, &PMONDATA->offMainFB}) {
+            if (fb->isAllocated())
+                fb->release();
+        }
+    }
+
+    // the pre-blurred background is only kept up to date with new_optimizations
+    if (PMONDATA->blurFB.isAllocated() && (!*PBLUR || !*PBLURNEWOPTIMIZE)) {
+        PMONDATA->blurFB.release();
+        PMONDATA->blurFBDirty = true;
+    }
+}
+
+void CHyprOpenGLImpl::enforceMemoryBudget() {
+    // free buffers go first, this also drops the ones nobody took for a while
+    g_pFramebufferPool->trim();
+
+    if (!g_pFramebufferPool->overBudget())
+        return;
+
+    const auto OLDER = [](const auto& a, const auto& b) { return a.second.lastDrawn.chrono() < b.second.lastDrawn.chrono(); };
+
+    // then the snapshots nothing drew for longest, as long as they're not fading out anymore
+    while (g_pFramebufferPool->overBudget()) {
+        const auto OLDESTWINDOW = std::min_element(m_mWindowFramebuffers.begin(), m_mWindowFramebuffers.end(), OLDER);
+        const auto OLDESTLAYER  = std::min_element(m_mLayerFramebuffers.begin(), m_mLayerFramebuffers.end(), OLDER);
+
+        const bool WINDOWIDLE = OLDESTWINDOW != m_mWindowFramebuffers.end() && OLDESTWINDOW->second.lastDrawn.getMillis() > SNAPSHOT_IDLE_MS;
+        const bool LAYERIDLE  = OLDESTLAYER != m_mLayerFramebuffers.end() && OLDESTLAYER->second.lastDrawn.getMillis() > SNAPSHOT_IDLE_MS;
+
+        if (!WINDOWIDLE && !LAYERIDLE)
+            break;
+
+        if (WINDOWIDLE && (!LAYERIDLE || OLDESTWINDOW->second.lastDrawn.chrono() <= OLDESTLAYER->second.lastDrawn.chrono()))
+            m_mWindowFramebuffers.erase(OLDESTWINDOW);
+        else
+            m_mLayerFramebuffers.erase(OLDESTLAYER);
+
+        m_iEvictedSnapshots++;
+    }
+}
+
 void CHyprOpenGLImpl::saveMatrix() {
     memcpy(m_RenderData.savedProjection, m_RenderData.projection, 9 * sizeof(float));
 }
@@ -2240,7 +2437,7 @@ void CHyprOpenGLImpl::restoreMatrix() {
 }
 
 void CHyprOpenGLImpl::bindOffMain() {
-    m_RenderData.pCurrentMonData->offMainFB.bind();
+    useEffectFB(m_RenderData.pCurrentMonData->offMainFB)->bind();
     clear(CColor(0, 0, 0, 0));
     m_RenderData.currentFB = &m_RenderData.pCurrentMonData->offMainFB;
 }
@@ -2397,63 +2594,106 @@ const SGLPixelFormat* CHyprOpenGLImpl::getPixelFormatFromDRM(uint32_t drmFormat)
     return nullptr;
 }
 
+Vector2D SRenderModifData::SLinear::apply(const Vector2D& vec) const {
+    return {xx * vec.x + xy * vec.y, yx * vec.x + yy * vec.y};
+}
+
+SRenderModifData::SLinear SRenderModifData::SLinear::after(const SLinear& other) const {
+    return {xx * other.xx + xy * other.yx, xx * other.xy + xy * other.yy, yx * other.xx + yy * other.yx, yx * other.xy + yy * other.yy};
+}
+
+void SRenderModifData::push(eRenderModifType type, float value) {
+    switch (type) {
+        case RMOD_TYPE_SCALE: {
+            const SLinear SCALE = {value, 0, 0, value};
+            m_sBoxPos           = SCALE.after(m_sBoxPos);
+            m_sBoxSize          = SCALE.after(m_sBoxSize);
+            m_vBoxOffset        = m_vBoxOffset * value;
+            m_fSizeScale *= value;
+            m_fRegionScale *= value;
+            m_vRegionOffset = m_vRegionOffset * value;
+            m_fCombinedScale *= value;
+            break;
+        }
+        case RMOD_TYPE_SCALECENTER: {
+            // the position moves by half of how much the current size grows
+            const double MOVE = (1.0 - value) / 2.0 * m_fSizeScale;
+            m_sBoxSize.xx += MOVE;
+            m_sBoxSize.yy += MOVE;
+            m_fSizeScale *= value;
+            m_fRegionScale *= value;
+            m_vRegionOffset   = m_vRegionOffset * value;
+            m_bTranslateScale = false;
+            break;
+        }
+        case RMOD_TYPE_ROTATE: {
+            m_fRotation += value;
+            m_bTranslateScale = false;
+            break;
+        }
+        case RMOD_TYPE_ROTATECENTER: {
+            const double  COS    = std::cos(value);
+            const double  SIN    = std::sin(value);
+            const SLinear ROTATE = {COS, -SIN, SIN, COS};
+            m_sBoxPos            = ROTATE.after(m_sBoxPos);
+            m_sBoxSize           = ROTATE.after(m_sBoxSize);
+            m_vBoxOffset         = ROTATE.apply(m_vBoxOffset);
+            m_fRotation += value;
+            m_bTranslateScale = false;
+            break;
+        }
+        case RMOD_TYPE_TRANSLATE: Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: RMOD_TYPE_TRANSLATE pushed with a float in SRenderModifData::push!"); break;
+    }
+}
+
+void SRenderModifData::push(eRenderModifType type, const Vector2D& value) {
+    if (type != RMOD_TYPE_TRANSLATE) {
+        Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: modif {} pushed with a Vector2D in SRenderModifData::push!", (int)type);
+        return;
+    }
+
+    m_vBoxOffset    = m_vBoxOffset + value;
+    m_vRegionOffset = m_vRegionOffset + value;
+}
+
 void SRenderModifData::applyToBox(CBox& box) {
     if (!enabled)
         return;
 
-    for (auto& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: box.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_SCALECENTER: box.scaleFromCenter(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_TRANSLATE: box.translate(std::any_cast<Vector2D>(val)); break;
-                case RMOD_TYPE_ROTATE: box.rot += std::any_cast<float>(val); break;
-                case RMOD_TYPE_ROTATECENTER: {
-                    const auto   THETA = std::any_cast<float>(val);
-                    const double COS   = std::cos(THETA);
-                    const double SIN   = std::sin(THETA);
-                    box.rot += THETA;
-                    const auto OLDPOS = box.pos();
-                    box.x             = OLDPOS.x * COS - OLDPOS.y * SIN;
-                    box.y             = OLDPOS.y * COS + OLDPOS.x * SIN;
-                }
-            }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::applyToBox!"); }
+    if (m_bTranslateScale) {
+        box.x = box.x * m_sBoxPos.xx + m_vBoxOffset.x;
+        box.y = box.y * m_sBoxPos.yy + m_vBoxOffset.y;
+        box.w *= m_fSizeScale;
+        box.h *= m_fSizeScale;
+        return;
     }
+
+    const auto POS = m_sBoxPos.apply(box.pos()) + m_sBoxSize.apply(box.size()) + m_vBoxOffset;
+    box.x          = POS.x;
+    box.y          = POS.y;
+    box.w *= m_fSizeScale;
+    box.h *= m_fSizeScale;
+    box.rot += m_fRotation;
 }
 
 void SRenderModifData::applyToRegion(CRegion& rg) {
     if (!enabled)
         return;
 
-    for (auto& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: rg.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_SCALECENTER: rg.scale(std::any_cast<float>(val)); break;
-                case RMOD_TYPE_TRANSLATE: rg.translate(std::any_cast<Vector2D>(val)); break;
-                case RMOD_TYPE_ROTATE: /* TODO */
-                case RMOD_TYPE_ROTATECENTER: break;
-            }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::applyToRegion!"); }
-    }
+    if (m_fRegionScale != 1)
+        rg.scale(m_fRegionScale);
+
+    if (m_vRegionOffset != Vector2D{})
+        rg.translate(m_vRegionOffset);
 }
 
 float SRenderModifData::combinedScale() {
     if (!enabled)
         return 1;
 
-    float scale = 1.f;
-    for (auto& [type, val] : modifs) {
-        try {
-            switch (type) {
-                case RMOD_TYPE_SCALE: scale *= std::any_cast<float>(val); break;
-                case RMOD_TYPE_SCALECENTER:
-                case RMOD_TYPE_TRANSLATE:
-                case RMOD_TYPE_ROTATE:
-                case RMOD_TYPE_ROTATECENTER: break;
-            }
-        } catch (std::bad_any_cast& e) { Debug::log(ERR, "BUG THIS OR PLUGIN ERROR: caught a bad_any_cast in SRenderModifData::combinedScale!"); }
-    }
-    return scale;
+    return m_fCombinedScale;
+}
+
+bool SRenderModifData::isTranslateScale() const {
+    return m_bTranslateScale;
 }
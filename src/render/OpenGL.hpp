@@ -45,13 +45,40 @@ struct SRenderModifData {
         RMOD_TYPE_ROTATECENTER, /* rotate by a float in rad from center */
     };
 
-    std::vector<std::pair<eRenderModifType, std::any>> modifs;
+    // modifs apply in the order they're pushed. They're folded into one transform right away, applying it costs the same for any number of them.
+    void  push(eRenderModifType type, float value);           // everything but RMOD_TYPE_TRANSLATE
+    void  push(eRenderModifType type, const Vector2D& value); // RMOD_TYPE_TRANSLATE
 
-    void                                               applyToBox(CBox& box);
-    void                                               applyToRegion(CRegion& rg);
-    float                                              combinedScale();
+    void  applyToBox(CBox& box);
+    void  applyToRegion(CRegion& rg);
+    float combinedScale();
 
-    bool                                               enabled = true;
+    // no rotations or scales from the center, boxes and regions transform the same
+    bool isTranslateScale() const;
+
+    bool enabled = true;
+
+  private:
+    struct SLinear {
+        double   xx = 1, xy = 0, yx = 0, yy = 1;
+
+        Vector2D apply(const Vector2D& vec) const;
+        SLinear  after(const SLinear& other) const; // this * other
+    };
+
+    // boxes: pos = boxPos * pos + boxSize * size + boxOffset, size *= sizeScale, rot += rotation
+    SLinear  m_sBoxPos;
+    SLinear  m_sBoxSize = {0, 0, 0, 0};
+    Vector2D m_vBoxOffset;
+    double   m_fSizeScale      = 1;
+    float    m_fRotation       = 0;
+    bool     m_bTranslateScale = true;
+
+    // regions only follow scales and translations
+    double   m_fRegionScale = 1;
+    Vector2D m_vRegionOffset;
+
+    float    m_fCombinedScale = 1;
 };
 
 struct SGLPixelFormat {
@@ -63,16 +90,17 @@ struct SGLPixelFormat {
 };
 
 struct SMonitorRenderData {
-    CFramebuffer offloadFB;
-    CFramebuffer mirrorFB;     // these are used for some effects,
-    CFramebuffer mirrorSwapFB; // etc
-    CFramebuffer offMainFB;
+    CFramebuffer offloadFB{FB_CATEGORY_MONITOR};
+    CFramebuffer mirrorFB{FB_CATEGORY_EFFECT};     // these are used for some effects,
+    CFramebuffer mirrorSwapFB{FB_CATEGORY_EFFECT}; // etc
+    CFramebuffer offMainFB{FB_CATEGORY_EFFECT};
+    CTimer       effectFBsLastUsed; // the three above are allocated by useEffectFB()
 
-    CFramebuffer monitorMirrorFB; // used for mirroring outputs, does not contain artifacts like offloadFB
+    CFramebuffer monitorMirrorFB{FB_CATEGORY_MONITOR}; // used for mirroring outputs, does not contain artifacts like offloadFB
 
     CTexture     stencilTex;
 
-    CFramebuffer blurFB;
+    CFramebuffer blurFB{FB_CATEGORY_EFFECT};
     bool         blurFBDirty        = true;
     bool         blurFBShouldRender = false;
 
@@ -124,6 +152,11 @@ struct SCurrentRenderData {
     float               discardOpacity = 0.f;
 };
 
+struct SSnapshot {
+    CFramebuffer fb{FB_CATEGORY_SNAPSHOT};
+    CTimer       lastDrawn; // under a budget, the snapshots drawn longest ago go first
+};
+
 class CGradientValueData;
 
 class CHyprOpenGLImpl {
@@ -140,6 +173,7 @@ class CHyprOpenGLImpl {
     void                  renderTexture(const CTexture&, CBox*, float a, int round = 0, bool discardActive = false, bool allowCustomUV = false);
     void                  renderTextureWithBlur(const CTexture&, CBox*, float a, wlr_surface* pSurface, int round = 0, bool blockBlurOptimization = false, float blurA = 1.f);
     void                  renderRoundedShadow(CBox*, int round, int range, const CColor& color, float a = 1.0);
+    void                  renderNineSlice(const CTexture& tex, CBox*, int corner, const CColor& tint, float a = 1.0, bool drawCenter = true);
     void                  renderBorder(CBox*, const CGradientValueData&, int round, int borderSize, float a = 1.0, int outerRound = -1 /* use round */);
     void                  renderTextureMatte(const CTexture& tex, CBox* pBox, CFramebuffer& matte);
 
@@ -166,6 +200,7 @@ class CHyprOpenGLImpl {
     void                  scissor(const int x, const int y, const int w, const int h, bool transform = true);
 
     void                  destroyMonitorResources(CMonitor*);
+    CFramebuffer*         useEffectFB(CFramebuffer& fb); // allocates it on first use, begin() releases it once unused for a while
 
     void                  markBlurDirtyForMonitor(CMonitor*);
 
@@ -196,10 +231,11 @@ class CHyprOpenGLImpl {
     PHLWINDOWREF          m_pCurrentWindow; // hack to get the current rendered window
     PHLLS                 m_pCurrentLayer;  // hack to get the current rendered layer
 
-    std::map<PHLWINDOWREF, CFramebuffer, std::owner_less<PHLWINDOWREF>> m_mWindowFramebuffers;
-    std::map<PHLLSREF, CFramebuffer, std::owner_less<PHLLSREF>>         m_mLayerFramebuffers;
-    std::unordered_map<CMonitor*, SMonitorRenderData>                   m_mMonitorRenderResources;
-    std::unordered_map<CMonitor*, CFramebuffer>                         m_mMonitorBGFBs;
+    std::map<PHLWINDOWREF, SSnapshot, std::owner_less<PHLWINDOWREF>> m_mWindowFramebuffers;
+    std::map<PHLLSREF, SSnapshot, std::owner_less<PHLLSREF>>         m_mLayerFramebuffers;
+    std::unordered_map<CMonitor*, SMonitorRenderData>                m_mMonitorRenderResources;
+    std::unordered_map<CMonitor*, CFramebuffer>                      m_mMonitorBGFBs;
+    uint64_t                                                         m_iEvictedSnapshots = 0; // to fit opengl:memory_budget
 
     struct {
         PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC glEGLImageTargetRenderbufferStorageOES = nullptr;
@@ -223,6 +259,11 @@ class CHyprOpenGLImpl {
     bool              m_bBlend                = false;
     bool              m_bOffloadedFramebuffer = false;
 
+    // while a render pass is flushed, nothing else binds programs behind our back
+    bool              m_bSkipRedundantPrograms = false;
+    GLuint            m_iCurrentProgram        = 0;
+    size_t            m_iProgramSwitches       = 0;
+
     CShader           m_sFinalScreenShader;
     CTimer            m_tGlobalTimer;
 
@@ -238,13 +279,17 @@ class CHyprOpenGLImpl {
     void          renderTextureInternalWithDamage(const CTexture&, CBox* pBox, float a, CRegion* damage, int round = 0, bool discardOpaque = false, bool noAA = false,
                                                   bool allowCustomUV = false, bool allowDim = false);
     void          renderTexturePrimitive(const CTexture& tex, CBox* pBox);
+    void          useProgram(GLuint program);
     void          renderSplash(cairo_t* const, cairo_surface_t* const, double offset, const Vector2D& size);
 
     void          preBlurForCurrentMonitor();
+    void          releaseIdleEffectFBs();
+    void          enforceMemoryBudget();
 
     bool          passRequiresIntrospection(CMonitor* pMonitor);
 
     friend class CHyprRenderer;
+    friend class CRenderPass;
 };
 
 inline std::unique_ptr<CHyprOpenGLImpl> g_pHyprOpenGL;
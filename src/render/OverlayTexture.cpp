@@ -0,0 +1,110 @@
+#include "OverlayTexture.hpp"
+
+COverlayTexture::~COverlayTexture() {
+    destroy();
+}
+
+bool COverlayTexture::resize(const Vector2D& size) {
+    const Vector2D SIZE = {std::max(1.0, std::ceil(size.x)), std::max(1.0, std::ceil(size.y))};
+
+    if (m_pSurface && SIZE == m_vSize)
+        return false;
+
+    if (m_pCairo)
+        cairo_destroy(m_pCairo);
+    if (m_pSurface)
+        cairo_surface_destroy(m_pSurface);
+
+    m_pSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, SIZE.x, SIZE.y);
+    m_pCairo   = cairo_create(m_pSurface);
+    m_vSize    = SIZE;
+
+    m_bTextureAllocated = false;
+    m_rDamage           = CRegion{0, 0, SIZE.x, SIZE.y};
+
+    return true;
+}
+
+cairo_t* COverlayTexture::cairo() {
+    if (!m_pCairo)
+        resize({1, 1});
+
+    return m_pCairo;
+}
+
+void COverlayTexture::clear(const CBox& box) {
+    cairo_save(m_pCairo);
+    cairo_set_operator(m_pCairo, CAIRO_OPERATOR_CLEAR);
+    cairo_rectangle(m_pCairo, box.x, box.y, box.w, box.h);
+    cairo_fill(m_pCairo);
+    cairo_restore(m_pCairo);
+
+    damage(box);
+}
+
+void COverlayTexture::damage(const CBox& box) {
+    m_rDamage.add(box);
+}
+
+void COverlayTexture::upload() {
+    if (!m_pSurface)
+        return;
+
+    m_rDamage.intersect(0, 0, m_vSize.x, m_vSize.y);
+
+    if (m_bTextureAllocated && m_rDamage.empty())
+        return;
+
+    cairo_surface_flush(m_pSurface);
+
+    const auto DATA   = cairo_image_surface_get_data(m_pSurface);
+    const auto STRIDE = cairo_image_surface_get_stride(m_pSurface);
+
+    m_tTexture.allocate();
+    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
+
+    if (!m_bTextureAllocated) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+#ifndef GLES2
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+#endif
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_vSize.x, m_vSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+
+        m_tTexture.m_vSize  = m_vSize;
+        m_bTextureAllocated = true;
+        m_rDamage.clear();
+        return;
+    }
+
+    const auto EXTENTS = m_rDamage.getExtents();
+
+#ifndef GLES2
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, STRIDE / 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, EXTENTS.x, EXTENTS.y, EXTENTS.w, EXTENTS.h, GL_RGBA, GL_UNSIGNED_BYTE, DATA + (size_t)EXTENTS.y * STRIDE + (size_t)EXTENTS.x * 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#else
+    // no unpack row length, send whole rows
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, EXTENTS.y, m_vSize.x, EXTENTS.h, GL_RGBA, GL_UNSIGNED_BYTE, DATA + (size_t)EXTENTS.y * STRIDE);
+#endif
+
+    m_rDamage.clear();
+}
+
+void COverlayTexture::destroy() {
+    m_tTexture.destroyTexture();
+
+    if (m_pCairo)
+        cairo_destroy(m_pCairo);
+    if (m_pSurface)
+        cairo_surface_destroy(m_pSurface);
+
+    m_pCairo            = nullptr;
+    m_pSurface          = nullptr;
+    m_vSize             = {};
+    m_bTextureAllocated = false;
+    m_rDamage.clear();
+}
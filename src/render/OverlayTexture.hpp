@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Region.hpp"
+#include "Texture.hpp"
+
+#include <cairo/cairo.h>
+
+/*
+    A cairo surface sized to what an overlay draws, mirrored into a texture.
+    Callers mark what they drew with damage(), and only that is uploaded.
+*/
+class COverlayTexture {
+  public:
+    ~COverlayTexture();
+
+    // (re)creates the surface if the size differs. Returns true if it did, the contents are gone then.
+    bool     resize(const Vector2D& size);
+    // the context to draw with, valid even before the first resize (for measuring text)
+    cairo_t* cairo();
+
+    // clears a part of the surface and marks it as damaged
+    void     clear(const CBox& box);
+    void     damage(const CBox& box);
+    // uploads the damaged parts, the texture has to be bound to the current context
+    void     upload();
+    void     destroy();
+
+    CTexture m_tTexture;
+    Vector2D m_vSize;
+
+  private:
+    cairo_surface_t* m_pSurface = nullptr;
+    cairo_t*         m_pCairo   = nullptr;
+
+    CRegion          m_rDamage;
+    bool             m_bTextureAllocated = false; // with the current size
+};
@@ -0,0 +1,282 @@
+#include "RenderPass.hpp"
+#include "OpenGL.hpp"
+#include "../Compositor.hpp"
+
+// above this, reordering isn't worth the quadratic scan
+constexpr size_t MAX_SCHEDULED_ELEMENTS = 64;
+// keeps the description bounded if a monitor renders snapshots without frames
+constexpr size_t MAX_DESCRIBED_ELEMENTS = 1024;
+
+void CRenderPass::add(SRenderPassElement&& element) {
+    m_vElements.emplace_back(std::move(element));
+}
+
+bool CRenderPass::empty() const {
+    return m_vElements.empty();
+}
+
+void CRenderPass::beginFrame(CMonitor* pMonitor) {
+    auto& frame = m_mFrames[pMonitor->ID];
+    frame.elements.clear();
+    frame.flushes        = 0;
+    frame.reordered      = 0;
+    frame.culled         = 0;
+    frame.merged         = 0;
+    frame.shaderSwitches = 0;
+}
+
+const std::unordered_map<int, CRenderPass::SFrameInfo>& CRenderPass::frames() const {
+    return m_mFrames;
+}
+
+eRenderPassShader CRenderPass::shaderFor(const SRenderPassElement& element) {
+    if (element.blur)
+        return RENDER_PASS_SHADER_BLUR;
+
+    if (element.type == RENDER_PASS_ELEMENT_RECT)
+        return RENDER_PASS_SHADER_QUAD;
+
+    if (element.window.lock() && element.window.lock()->m_sAdditionalConfigData.forceRGBX)
+        return RENDER_PASS_SHADER_RGBX;
+
+    switch (element.texture.m_iType) {
+        case TEXTURE_RGBX: return RENDER_PASS_SHADER_RGBX;
+        case TEXTURE_EXTERNAL: return RENDER_PASS_SHADER_EXT;
+        default: break;
+    }
+
+    return RENDER_PASS_SHADER_RGBA;
+}
+
+void CRenderPass::schedule() {
+    const size_t COUNT = m_vElements.size();
+
+    m_vOrder.clear();
+    m_vOrder.reserve(COUNT);
+
+    if (COUNT > MAX_SCHEDULED_ELEMENTS) {
+        for (size_t i = 0; i < COUNT; ++i) {
+            m_vOrder.push_back(i);
+        }
+        return;
+    }
+
+    // an element can be drawn before earlier ones if it doesn't overlap any of them.
+    // Blur samples what's below it, so nothing moves across a blurred element.
+    const auto dependsOn = [this](size_t later, size_t earlier) {
+        const auto& A = m_vElements[later];
+        const auto& B = m_vElements[earlier];
+
+        if (A.blur || B.blur)
+            return true;
+
+        return !A.box.copy().expand(1).intersection(B.box).empty();
+    };
+
+    std::vector<bool>              done(COUNT, false);
+    std::vector<eRenderPassShader> shaders(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        shaders[i] = shaderFor(m_vElements[i]);
+    }
+
+    std::optional<eRenderPassShader> last;
+
+    while (m_vOrder.size() < COUNT) {
+        std::optional<size_t> first, sameShader;
+
+        for (size_t i = 0; i < COUNT && !sameShader; ++i) {
+            if (done[i])
+                continue;
+
+            bool ready = true;
+            for (size_t j = 0; j < i && ready; ++j) {
+                if (!done[j] && dependsOn(i, j))
+                    ready = false;
+            }
+
+            if (!ready)
+                continue;
+
+            if (!first)
+                first = i;
+
+            if (last && shaders[i] == *last)
+                sameShader = i;
+        }
+
+        // the first pending element is always ready, as everything before it is done
+        const size_t NEXT = sameShader.value_or(*first);
+
+        done[NEXT] = true;
+        last       = shaders[NEXT];
+        m_vOrder.push_back(NEXT);
+    }
+}
+
+bool CRenderPass::canMerge(const SRenderPassElement& a, const SRenderPassElement& b) {
+    return a.type == RENDER_PASS_ELEMENT_RECT && b.type == RENDER_PASS_ELEMENT_RECT && !a.blur && !b.blur && a.round == 0 && b.round == 0 && a.color == b.color &&
+        a.clipBox == b.clipBox;
+}
+
+void CRenderPass::draw(SRenderPassElement& element, const CRegion& visible) {
+    auto&      renderData = g_pHyprOpenGL->m_RenderData;
+
+    CRegion    saveDamage = renderData.damage;
+
+    const bool NARROWDAMAGE = !element.blur;
+
+    // only draw over what's both damaged and covered by the element. Blur does this itself, and needs to know the full damage.
+    if (NARROWDAMAGE)
+        renderData.damage = visible;
+
+    renderData.clipBox              = element.clipBox;
+    renderData.discardMode          = element.discardMode;
+    renderData.discardOpacity       = element.discardOpacity;
+    renderData.useNearestNeighbor   = element.nearestNeighbor;
+    g_pHyprOpenGL->m_pCurrentWindow = element.window;
+    g_pHyprOpenGL->m_pCurrentLayer  = element.layer;
+
+    if (element.type == RENDER_PASS_ELEMENT_RECT) {
+        if (element.blur)
+            g_pHyprOpenGL->renderRectWithBlur(&element.box, element.color, element.round, element.blurAlpha, element.xray);
+        else
+            g_pHyprOpenGL->renderRect(&element.box, element.color, element.round);
+    } else {
+        renderData.primarySurfaceUVTopLeft     = element.uvTopLeft;
+        renderData.primarySurfaceUVBottomRight = element.uvBottomRight;
+
+        g_pHyprOpenGL->blend(element.blend);
+
+        if (element.blur)
+            g_pHyprOpenGL->renderTextureWithBlur(element.texture, &element.box, element.alpha, element.surface, element.round, element.blockBlurOptimization, element.blurAlpha);
+        else
+            g_pHyprOpenGL->renderTexture(element.texture, &element.box, element.alpha, element.round, false, true);
+
+        g_pHyprOpenGL->blend(true);
+
+        renderData.primarySurfaceUVTopLeft     = Vector2D(-1, -1);
+        renderData.primarySurfaceUVBottomRight = Vector2D(-1, -1);
+    }
+
+    if (NARROWDAMAGE)
+        renderData.damage = saveDamage;
+}
+
+void CRenderPass::flush() {
+    if (m_vElements.empty())
+        return;
+
+    TRACY_GPU_ZONE("RenderPassFlush");
+
+    auto&      renderData = g_pHyprOpenGL->m_RenderData;
+
+    const auto PMONITOR = renderData.pMonitor;
+
+    RASSERT(PMONITOR, "Tried to flush a render pass without begin()!");
+
+    auto&      frame    = m_mFrames[PMONITOR->ID];
+    const bool DESCRIBE = frame.elements.size() < MAX_DESCRIBED_ELEMENTS;
+
+    // what the elements change, they all carry their own
+    const auto CLIPBOX        = renderData.clipBox;
+    const auto DISCARDMODE    = renderData.discardMode;
+    const auto DISCARDOPACITY = renderData.discardOpacity;
+    const auto NEARESTNEIGHBR = renderData.useNearestNeighbor;
+    const auto PWINDOW        = g_pHyprOpenGL->m_pCurrentWindow;
+    const auto PLAYER         = g_pHyprOpenGL->m_pCurrentLayer;
+
+    schedule();
+
+    // only our own draws run until the end of the flush, so the last bound program can be trusted
+    g_pHyprOpenGL->m_bSkipRedundantPrograms = true;
+    g_pHyprOpenGL->m_iCurrentProgram        = 0;
+    g_pHyprOpenGL->m_iProgramSwitches       = 0;
+
+    for (size_t i = 0; i < m_vOrder.size(); ++i) {
+        auto&      element  = m_vElements[m_vOrder[i]];
+        const auto ORIGINAL = element.box;
+
+        // what it covers on the monitor. Rotated boxes aren't axis aligned anymore, those are never culled.
+        CBox box = element.box;
+        renderData.renderModif.applyToBox(box);
+
+        const bool ROTATED = box.rot != 0;
+
+        CRegion    visible     = renderData.damage.copy();
+        size_t     mergedUntil = i;
+
+        if (!ROTATED) {
+            CRegion covered{box};
+
+            // merge the following rects of the same color into this draw, as long as they don't overlap
+            while (mergedUntil + 1 < m_vOrder.size()) {
+                const auto& OTHER = m_vElements[m_vOrder[mergedUntil + 1]];
+
+                if (!canMerge(element, OTHER))
+                    break;
+
+                CBox otherBox = OTHER.box;
+                renderData.renderModif.applyToBox(otherBox);
+
+                if (otherBox.rot != 0 || !covered.copy().intersect(CRegion{otherBox}).empty())
+                    break;
+
+                covered.add(otherBox);
+
+                const Vector2D TL = {std::min(element.box.x, OTHER.box.x), std::min(element.box.y, OTHER.box.y)};
+                const Vector2D BR = {std::max(element.box.x + element.box.w, OTHER.box.x + OTHER.box.w), std::max(element.box.y + element.box.h, OTHER.box.y + OTHER.box.h)};
+                element.box       = CBox{TL, BR - TL};
+
+                mergedUntil++;
+            }
+
+            // a merged draw spans the gaps between its rects, it has to be limited to them exactly
+            if (mergedUntil != i)
+                visible.intersect(covered);
+            else
+                visible.intersect(CRegion{box.expand(1)});
+        }
+
+        if (!element.clipBox.empty())
+            visible.intersect(CRegion{element.clipBox});
+
+        const bool CULLED = visible.empty();
+
+        if (!CULLED)
+            draw(element, visible);
+
+        element.box = ORIGINAL;
+
+        for (size_t j = i; j <= mergedUntil; ++j) {
+            auto& drawn = m_vElements[m_vOrder[j]];
+
+            if (drawn.when && drawn.surface) {
+                wlr_surface_send_frame_done(drawn.surface, drawn.when);
+                wlr_presentation_surface_textured_on_output(drawn.surface, drawn.pMonitor->output);
+            }
+
+            frame.reordered += m_vOrder[j] != j;
+            frame.culled += CULLED;
+            frame.merged += j != i;
+
+            if (DESCRIBE)
+                frame.elements.emplace_back(SElementInfo{drawn.type, shaderFor(drawn), drawn.box, frame.flushes, m_vOrder[j], CULLED, j != i});
+        }
+
+        i = mergedUntil;
+    }
+
+    frame.shaderSwitches += g_pHyprOpenGL->m_iProgramSwitches;
+    frame.flushes++;
+
+    g_pHyprOpenGL->m_bSkipRedundantPrograms = false;
+
+    renderData.clipBox              = CLIPBOX;
+    renderData.discardMode          = DISCARDMODE;
+    renderData.discardOpacity       = DISCARDOPACITY;
+    renderData.useNearestNeighbor   = NEARESTNEIGHBR;
+    g_pHyprOpenGL->m_pCurrentWindow = PWINDOW;
+    g_pHyprOpenGL->m_pCurrentLayer  = PLAYER;
+
+    m_vElements.clear();
+}
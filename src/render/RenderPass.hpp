@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Color.hpp"
+#include "../helpers/Region.hpp"
+#include "Texture.hpp"
+#include <unordered_map>
+
+class CMonitor;
+
+enum eRenderPassElementType {
+    RENDER_PASS_ELEMENT_SURFACE = 0, // a surface's texture, maybe blurred
+    RENDER_PASS_ELEMENT_RECT,        // a solid rect, maybe blurred
+};
+
+enum eRenderPassShader {
+    RENDER_PASS_SHADER_QUAD = 0,
+    RENDER_PASS_SHADER_RGBA,
+    RENDER_PASS_SHADER_RGBX,
+    RENDER_PASS_SHADER_EXT,
+    RENDER_PASS_SHADER_BLUR,
+};
+
+/*
+    Something to draw, with the render state it needs captured when it was added.
+*/
+struct SRenderPassElement {
+    eRenderPassElementType type = RENDER_PASS_ELEMENT_SURFACE;
+
+    CBox                   box;     // scaled, monitor-local, before render modifs
+    CBox                   clipBox; // scaled, empty for none
+    float                  alpha = 1.f;
+    int                    round = 0;
+
+    // blurred elements read what's drawn below them
+    bool         blur                  = false;
+    bool         blockBlurOptimization = false;
+    bool         xray                  = false;
+    float        blurAlpha             = 1.f;
+
+    CColor       color; // rects
+
+    wlr_surface* surface = nullptr; // surfaces
+    CTexture     texture;
+    Vector2D     uvTopLeft       = Vector2D(-1, -1);
+    Vector2D     uvBottomRight   = Vector2D(-1, -1);
+    bool         nearestNeighbor = false;
+    bool         blend           = true;
+    uint32_t     discardMode     = 0;
+    float        discardOpacity  = 0.f;
+
+    // frame feedback is sent once drawn, nullptr for none
+    timespec*    when     = nullptr;
+    CMonitor*    pMonitor = nullptr;
+
+    PHLWINDOWREF window;
+    PHLLS        layer;
+};
+
+/*
+    A flat list of what the renderer draws. Elements are added in paint order and drawn on flush(),
+    grouped by shader where that can't change the result, with runs of plain rects merged into one draw
+    and elements outside of the damage skipped.
+    Anything drawing directly (decorations, plugins, transformers) has to flush() first.
+*/
+class CRenderPass {
+  public:
+    void add(SRenderPassElement&& element);
+    void flush();
+    bool empty() const;
+
+    // starts a new frame description for the monitor
+    void beginFrame(CMonitor* pMonitor);
+
+    struct SElementInfo {
+        eRenderPassElementType type   = RENDER_PASS_ELEMENT_SURFACE;
+        eRenderPassShader      shader = RENDER_PASS_SHADER_QUAD;
+        CBox                   box;
+        size_t                 flush  = 0;
+        size_t                 index  = 0; // in the order it was added
+        bool                   culled = false;
+        bool                   merged = false; // drawn with the element before it
+    };
+
+    struct SFrameInfo {
+        std::vector<SElementInfo> elements;
+        size_t                    flushes        = 0;
+        size_t                    reordered      = 0;
+        size_t                    culled         = 0;
+        size_t                    merged         = 0;
+        size_t                    shaderSwitches = 0;
+    };
+
+    // the last frame per monitor ID
+    const std::unordered_map<int, SFrameInfo>& frames() const;
+
+  private:
+    std::vector<SRenderPassElement>     m_vElements;
+    std::vector<size_t>                 m_vOrder;
+    std::unordered_map<int, SFrameInfo> m_mFrames;
+
+    eRenderPassShader                   shaderFor(const SRenderPassElement& element);
+    void                                schedule();
+    bool                                canMerge(const SRenderPassElement& a, const SRenderPassElement& b);
+    void                                draw(SRenderPassElement& element, const CRegion& visible);
+};
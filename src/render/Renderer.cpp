@@ -164,14 +164,6 @@ static void renderSurface(struct wlr_surface* surface, int x, int y, void* data)
 
     g_pHyprRenderer->calculateUVForSurface(RDATA->pWindow, surface, RDATA->surface == surface, windowBox.size(), MISALIGNEDFSV1);
 
-    // check for fractional scale surfaces misaligning the buffer size
-    // in those cases it's better to just force nearest neighbor
-    // as long as the window is not animated. During those it'd look weird.
-    // UV will fixup it as well
-    const auto NEARESTNEIGHBORSET = g_pHyprOpenGL->m_RenderData.useNearestNeighbor;
-    if (MISALIGNEDFSV1)
-        g_pHyprOpenGL->m_RenderData.useNearestNeighbor = true;
-
     float rounding = RDATA->rounding;
 
     rounding -= 1; // to fix a border issue
@@ -179,41 +171,50 @@ static void renderSurface(struct wlr_surface* surface, int x, int y, void* data)
     if (RDATA->dontRound)
         rounding = 0;
 
-    const bool WINDOWOPAQUE    = RDATA->pWindow && RDATA->pWindow->m_pWLSurface.wlr() == surface ? RDATA->pWindow->opaque() : false;
-    const bool CANDISABLEBLEND = ALPHA >= 1.f && rounding == 0 && (WINDOWOPAQUE || surface->opaque);
+    const bool         WINDOWOPAQUE    = RDATA->pWindow && RDATA->pWindow->m_pWLSurface.wlr() == surface ? RDATA->pWindow->opaque() : false;
+    const bool         CANDISABLEBLEND = ALPHA >= 1.f && rounding == 0 && (WINDOWOPAQUE || surface->opaque);
+
+    SRenderPassElement element;
+    element.type           = RENDER_PASS_ELEMENT_SURFACE;
+    element.box            = windowBox;
+    element.clipBox        = g_pHyprOpenGL->m_RenderData.clipBox;
+    element.alpha          = ALPHA;
+    element.round          = rounding;
+    element.surface        = surface;
+    element.texture        = CTexture(TEXTURE);
+    element.uvTopLeft      = g_pHyprOpenGL->m_RenderData.primarySurfaceUVTopLeft;
+    element.uvBottomRight  = g_pHyprOpenGL->m_RenderData.primarySurfaceUVBottomRight;
+    element.blend          = !CANDISABLEBLEND;
+    element.discardMode    = g_pHyprOpenGL->m_RenderData.discardMode;
+    element.discardOpacity = g_pHyprOpenGL->m_RenderData.discardOpacity;
+    element.window         = g_pHyprOpenGL->m_pCurrentWindow;
+    element.layer          = g_pHyprOpenGL->m_pCurrentLayer;
+    element.pMonitor       = RDATA->pMonitor;
+    element.when           = g_pHyprRenderer->m_bBlockSurfaceFeedback ? nullptr : RDATA->when;
 
-    if (CANDISABLEBLEND)
-        g_pHyprOpenGL->blend(false);
-    else
-        g_pHyprOpenGL->blend(true);
+    // check for fractional scale surfaces misaligning the buffer size
+    // in those cases it's better to just force nearest neighbor
+    // as long as the window is not animated. During those it'd look weird.
+    // UV will fixup it as well
+    element.nearestNeighbor = g_pHyprOpenGL->m_RenderData.useNearestNeighbor || MISALIGNEDFSV1;
 
     if (RDATA->surface && surface == RDATA->surface) {
-        if (wlr_xwayland_surface_try_from_wlr_surface(surface) && !wlr_xwayland_surface_try_from_wlr_surface(surface)->has_alpha && ALPHA == 1.f) {
-            g_pHyprOpenGL->renderTexture(TEXTURE, &windowBox, ALPHA, rounding, true);
-        } else {
-            if (RDATA->blur)
-                g_pHyprOpenGL->renderTextureWithBlur(TEXTURE, &windowBox, ALPHA, surface, rounding, RDATA->blockBlurOptimization, RDATA->fadeAlpha);
-            else
-                g_pHyprOpenGL->renderTexture(TEXTURE, &windowBox, ALPHA, rounding, true);
+        if (!wlr_xwayland_surface_try_from_wlr_surface(surface) || wlr_xwayland_surface_try_from_wlr_surface(surface)->has_alpha || ALPHA != 1.f) {
+            element.blur                  = RDATA->blur;
+            element.blockBlurOptimization = RDATA->blockBlurOptimization;
+            element.blurAlpha             = RDATA->fadeAlpha;
         }
-    } else {
-        if (RDATA->blur && RDATA->popup)
-            g_pHyprOpenGL->renderTextureWithBlur(TEXTURE, &windowBox, ALPHA, surface, rounding, true, RDATA->fadeAlpha);
-        else
-            g_pHyprOpenGL->renderTexture(TEXTURE, &windowBox, ALPHA, rounding, true);
-    }
-
-    if (!g_pHyprRenderer->m_bBlockSurfaceFeedback) {
-        wlr_surface_send_frame_done(surface, RDATA->when);
-        wlr_presentation_surface_textured_on_output(surface, RDATA->pMonitor->output);
+    } else if (RDATA->blur && RDATA->popup) {
+        element.blur                  = true;
+        element.blockBlurOptimization = true;
+        element.blurAlpha             = RDATA->fadeAlpha;
     }
 
-    g_pHyprOpenGL->blend(true);
+    g_pHyprRenderer->m_sRenderPass.add(std::move(element));
 
     // reset props
     g_pHyprOpenGL->m_RenderData.primarySurfaceUVTopLeft     = Vector2D(-1, -1);
     g_pHyprOpenGL->m_RenderData.primarySurfaceUVBottomRight = Vector2D(-1, -1);
-    g_pHyprOpenGL->m_RenderData.useNearestNeighbor          = NEARESTNEIGHBORSET;
 }
 
 bool CHyprRenderer::shouldRenderWindow(PHLWINDOW pWindow, CMonitor* pMonitor) {
@@ -307,103 +308,122 @@ bool CHyprRenderer::shouldRenderWindow(PHLWINDOW pWindow) {
     return false;
 }
 
-void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* time) {
-    PHLWINDOW pWorkspaceWindow = nullptr;
+std::vector<PHLWINDOW> CHyprRenderer::getWindowsToRender(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+    // Only windows on visible, animating or force rendered workspaces, pinned windows and windows
+    // fading out of an active workspace are ever drawn, don't walk the ones parked on hidden workspaces.
+    std::vector<int64_t> workspaceIDs = {pWorkspace->m_iID, pMonitor->activeWorkspaceID()};
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
-
-    // loop over the tiled windows that are fading out
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (!shouldRenderWindow(w, pMonitor))
+    for (auto& ws : g_pCompositor->m_vWorkspaces) {
+        if (ws->m_iID == pWorkspace->m_iID || ws->m_iID == pMonitor->activeWorkspaceID())
             continue;
 
-        if (w->m_fAlpha.value() == 0.f)
-            continue;
+        if (ws->m_bVisible || ws->m_bForceRendering || ws->m_vRenderOffset.isBeingAnimated() || ws->m_fAlpha.isBeingAnimated())
+            workspaceIDs.emplace_back(ws->m_iID);
+    }
 
-        if (w->m_bIsFullscreen || w->m_bIsFloating)
-            continue;
+    return g_pCompositor->getWindowsOnWorkspaceIDs(workspaceIDs, true);
+}
 
-        if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+std::vector<CHyprRenderer::SWindowDraw> CHyprRenderer::getWorkspaceWindowDraws(CMonitor* pMonitor, PHLWORKSPACE pWorkspace) {
+    std::vector<SWindowDraw> draws;
 
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
-    }
+    const auto               WINDOWS = getWindowsToRender(pMonitor, pWorkspace);
 
-    // and floating ones too
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (!shouldRenderWindow(w, pMonitor))
-            continue;
+    if (pWorkspace->m_bHasFullscreenWindow) {
+        PHLWINDOW pWorkspaceWindow = nullptr;
 
-        if (w->m_fAlpha.value() == 0.f)
-            continue;
+        // the tiled windows that are fading out
+        for (auto& w : WINDOWS) {
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
 
-        if (w->m_bIsFullscreen || !w->m_bIsFloating)
-            continue;
+            if (w->m_fAlpha.value() == 0.f)
+                continue;
 
-        if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+            if (w->m_bIsFullscreen || w->m_bIsFloating)
+                continue;
 
-        if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
-            continue; // special on another are rendered as a part of the base pass
+            if (pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
 
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
-    }
+            draws.push_back({w, RENDER_PASS_ALL, true});
+        }
 
-    // TODO: this pass sucks
-    for (auto& w : g_pCompositor->m_vWindows) {
-        const auto PWORKSPACE = w->m_pWorkspace;
+        // and floating ones too
+        for (auto& w : WINDOWS) {
+            if (!shouldRenderWindow(w, pMonitor))
+                continue;
 
-        if (w->m_pWorkspace != pWorkspace || !w->m_bIsFullscreen) {
-            if (!(PWORKSPACE && (PWORKSPACE->m_vRenderOffset.isBeingAnimated() || PWORKSPACE->m_fAlpha.isBeingAnimated() || PWORKSPACE->m_bForceRendering)))
+            if (w->m_fAlpha.value() == 0.f)
                 continue;
 
-            if (w->m_iMonitorID != pMonitor->ID)
+            if (w->m_bIsFullscreen || !w->m_bIsFloating)
                 continue;
+
+            if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
+                continue; // special on another are rendered as a part of the base pass
+
+            draws.push_back({w, RENDER_PASS_ALL, true});
         }
 
-        if (!w->m_bIsFullscreen)
-            continue;
+        // TODO: this pass sucks
+        for (auto& w : WINDOWS) {
+            const auto PWORKSPACE = w->m_pWorkspace;
 
-        if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+            if (w->m_pWorkspace != pWorkspace || !w->m_bIsFullscreen) {
+                if (!(PWORKSPACE && (PWORKSPACE->m_vRenderOffset.isBeingAnimated() || PWORKSPACE->m_fAlpha.isBeingAnimated() || PWORKSPACE->m_bForceRendering)))
+                    continue;
 
-        if (shouldRenderWindow(w, pMonitor))
-            renderWindow(w, pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL, RENDER_PASS_ALL);
+                if (w->m_iMonitorID != pMonitor->ID)
+                    continue;
+            }
 
-        if (w->m_pWorkspace != pWorkspace)
-            continue;
+            if (!w->m_bIsFullscreen)
+                continue;
 
-        pWorkspaceWindow = w;
-    }
+            if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
 
-    if (!pWorkspaceWindow) {
-        // ?? happens sometimes...
-        pWorkspace->m_bHasFullscreenWindow = false;
-        return; // this will produce one blank frame. Oh well.
-    }
+            if (shouldRenderWindow(w, pMonitor))
+                draws.push_back({w, RENDER_PASS_ALL, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL});
 
-    // then render windows over fullscreen.
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (w->m_pWorkspace != pWorkspaceWindow->m_pWorkspace || (!w->m_bCreatedOverFullscreen && !w->m_bPinned) || (!w->m_bIsMapped && !w->m_bFadingOut) || w->m_bIsFullscreen)
-            continue;
+            if (w->m_pWorkspace != pWorkspace)
+                continue;
 
-        if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
+            pWorkspaceWindow = w;
+        }
 
-        if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
-            continue; // special on another are rendered as a part of the base pass
+        if (!pWorkspaceWindow) {
+            // ?? happens sometimes...
+            pWorkspace->m_bHasFullscreenWindow = false;
+            return getWorkspaceWindowDraws(pMonitor, pWorkspace);
+        }
 
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+        // then windows over fullscreen.
+        for (auto& w : WINDOWS) {
+            if (w->m_pWorkspace != pWorkspaceWindow->m_pWorkspace || (!w->m_bCreatedOverFullscreen && !w->m_bPinned) || (!w->m_bIsMapped && !w->m_bFadingOut) ||
+                w->m_bIsFullscreen)
+                continue;
+
+            if (w->m_iMonitorID == pWorkspace->m_iMonitorID && pWorkspace->m_bIsSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
+                continue; // special on another are rendered as a part of the base pass
+
+            draws.push_back({w, RENDER_PASS_ALL, true});
+        }
+
+        return draws;
     }
-}
 
-void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* time) {
     PHLWINDOW lastWindow;
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
-
     // Non-floating main
-    for (auto& w : g_pCompositor->m_vWindows) {
+    for (auto& w : WINDOWS) {
         if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
             continue;
 
@@ -422,15 +442,14 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, PHLWORKSPACE pWor
             continue;
         }
 
-        // render the bad boy
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_MAIN);
+        draws.push_back({w, RENDER_PASS_MAIN, true});
     }
 
     if (lastWindow)
-        renderWindow(lastWindow, pMonitor, time, true, RENDER_PASS_MAIN);
+        draws.push_back({lastWindow, RENDER_PASS_MAIN, true});
 
     // Non-floating popup
-    for (auto& w : g_pCompositor->m_vWindows) {
+    for (auto& w : WINDOWS) {
         if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
             continue;
 
@@ -443,12 +462,11 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, PHLWORKSPACE pWor
         if (!shouldRenderWindow(w, pMonitor))
             continue;
 
-        // render the bad boy
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_POPUP);
+        draws.push_back({w, RENDER_PASS_POPUP, true});
     }
 
     // floating on top
-    for (auto& w : g_pCompositor->m_vWindows) {
+    for (auto& w : WINDOWS) {
         if (w->isHidden() || (!w->m_bIsMapped && !w->m_bFadingOut))
             continue;
 
@@ -464,8 +482,39 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, PHLWORKSPACE pWor
         if (pWorkspace->m_bIsSpecialWorkspace && w->m_iMonitorID != pWorkspace->m_iMonitorID)
             continue; // special on another are rendered as a part of the base pass
 
+        draws.push_back({w, RENDER_PASS_ALL, true});
+    }
+
+    return draws;
+}
+
+std::vector<CHyprRenderer::SWindowDraw> CHyprRenderer::getPinnedWindowDraws(CMonitor* pMonitor) {
+    std::vector<SWindowDraw> draws;
+
+    for (auto& w : g_pCompositor->m_vWindows) {
+        if (w->isHidden() && !w->m_bIsMapped && !w->m_bFadingOut)
+            continue;
+
+        if (!w->m_bPinned || !w->m_bIsFloating)
+            continue;
+
+        if (!shouldRenderWindow(w, pMonitor))
+            continue;
+
+        draws.push_back({w, RENDER_PASS_ALL, true});
+    }
+
+    return draws;
+}
+
+void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* time) {
+    const auto DRAWS = getWorkspaceWindowDraws(pMonitor, pWorkspace);
+
+    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
+
+    for (auto& d : DRAWS) {
         // render the bad boy
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+        renderWindow(d.window, pMonitor, time, d.decorate, d.mode);
     }
 }
 
@@ -473,15 +522,20 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
     if (pWindow->isHidden())
         return;
 
+    if (!pWindow->m_bFadingOut && !pWindow->m_bIsMapped)
+        return;
+
+    // skip what opaque surfaces drawn after this window cover
+    CRegion preOccludedDamage{g_pHyprOpenGL->m_RenderData.damage};
+    m_sOcclusion.occlude(g_pHyprOpenGL->m_RenderData.damage, pWindow, mode == RENDER_PASS_POPUP);
+
     if (pWindow->m_bFadingOut) {
         if (pMonitor->ID == pWindow->m_iMonitorID) // TODO: fix this
             g_pHyprOpenGL->renderSnapshot(pWindow);
+        g_pHyprOpenGL->m_RenderData.damage = preOccludedDamage;
         return;
     }
 
-    if (!pWindow->m_bIsMapped)
-        return;
-
     TRACY_GPU_ZONE("RenderWindow");
 
     const auto  PWORKSPACE = pWindow->m_pWorkspace;
@@ -528,8 +582,11 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
     EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOW);
 
     if (*PDIMAROUND && pWindow->m_sAdditionalConfigData.dimAround && !m_bRenderingSnapshot && mode != RENDER_PASS_POPUP) {
-        CBox monbox = {0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.y};
-        g_pHyprOpenGL->renderRect(&monbox, CColor(0, 0, 0, *PDIMAROUND * renderdata.alpha * renderdata.fadeAlpha));
+        SRenderPassElement dim;
+        dim.type  = RENDER_PASS_ELEMENT_RECT;
+        dim.box   = {0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.y};
+        dim.color = CColor(0, 0, 0, *PDIMAROUND * renderdata.alpha * renderdata.fadeAlpha);
+        m_sRenderPass.add(std::move(dim));
     }
 
     renderdata.x += pWindow->m_vFloatingOffset.x;
@@ -545,6 +602,9 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
     // render window decorations first, if not fullscreen full
     if (mode == RENDER_PASS_ALL || mode == RENDER_PASS_MAIN) {
 
+        // decorations and transformers draw directly
+        m_sRenderPass.flush();
+
         const bool TRANSFORMERSPRESENT = !pWindow->m_vTransformers.empty();
 
         if (TRANSFORMERSPRESENT) {
@@ -576,10 +636,18 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
             g_pHyprOpenGL->m_RenderData.useNearestNeighbor = true;
 
         if (!pWindow->m_sAdditionalConfigData.forceNoBlur && pWindow->m_pWLSurface.small() && !pWindow->m_pWLSurface.m_bFillIgnoreSmall && renderdata.blur && *PBLUR) {
-            CBox wb = {renderdata.x - pMonitor->vecPosition.x, renderdata.y - pMonitor->vecPosition.y, renderdata.w, renderdata.h};
-            wb.scale(pMonitor->scale).round();
-            g_pHyprOpenGL->renderRectWithBlur(&wb, CColor(0, 0, 0, 0), renderdata.dontRound ? 0 : renderdata.rounding - 1, renderdata.fadeAlpha,
-                                              g_pHyprOpenGL->shouldUseNewBlurOptimizations(nullptr, pWindow));
+            SRenderPassElement blur;
+            blur.type      = RENDER_PASS_ELEMENT_RECT;
+            blur.box       = CBox{renderdata.x - pMonitor->vecPosition.x, renderdata.y - pMonitor->vecPosition.y, renderdata.w, renderdata.h}.scale(pMonitor->scale).round();
+            blur.clipBox   = g_pHyprOpenGL->m_RenderData.clipBox;
+            blur.color     = CColor(0, 0, 0, 0);
+            blur.round     = renderdata.dontRound ? 0 : renderdata.rounding - 1;
+            blur.blur      = true;
+            blur.blurAlpha = renderdata.fadeAlpha;
+            blur.xray      = g_pHyprOpenGL->shouldUseNewBlurOptimizations(nullptr, pWindow);
+            blur.window    = pWindow;
+            m_sRenderPass.add(std::move(blur));
+
             renderdata.blur = false;
         }
 
@@ -587,6 +655,8 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
 
         g_pHyprOpenGL->m_RenderData.useNearestNeighbor = false;
 
+        m_sRenderPass.flush();
+
         if (renderdata.decorate) {
             for (auto& wd : pWindow->m_dWindowDecorations) {
                 if (wd->getDecorationLayer() != DECORATION_LAYER_OVER)
@@ -644,6 +714,8 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
 
             g_pHyprOpenGL->m_RenderData.useNearestNeighbor = false;
 
+            m_sRenderPass.flush();
+
             g_pHyprOpenGL->m_RenderData.discardMode    = DM;
             g_pHyprOpenGL->m_RenderData.discardOpacity = DA;
         }
@@ -658,23 +730,37 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, CMonitor* pMonitor, timespec
         }
     }
 
+    m_sRenderPass.flush();
+
     EMIT_HOOK_EVENT("render", RENDER_POST_WINDOW);
 
     g_pHyprOpenGL->m_pCurrentWindow.reset();
     g_pHyprOpenGL->m_RenderData.clipBox = CBox();
+    g_pHyprOpenGL->m_RenderData.damage  = preOccludedDamage;
 }
 
 void CHyprRenderer::renderLayer(PHLLS pLayer, CMonitor* pMonitor, timespec* time, bool popups) {
     static auto PDIMAROUND = CConfigValue<Hyprlang::FLOAT>("decoration:dim_around");
 
+    // skip what opaque surfaces drawn after this layer cover. Popups are drawn above everything.
+    CRegion preOccludedDamage{g_pHyprOpenGL->m_RenderData.damage};
+    if (!popups)
+        m_sOcclusion.occlude(g_pHyprOpenGL->m_RenderData.damage, pLayer);
+
     if (*PDIMAROUND && pLayer->dimAround && !m_bRenderingSnapshot && !popups) {
-        CBox monbox = {0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.y};
-        g_pHyprOpenGL->renderRect(&monbox, CColor(0, 0, 0, *PDIMAROUND * pLayer->alpha.value()));
+        SRenderPassElement dim;
+        dim.type  = RENDER_PASS_ELEMENT_RECT;
+        dim.box   = {0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecTransformedSize.y};
+        dim.color = CColor(0, 0, 0, *PDIMAROUND * pLayer->alpha.value());
+        m_sRenderPass.add(std::move(dim));
     }
 
     if (pLayer->fadingOut) {
+        m_sRenderPass.flush();
+
         if (!popups)
             g_pHyprOpenGL->renderSnapshot(pLayer);
+        g_pHyprOpenGL->m_RenderData.damage = preOccludedDamage;
         return;
     }
 
@@ -714,10 +800,13 @@ void CHyprRenderer::renderLayer(PHLLS pLayer, CMonitor* pMonitor, timespec* time
     if (popups)
         wlr_layer_surface_v1_for_each_popup_surface(pLayer->layerSurface, renderSurface, &renderdata);
 
+    m_sRenderPass.flush();
+
     g_pHyprOpenGL->m_pCurrentLayer             = nullptr;
     g_pHyprOpenGL->m_RenderData.clipBox        = {};
     g_pHyprOpenGL->m_RenderData.discardMode    = DM;
     g_pHyprOpenGL->m_RenderData.discardOpacity = DA;
+    g_pHyprOpenGL->m_RenderData.damage         = preOccludedDamage;
 }
 
 void CHyprRenderer::renderIMEPopup(CInputPopup* pPopup, CMonitor* pMonitor, timespec* time) {
@@ -734,6 +823,8 @@ void CHyprRenderer::renderIMEPopup(CInputPopup* pPopup, CMonitor* pMonitor, time
     renderdata.h        = SURF->current.height;
 
     wlr_surface_for_each_surface(SURF, renderSurface, &renderdata);
+
+    m_sRenderPass.flush();
 }
 
 void CHyprRenderer::renderSessionLockSurface(SSessionLockSurface* pSurface, CMonitor* pMonitor, timespec* time) {
@@ -746,6 +837,8 @@ void CHyprRenderer::renderSessionLockSurface(SSessionLockSurface* pSurface, CMon
     renderdata.h        = pMonitor->vecSize.y;
 
     wlr_surface_for_each_surface(pSurface->surface.lock()->surface(), renderSurface, &renderdata);
+
+    m_sRenderPass.flush();
 }
 
 void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* time, const Vector2D& translate, const float& scale) {
@@ -757,9 +850,9 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
 
     SRenderModifData RENDERMODIFDATA;
     if (translate != Vector2D{0, 0})
-        RENDERMODIFDATA.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, translate});
+        RENDERMODIFDATA.push(SRenderModifData::eRenderModifType::RMOD_TYPE_TRANSLATE, translate);
     if (scale != 1.f)
-        RENDERMODIFDATA.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, scale});
+        RENDERMODIFDATA.push(SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, scale);
 
     if (!pMonitor)
         return;
@@ -805,8 +898,8 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
         return;
     }
 
-    // for storing damage when we optimize for occlusion
-    CRegion preOccludedDamage{g_pHyprOpenGL->m_RenderData.damage};
+    // what's covered by opaque surfaces above it doesn't need drawing
+    m_sOcclusion.build(pMonitor, pWorkspace);
 
     // Render layer surfaces below windows for monitor
     // if we have a fullscreen, opaque window that convers the screen, we can skip this.
@@ -815,8 +908,9 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
     if (!pWorkspace->m_bHasFullscreenWindow || pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL || !PFULLWINDOW || PFULLWINDOW->m_vRealSize.isBeingAnimated() ||
         !PFULLWINDOW->opaque() || pWorkspace->m_vRenderOffset.value() != Vector2D{}) {
 
-        if (!g_pHyprOpenGL->m_RenderData.pCurrentMonData->blurFBShouldRender)
-            setOccludedForBackLayers(g_pHyprOpenGL->m_RenderData.damage, pWorkspace);
+        // for storing damage when we optimize for occlusion
+        CRegion preOccludedDamage{g_pHyprOpenGL->m_RenderData.damage};
+        m_sOcclusion.occludeBackground(g_pHyprOpenGL->m_RenderData.damage);
 
         g_pHyprOpenGL->blend(false);
         if (!canSkipBackBufferClear(pMonitor)) {
@@ -827,27 +921,20 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
         }
         g_pHyprOpenGL->blend(true);
 
+        g_pHyprOpenGL->m_RenderData.damage = preOccludedDamage;
+
         for (auto& ls : pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]) {
             renderLayer(ls, pMonitor, time);
         }
         for (auto& ls : pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]) {
             renderLayer(ls, pMonitor, time);
         }
-
-        g_pHyprOpenGL->m_RenderData.damage = preOccludedDamage;
     }
 
     // pre window pass
     g_pHyprOpenGL->preWindowPass();
 
-    setOccludedForMainWorkspace(g_pHyprOpenGL->m_RenderData.damage, pWorkspace);
-
-    if (pWorkspace->m_bHasFullscreenWindow)
-        renderWorkspaceWindowsFullscreen(pMonitor, pWorkspace, time);
-    else
-        renderWorkspaceWindows(pMonitor, pWorkspace, time);
-
-    g_pHyprOpenGL->m_RenderData.damage = preOccludedDamage;
+    renderWorkspaceWindows(pMonitor, pWorkspace, time);
 
     // and then special
     for (auto& ws : g_pCompositor->m_vWorkspaces) {
@@ -871,27 +958,14 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
 
     // special
     for (auto& ws : g_pCompositor->m_vWorkspaces) {
-        if (ws->m_fAlpha.value() > 0.f && ws->m_bIsSpecialWorkspace) {
-            if (ws->m_bHasFullscreenWindow)
-                renderWorkspaceWindowsFullscreen(pMonitor, ws, time);
-            else
-                renderWorkspaceWindows(pMonitor, ws, time);
-        }
+        if (ws->m_fAlpha.value() > 0.f && ws->m_bIsSpecialWorkspace)
+            renderWorkspaceWindows(pMonitor, ws, time);
     }
 
     // pinned always above
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (w->isHidden() && !w->m_bIsMapped && !w->m_bFadingOut)
-            continue;
-
-        if (!w->m_bPinned || !w->m_bIsFloating)
-            continue;
-
-        if (!shouldRenderWindow(w, pMonitor))
-            continue;
-
+    for (auto& d : getPinnedWindowDraws(pMonitor)) {
         // render the bad boy
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+        renderWindow(d.window, pMonitor, time, d.decorate, d.mode);
     }
 
     EMIT_HOOK_EVENT("render", RENDER_POST_WINDOWS);
@@ -918,6 +992,8 @@ void CHyprRenderer::renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPAC
 
     renderDragIcon(pMonitor, time);
 
+    m_sOcclusion.reset();
+
     //g_pHyprOpenGL->restoreMatrix();
     g_pHyprOpenGL->m_RenderData.renderModif = {};
 }
@@ -1235,6 +1311,9 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
         pMonitor->forceFullFrames                      = 10;
     }
 
+    // beginRender hands out the damage of the buffer's age, this is only what changed since the last frame
+    CRegion changedDamage{&pMonitor->damage.current};
+
     CRegion damage, finalDamage;
     if (!beginRender(pMonitor, damage, RENDER_MODE_NORMAL)) {
         Debug::log(ERR, "renderer: couldn't beginRender()!");
@@ -1247,10 +1326,14 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
         return;
     }
 
+    m_sRenderPass.beginFrame(pMonitor);
+    m_sOcclusion.beginFrame(pMonitor);
+
     // if we have no tracking or full tracking, invalidate the entire monitor
     if (*PDAMAGETRACKINGMODE == DAMAGE_TRACKING_NONE || *PDAMAGETRACKINGMODE == DAMAGE_TRACKING_MONITOR || pMonitor->forceFullFrames > 0 || damageBlinkCleanup > 0) {
         damage      = {0, 0, (int)pMonitor->vecTransformedSize.x * 10, (int)pMonitor->vecTransformedSize.y * 10};
         finalDamage = damage;
+        changedDamage = damage;
     } else {
         static auto PBLURENABLED = CConfigValue<Hyprlang::INT>("decoration:blur:enabled");
 
@@ -1265,6 +1348,7 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
 
             // now, prep the damage, get the extended damage region
             wlr_region_expand(damage.pixman(), damage.pixman(), BLURRADIUS); // expand for proper blurring
+            wlr_region_expand(changedDamage.pixman(), changedDamage.pixman(), BLURRADIUS);
 
             finalDamage = damage;
 
@@ -1372,7 +1456,19 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
 
     pMonitor->state.wlr()->tearing_page_flip = shouldTear;
 
-    if (!pMonitor->state.commit()) {
+    if (*PDAMAGEBLINK)
+        changedDamage.add(damage);
+
+    // for screencopy, which gets the commit event synchronously
+    wlr_region_transform(pMonitor->commitDamage.region.pixman(), changedDamage.pixman(), wlr_output_transform_invert(pMonitor->output->transform),
+                         (int)pMonitor->vecTransformedSize.x, (int)pMonitor->vecTransformedSize.y);
+    pMonitor->commitDamage.known = true;
+
+    const bool COMMITTED = pMonitor->state.commit();
+
+    pMonitor->commitDamage.known = false;
+
+    if (!COMMITTED) {
 
         if (UNLOCK_SC)
             wlr_output_lock_software_cursors(pMonitor->output, false);
@@ -1394,6 +1490,7 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
     pMonitor->pendingFrame = false;
 
     const float µs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - renderStart).count() / 1000.f;
+    pMonitor->frameTiming.onCommit(µs / 1000.f);
     g_pDebugOverlay->renderData(pMonitor, µs);
 
     if (*PDEBUGOVERLAY == 1) {
@@ -1424,7 +1521,7 @@ void CHyprRenderer::renderWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace,
 }
 
 void CHyprRenderer::sendFrameEventsToWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* now) {
-    for (auto& w : g_pCompositor->m_vWindows) {
+    for (auto& w : getWindowsToRender(pMonitor, pWorkspace)) {
         if (w->isHidden() || !w->m_bIsMapped || w->m_bFadingOut || !w->m_pWLSurface.wlr())
             continue;
 
@@ -1766,16 +1863,23 @@ void CHyprRenderer::damageSurface(wlr_surface* pSurface, double x, double y, dou
                    damageBox.pixman()->extents.x2 - damageBox.pixman()->extents.x1, damageBox.pixman()->extents.y2 - damageBox.pixman()->extents.y1);
 }
 
-void CHyprRenderer::damageWindow(PHLWINDOW pWindow, bool forceFull) {
-    if (g_pCompositor->m_bUnsafeState)
-        return;
-
+CBox CHyprRenderer::getWindowDamageBox(PHLWINDOW pWindow) {
     CBox       windowBox        = pWindow->getFullWindowBoundingBox();
     const auto PWINDOWWORKSPACE = pWindow->m_pWorkspace;
     if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_vRenderOffset.isBeingAnimated() && !pWindow->m_bPinned)
         windowBox.translate(PWINDOWWORKSPACE->m_vRenderOffset.value());
     windowBox.translate(pWindow->m_vFloatingOffset);
 
+    return windowBox;
+}
+
+void CHyprRenderer::damageWindow(PHLWINDOW pWindow, bool forceFull) {
+    // every surface commit and animation tick ends up here, so a single window is damaged directly instead of through damageWindows
+    if (g_pCompositor->m_bUnsafeState)
+        return;
+
+    const CBox windowBox = getWindowDamageBox(pWindow);
+
     for (auto& m : g_pCompositor->m_vMonitors) {
         if (forceFull || g_pHyprRenderer->shouldRenderWindow(pWindow, m.get())) { // only damage if window is rendered on monitor
             CBox fixedDamageBox = {windowBox.x - m->vecPosition.x, windowBox.y - m->vecPosition.y, windowBox.width, windowBox.height};
@@ -1793,6 +1897,46 @@ void CHyprRenderer::damageWindow(PHLWINDOW pWindow, bool forceFull) {
         Debug::log(LOG, "Damage: Window ({}): xy: {}, {} wh: {}, {}", pWindow->m_szTitle, windowBox.x, windowBox.y, windowBox.width, windowBox.height);
 }
 
+void CHyprRenderer::damageWindows(const std::vector<PHLWINDOW>& windows, bool forceFull) {
+    if (g_pCompositor->m_bUnsafeState || windows.empty())
+        return;
+
+    // nothing to batch
+    if (windows.size() == 1) {
+        damageWindow(windows.front(), forceFull);
+        return;
+    }
+
+    static auto          PLOGDAMAGE = CConfigValue<Hyprlang::INT>("debug:log_damage");
+
+    std::vector<CRegion> damage(g_pCompositor->m_vMonitors.size());
+
+    for (auto& w : windows) {
+        const CBox windowBox = getWindowDamageBox(w);
+
+        for (size_t i = 0; i < g_pCompositor->m_vMonitors.size(); ++i) {
+            const auto& m = g_pCompositor->m_vMonitors[i];
+
+            if (forceFull || g_pHyprRenderer->shouldRenderWindow(w, m.get())) { // only damage if window is rendered on monitor
+                CBox fixedDamageBox = {windowBox.x - m->vecPosition.x, windowBox.y - m->vecPosition.y, windowBox.width, windowBox.height};
+                fixedDamageBox.scale(m->scale);
+                damage[i].add(fixedDamageBox);
+            }
+        }
+
+        for (auto& wd : w->m_dWindowDecorations)
+            wd->damageEntire();
+
+        if (*PLOGDAMAGE)
+            Debug::log(LOG, "Damage: Window ({}): xy: {}, {} wh: {}, {}", w->m_szTitle, windowBox.x, windowBox.y, windowBox.width, windowBox.height);
+    }
+
+    for (size_t i = 0; i < g_pCompositor->m_vMonitors.size(); ++i) {
+        if (!damage[i].empty())
+            g_pCompositor->m_vMonitors[i]->addDamage(&damage[i]);
+    }
+}
+
 void CHyprRenderer::damageMonitor(CMonitor* pMonitor) {
     if (g_pCompositor->m_bUnsafeState || pMonitor->isMirror())
         return;
@@ -1872,6 +2016,8 @@ void CHyprRenderer::renderDragIcon(CMonitor* pMonitor, timespec* time) {
 
     wlr_surface_for_each_surface(g_pInputManager->m_sDrag.dragIcon->surface, renderSurface, &renderdata);
 
+    m_sRenderPass.flush();
+
     CBox box = {g_pInputManager->m_sDrag.pos.x - 2, g_pInputManager->m_sDrag.pos.y - 2, g_pInputManager->m_sDrag.dragIcon->surface->current.width + 4,
                 g_pInputManager->m_sDrag.dragIcon->surface->current.height + 4};
     g_pHyprRenderer->damageBox(&box);
@@ -2415,21 +2561,8 @@ bool CHyprRenderer::shouldRenderCursor() {
 }
 
 std::tuple<float, float, float> CHyprRenderer::getRenderTimes(CMonitor* pMonitor) {
-    const auto POVERLAY = &g_pDebugOverlay->m_mMonitorOverlays[pMonitor];
-
-    float      avgRenderTime = 0;
-    float      maxRenderTime = 0;
-    float      minRenderTime = 9999;
-    for (auto& rt : POVERLAY->m_dLastRenderTimes) {
-        if (rt > maxRenderTime)
-            maxRenderTime = rt;
-        if (rt < minRenderTime)
-            minRenderTime = rt;
-        avgRenderTime += rt;
-    }
-    avgRenderTime /= POVERLAY->m_dLastRenderTimes.size() == 0 ? 1 : POVERLAY->m_dLastRenderTimes.size();
-
-    return std::make_tuple<>(avgRenderTime, maxRenderTime, minRenderTime);
+    auto& timing = pMonitor->frameTiming;
+    return std::make_tuple<>(timing.renderTimeAverage(), timing.renderTimePercentile(100), timing.renderTimePercentile(0));
 }
 
 static int handleCrashLoop(void* data) {
@@ -2463,62 +2596,6 @@ void CHyprRenderer::initiateManualCrash() {
     **PDT = 0;
 }
 
-void CHyprRenderer::setOccludedForMainWorkspace(CRegion& region, PHLWORKSPACE pWorkspace) {
-    CRegion    rg;
-
-    const auto PMONITOR = g_pCompositor->getMonitorFromID(pWorkspace->m_iMonitorID);
-
-    if (!PMONITOR->activeSpecialWorkspace)
-        return;
-
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (!w->m_bIsMapped || w->isHidden() || w->m_pWorkspace != PMONITOR->activeSpecialWorkspace)
-            continue;
-
-        if (!w->opaque())
-            continue;
-
-        const auto     ROUNDING = w->rounding() * PMONITOR->scale;
-        const Vector2D POS  = w->m_vRealPosition.value() + Vector2D{ROUNDING, ROUNDING} - PMONITOR->vecPosition + (w->m_bPinned ? Vector2D{} : pWorkspace->m_vRenderOffset.value());
-        const Vector2D SIZE = w->m_vRealSize.value() - Vector2D{ROUNDING * 2, ROUNDING * 2};
-
-        CBox           box = {POS.x, POS.y, SIZE.x, SIZE.y};
-
-        box.scale(PMONITOR->scale);
-
-        rg.add(box);
-    }
-
-    region.subtract(rg);
-}
-
-void CHyprRenderer::setOccludedForBackLayers(CRegion& region, PHLWORKSPACE pWorkspace) {
-    CRegion    rg;
-
-    const auto PMONITOR = g_pCompositor->getMonitorFromID(pWorkspace->m_iMonitorID);
-
-    for (auto& w : g_pCompositor->m_vWindows) {
-        if (!w->m_bIsMapped || w->isHidden() || w->m_pWorkspace != pWorkspace)
-            continue;
-
-        if (!w->opaque())
-            continue;
-
-        const auto     ROUNDING = w->rounding() * PMONITOR->scale;
-        const Vector2D POS  = w->m_vRealPosition.value() + Vector2D{ROUNDING, ROUNDING} - PMONITOR->vecPosition + (w->m_bPinned ? Vector2D{} : pWorkspace->m_vRenderOffset.value());
-        const Vector2D SIZE = w->m_vRealSize.value() - Vector2D{ROUNDING * 2, ROUNDING * 2};
-
-        CBox           box = {POS.x, POS.y, SIZE.x, SIZE.y};
-
-        box.scale(PMONITOR->scale);
-        g_pHyprOpenGL->m_RenderData.renderModif.applyToBox(box);
-
-        rg.add(box);
-    }
-
-    region.subtract(rg);
-}
-
 bool CHyprRenderer::canSkipBackBufferClear(CMonitor* pMonitor) {
     for (auto& ls : pMonitor->m_aLayerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]) {
         if (!ls->layerSurface)
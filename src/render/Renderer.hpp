@@ -5,6 +5,8 @@
 #include "../helpers/Monitor.hpp"
 #include "OpenGL.hpp"
 #include "Renderbuffer.hpp"
+#include "RenderPass.hpp"
+#include "Occlusion.hpp"
 #include "../helpers/Timer.hpp"
 #include "../helpers/Region.hpp"
 
@@ -47,6 +49,7 @@ class CHyprRenderer {
     void                            arrangeLayersForMonitor(const int&);
     void                            damageSurface(wlr_surface*, double, double, double scale = 1.0);
     void                            damageWindow(PHLWINDOW, bool forceFull = false);
+    void                            damageWindows(const std::vector<PHLWINDOW>&, bool forceFull = false); // one damage region per monitor
     void                            damageBox(CBox*);
     void                            damageBox(const int& x, const int& y, const int& w, const int& h);
     void                            damageRegion(const CRegion&);
@@ -61,8 +64,6 @@ class CHyprRenderer {
     void                            calculateUVForSurface(PHLWINDOW, wlr_surface*, bool main = false, const Vector2D& projSize = {}, bool fixMisalignedFSV1 = false);
     std::tuple<float, float, float> getRenderTimes(CMonitor* pMonitor); // avg max min
     void                            renderLockscreen(CMonitor* pMonitor, timespec* now, const CBox& geometry);
-    void                            setOccludedForBackLayers(CRegion& region, PHLWORKSPACE pWorkspace);
-    void                            setOccludedForMainWorkspace(CRegion& region, PHLWORKSPACE pWorkspace); // TODO: merge occlusion methods
     bool                            canSkipBackBufferClear(CMonitor* pMonitor);
     void                            recheckSolitaryForMonitor(CMonitor* pMonitor);
     void                            setCursorSurface(wlr_surface* surf, int hotspotX, int hotspotY, bool force = false);
@@ -100,6 +101,12 @@ class CHyprRenderer {
 
     CTimer           m_tRenderTimer;
 
+    // what renderWindow / renderLayer draw goes through here, see CRenderPass
+    CRenderPass      m_sRenderPass;
+
+    // what renderAllClientsForWorkspace can skip drawing, see COcclusion
+    COcclusion       m_sOcclusion;
+
     struct {
         int                         hotspotX;
         int                         hotspotY;
@@ -109,8 +116,7 @@ class CHyprRenderer {
 
   private:
     void           arrangeLayerArray(CMonitor*, const std::vector<PHLLS>&, bool, CBox*);
-    void           renderWorkspaceWindowsFullscreen(CMonitor*, PHLWORKSPACE, timespec*); // renders workspace windows (fullscreen) (tiled, floating, pinned, but no special)
-    void           renderWorkspaceWindows(CMonitor*, PHLWORKSPACE, timespec*);           // renders workspace windows (no fullscreen) (tiled, floating, pinned, but no special)
+    void           renderWorkspaceWindows(CMonitor*, PHLWORKSPACE, timespec*); // renders workspace windows (tiled, floating, pinned, but no special)
     void           renderWindow(PHLWINDOW, CMonitor*, timespec*, bool, eRenderPassMode, bool ignorePosition = false, bool ignoreAllGeometry = false);
     void           renderLayer(PHLLS, CMonitor*, timespec*, bool popups = false);
     void           renderSessionLockSurface(SSessionLockSurface*, CMonitor*, timespec*);
@@ -119,6 +125,19 @@ class CHyprRenderer {
     void           renderWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* now, const CBox& geometry);
     void           sendFrameEventsToWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* now); // sends frame displayed events but doesn't actually render anything
     void           renderAllClientsForWorkspace(CMonitor* pMonitor, PHLWORKSPACE pWorkspace, timespec* now, const Vector2D& translate = {0, 0}, const float& scale = 1.f);
+    CBox           getWindowDamageBox(PHLWINDOW); // global, where the window is drawn right now
+
+    std::vector<PHLWINDOW> getWindowsToRender(CMonitor*, PHLWORKSPACE); // windows that can pass shouldRenderWindow, in z order
+
+    struct SWindowDraw {
+        PHLWINDOW       window;
+        eRenderPassMode mode     = RENDER_PASS_ALL;
+        bool            decorate = true;
+    };
+
+    // in paint order. Occlusion walks the same lists backwards, so they're the only place deciding what's above what.
+    std::vector<SWindowDraw> getWorkspaceWindowDraws(CMonitor*, PHLWORKSPACE);
+    std::vector<SWindowDraw> getPinnedWindowDraws(CMonitor*);
 
     bool           m_bCursorHidden        = false;
     bool           m_bCursorHasSurface    = false;
@@ -140,6 +159,7 @@ class CHyprRenderer {
     friend class CHyprOpenGLImpl;
     friend class CToplevelExportProtocolManager;
     friend class CInputManager;
+    friend class COcclusion;
 };
 
 inline std::unique_ptr<CHyprRenderer> g_pHyprRenderer;
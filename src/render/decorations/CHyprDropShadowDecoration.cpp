@@ -2,6 +2,7 @@
 
 #include "../../Compositor.hpp"
 #include "../../config/ConfigValue.hpp"
+#include "ShadowTextureCache.hpp"
 
 CHyprDropShadowDecoration::CHyprDropShadowDecoration(PHLWINDOW pWindow) : IHyprWindowDecoration(pWindow) {
     m_pWindow = pWindow;
@@ -110,6 +111,7 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a) {
     static auto PSHADOWIGNOREWINDOW = CConfigValue<Hyprlang::INT>("decoration:shadow_ignore_window");
     static auto PSHADOWSCALE        = CConfigValue<Hyprlang::FLOAT>("decoration:shadow_scale");
     static auto PSHADOWOFFSET       = CConfigValue<Hyprlang::VEC2>("decoration:shadow_offset");
+    static auto PSHADOWPOWER        = CConfigValue<Hyprlang::INT>("decoration:shadow_render_power");
 
     if (*PSHADOWS != 1)
         return; // disabled
@@ -152,7 +154,20 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a) {
 
     fullBox.scale(pMonitor->scale).round();
 
-    if (*PSHADOWIGNOREWINDOW) {
+    const int RANGE          = *PSHADOWSIZE * pMonitor->scale;
+    const int ROUNDINGSCALED = ROUNDING * pMonitor->scale;
+    const int CORNER         = RANGE + ROUNDINGSCALED;
+
+    // the window can only be cut out of the cached texture if it sits exactly range pixels inside the shadow
+    const bool WINDOWALIGNED = SHADOWSCALE == 1.f && Vector2D{*PSHADOWOFFSET} == Vector2D{};
+    const bool CANSLICE      = RANGE > 0 && fullBox.width >= 2 * CORNER + 1 && fullBox.height >= 2 * CORNER + 1 && (!*PSHADOWIGNOREWINDOW || WINDOWALIGNED);
+
+    if (CANSLICE) {
+        const auto PTEX = g_pShadowTextureCache->get(RANGE, ROUNDINGSCALED, std::clamp((int)*PSHADOWPOWER, 1, 4), *PSHADOWIGNOREWINDOW);
+
+        // with the window cut out, the middle is empty and not worth drawing
+        g_pHyprOpenGL->renderNineSlice(*PTEX, &fullBox, CORNER, PWINDOW->m_cRealShadowColor.value(), a, !*PSHADOWIGNOREWINDOW);
+    } else if (*PSHADOWIGNOREWINDOW) {
         CBox windowBox = m_bLastWindowBox;
         CBox withDecos = m_bLastWindowBoxWithDecos;
 
@@ -179,6 +194,9 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a) {
         g_pHyprOpenGL->m_RenderData.damage.subtract(windowBox.copy().expand(-ROUNDING * pMonitor->scale)).intersect(saveDamage);
         g_pHyprOpenGL->m_RenderData.renderModif.applyToRegion(g_pHyprOpenGL->m_RenderData.damage);
 
+        g_pHyprOpenGL->useEffectFB(alphaFB);
+        g_pHyprOpenGL->useEffectFB(alphaSwapFB);
+
         alphaFB.bind();
 
         // build the matte
@@ -1,27 +1,16 @@
 #include "CHyprGroupBarDecoration.hpp"
+#include "GroupBarTextureCache.hpp"
 #include "../../Compositor.hpp"
 #include "../../config/ConfigValue.hpp"
 #include <ranges>
-#include <pango/pangocairo.h>
 
-// shared things to conserve VRAM
-static CTexture m_tGradientActive;
-static CTexture m_tGradientInactive;
-static CTexture m_tGradientLockedActive;
-static CTexture m_tGradientLockedInactive;
-
-constexpr int   BAR_INDICATOR_HEIGHT   = 3;
-constexpr int   BAR_PADDING_OUTER_VERT = 2;
-constexpr int   BAR_TEXT_PAD           = 2;
-constexpr int   BAR_HORIZONTAL_PADDING = 2;
+constexpr int BAR_INDICATOR_HEIGHT   = 3;
+constexpr int BAR_PADDING_OUTER_VERT = 2;
+constexpr int BAR_TEXT_PAD           = 2;
+constexpr int BAR_HORIZONTAL_PADDING = 2;
 
 CHyprGroupBarDecoration::CHyprGroupBarDecoration(PHLWINDOW pWindow) : IHyprWindowDecoration(pWindow) {
-    static auto PGRADIENTS = CConfigValue<Hyprlang::INT>("group:groupbar:enabled");
-    static auto PENABLED   = CConfigValue<Hyprlang::INT>("group:groupbar:gradients");
-    m_pWindow              = pWindow;
-
-    if (m_tGradientActive.m_iTexID == 0 && *PENABLED && *PGRADIENTS)
-        refreshGroupBarGradients();
+    m_pWindow = pWindow;
 }
 
 CHyprGroupBarDecoration::~CHyprGroupBarDecoration() {}
@@ -143,195 +132,23 @@ void CHyprGroupBarDecoration::draw(CMonitor* pMonitor, float a) {
         rect.scale(pMonitor->scale);
 
         if (*PGRADIENTS) {
-            const auto& GRADIENTTEX = (m_dwGroupMembers[i].lock() == g_pCompositor->m_pLastWindow.lock() ? (GROUPLOCKED ? m_tGradientLockedActive : m_tGradientActive) :
-                                                                                                           (GROUPLOCKED ? m_tGradientLockedInactive : m_tGradientInactive));
-            if (GRADIENTTEX.m_iTexID != 0)
-                g_pHyprOpenGL->renderTexture(GRADIENTTEX, &rect, 1.0);
+            const auto PGRADIENT = m_dwGroupMembers[i].lock() == g_pCompositor->m_pLastWindow.lock() ? PCOLACTIVE : PCOLINACTIVE;
+            const auto PTEX      = g_pGroupBarTextureCache->gradient(*PGRADIENT, std::round(rect.height));
+            g_pHyprOpenGL->renderTexture(*PTEX, &rect, 1.0);
         }
 
         if (*PRENDERTITLES) {
-            CTitleTex* pTitleTex = textureFromTitle(m_dwGroupMembers[i].lock()->m_szTitle);
-
-            if (!pTitleTex)
-                pTitleTex = m_sTitleTexs.titleTexs
-                                .emplace_back(std::make_unique<CTitleTex>(m_dwGroupMembers[i].lock(),
-                                                                          Vector2D{m_fBarWidth * pMonitor->scale, (*PTITLEFONTSIZE + 2 * BAR_TEXT_PAD) * pMonitor->scale}))
-                                .get();
+            const auto PTEX = g_pGroupBarTextureCache->title(m_dwGroupMembers[i].lock()->m_szTitle,
+                                                             Vector2D{m_fBarWidth * pMonitor->scale, (*PTITLEFONTSIZE + 2 * BAR_TEXT_PAD) * pMonitor->scale});
 
             rect.y += (ASSIGNEDBOX.h / 2.0 - (*PTITLEFONTSIZE + 2 * BAR_TEXT_PAD) / 2.0) * pMonitor->scale;
             rect.height = (*PTITLEFONTSIZE + 2 * BAR_TEXT_PAD) * pMonitor->scale;
 
-            g_pHyprOpenGL->renderTexture(pTitleTex->tex, &rect, 1.f);
+            g_pHyprOpenGL->renderTexture(*PTEX, &rect, 1.f);
         }
 
         xoff += BAR_HORIZONTAL_PADDING + m_fBarWidth;
     }
-
-    if (*PRENDERTITLES)
-        invalidateTextures();
-}
-
-CTitleTex* CHyprGroupBarDecoration::textureFromTitle(const std::string& title) {
-    for (auto& tex : m_sTitleTexs.titleTexs) {
-        if (tex->szContent == title)
-            return tex.get();
-    }
-
-    return nullptr;
-}
-
-void CHyprGroupBarDecoration::invalidateTextures() {
-    m_sTitleTexs.titleTexs.clear();
-}
-
-CTitleTex::CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize) {
-    szContent                 = pWindow->m_szTitle;
-    pWindowOwner              = pWindow;
-    const auto   CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, bufferSize.x, bufferSize.y);
-    const auto   CAIRO        = cairo_create(CAIROSURFACE);
-
-    static auto  PTITLEFONTFAMILY = CConfigValue<std::string>("group:groupbar:font_family");
-    static auto  PTITLEFONTSIZE   = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
-    static auto  PTEXTCOLOR       = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
-
-    const CColor COLOR = CColor(*PTEXTCOLOR);
-
-    // clear the pixmap
-    cairo_save(CAIRO);
-    cairo_set_operator(CAIRO, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(CAIRO);
-    cairo_restore(CAIRO);
-
-    // draw title using Pango
-    PangoLayout* layout = pango_cairo_create_layout(CAIRO);
-    pango_layout_set_text(layout, szContent.c_str(), -1);
-
-    PangoFontDescription* fontDesc = pango_font_description_from_string((*PTITLEFONTFAMILY).c_str());
-    pango_font_description_set_size(fontDesc, *PTITLEFONTSIZE * PANGO_SCALE);
-    pango_layout_set_font_description(layout, fontDesc);
-    pango_font_description_free(fontDesc);
-
-    const int maxWidth = bufferSize.x;
-
-    pango_layout_set_width(layout, maxWidth * PANGO_SCALE);
-    pango_layout_set_ellipsize(layout, PANGO_ELLIPSIZE_END);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
-    int layoutWidth, layoutHeight;
-    pango_layout_get_size(layout, &layoutWidth, &layoutHeight);
-    const int xOffset = std::round((bufferSize.x / 2.0 - layoutWidth / PANGO_SCALE / 2.0));
-    const int yOffset = std::round((bufferSize.y / 2.0 - layoutHeight / PANGO_SCALE / 2.0));
-
-    cairo_move_to(CAIRO, xOffset, yOffset);
-    pango_cairo_show_layout(CAIRO, layout);
-
-    g_object_unref(layout);
-
-    cairo_surface_flush(CAIROSURFACE);
-
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    tex.allocate();
-    glBindTexture(GL_TEXTURE_2D, tex.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bufferSize.x, bufferSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    // delete cairo
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
-}
-
-CTitleTex::~CTitleTex() {
-    tex.destroyTexture();
-}
-
-void renderGradientTo(CTexture& tex, CGradientValueData* grad) {
-
-    if (!g_pCompositor->m_pLastMonitor)
-        return;
-
-    const Vector2D& bufferSize = g_pCompositor->m_pLastMonitor->vecPixelSize;
-
-    const auto      CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, bufferSize.x, bufferSize.y);
-    const auto      CAIRO        = cairo_create(CAIROSURFACE);
-
-    // clear the pixmap
-    cairo_save(CAIRO);
-    cairo_set_operator(CAIRO, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(CAIRO);
-    cairo_restore(CAIRO);
-
-    cairo_pattern_t* pattern;
-    pattern = cairo_pattern_create_linear(0, 0, 0, bufferSize.y);
-
-    for (unsigned long i = 0; i < grad->m_vColors.size(); i++) {
-        cairo_pattern_add_color_stop_rgba(pattern, 1 - (double)(i + 1) / (grad->m_vColors.size() + 1), grad->m_vColors[i].r, grad->m_vColors[i].g, grad->m_vColors[i].b,
-                                          grad->m_vColors[i].a);
-    }
-
-    cairo_rectangle(CAIRO, 0, 0, bufferSize.x, bufferSize.y);
-    cairo_set_source(CAIRO, pattern);
-    cairo_fill(CAIRO);
-    cairo_pattern_destroy(pattern);
-
-    cairo_surface_flush(CAIROSURFACE);
-
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    tex.allocate();
-    glBindTexture(GL_TEXTURE_2D, tex.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bufferSize.x, bufferSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    // delete cairo
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
-}
-
-void refreshGroupBarGradients() {
-    static auto PGRADIENTS = CConfigValue<Hyprlang::INT>("group:groupbar:enabled");
-    static auto PENABLED   = CConfigValue<Hyprlang::INT>("group:groupbar:gradients");
-
-    static auto PGROUPCOLACTIVE         = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:col.active");
-    static auto PGROUPCOLINACTIVE       = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:col.inactive");
-    static auto PGROUPCOLACTIVELOCKED   = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:col.locked_active");
-    static auto PGROUPCOLINACTIVELOCKED = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:col.locked_inactive");
-    auto* const GROUPCOLACTIVE          = (CGradientValueData*)(PGROUPCOLACTIVE.ptr())->getData();
-    auto* const GROUPCOLINACTIVE        = (CGradientValueData*)(PGROUPCOLINACTIVE.ptr())->getData();
-    auto* const GROUPCOLACTIVELOCKED    = (CGradientValueData*)(PGROUPCOLACTIVELOCKED.ptr())->getData();
-    auto* const GROUPCOLINACTIVELOCKED  = (CGradientValueData*)(PGROUPCOLINACTIVELOCKED.ptr())->getData();
-
-    g_pHyprRenderer->makeEGLCurrent();
-
-    if (m_tGradientActive.m_iTexID != 0) {
-        m_tGradientActive.destroyTexture();
-        m_tGradientInactive.destroyTexture();
-        m_tGradientLockedActive.destroyTexture();
-        m_tGradientLockedInactive.destroyTexture();
-    }
-
-    if (!*PENABLED || !*PGRADIENTS)
-        return;
-
-    renderGradientTo(m_tGradientActive, GROUPCOLACTIVE);
-    renderGradientTo(m_tGradientInactive, GROUPCOLINACTIVE);
-    renderGradientTo(m_tGradientLockedActive, GROUPCOLACTIVELOCKED);
-    renderGradientTo(m_tGradientLockedInactive, GROUPCOLINACTIVELOCKED);
 }
 
 bool CHyprGroupBarDecoration::onBeginWindowDragOnDeco(const Vector2D& pos) {
@@ -2,21 +2,7 @@
 
 #include "IHyprWindowDecoration.hpp"
 #include <deque>
-#include "../Texture.hpp"
 #include <string>
-#include <memory>
-
-class CTitleTex {
-  public:
-    CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize);
-    ~CTitleTex();
-
-    CTexture     tex;
-    std::string  szContent;
-    PHLWINDOWREF pWindowOwner;
-};
-
-void refreshGroupBarGradients();
 
 class CHyprGroupBarDecoration : public IHyprWindowDecoration {
   public:
@@ -54,18 +40,10 @@ class CHyprGroupBarDecoration : public IHyprWindowDecoration {
 
     float                    m_fBarWidth;
 
-    CTitleTex*               textureFromTitle(const std::string&);
-    void                     invalidateTextures();
-
     CBox                     assignedBoxGlobal();
 
     bool                     onBeginWindowDragOnDeco(const Vector2D&);
     bool                     onEndWindowDragOnDeco(const Vector2D&, PHLWINDOW);
     bool                     onMouseButtonOnDeco(const Vector2D&, wlr_pointer_button_event*);
     bool                     onScrollOnDeco(const Vector2D&, wlr_pointer_axis_event*);
-
-    struct STitleTexs {
-        // STitleTexs*                            overriden = nullptr; // TODO: make shit shared in-group to decrease VRAM usage.
-        std::deque<std::unique_ptr<CTitleTex>> titleTexs;
-    } m_sTitleTexs;
 };
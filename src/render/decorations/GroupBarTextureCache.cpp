@@ -0,0 +1,187 @@
+#include "GroupBarTextureCache.hpp"
+#include "../../Compositor.hpp"
+#include "../../config/ConfigValue.hpp"
+#include "../../config/ConfigDataValues.hpp"
+#include <pango/pangocairo.h>
+
+// a title is ~30KB at 1x, this fits a few hundred of them
+constexpr size_t MAX_CACHE_BYTES = 16 * 1024 * 1024;
+
+CGroupBarTextureCache::~CGroupBarTextureCache() {
+    clear();
+}
+
+CTexture* CGroupBarTextureCache::lookup(const std::string& key) {
+    const auto IT = m_mEntries.find(key);
+
+    if (IT == m_mEntries.end()) {
+        m_iMisses++;
+        return nullptr;
+    }
+
+    m_iHits++;
+    m_lEntries.splice(m_lEntries.begin(), m_lEntries, IT->second);
+    return &IT->second->tex;
+}
+
+CTexture* CGroupBarTextureCache::insert(const std::string& key, cairo_surface_t* surface, const Vector2D& size) {
+    auto& entry = m_lEntries.emplace_front();
+    entry.key   = key;
+    entry.bytes = size.x * size.y * 4;
+
+    cairo_surface_flush(surface);
+
+    // copy the data to an OpenGL texture we have
+    const auto DATA = cairo_image_surface_get_data(surface);
+    entry.tex.allocate();
+    glBindTexture(GL_TEXTURE_2D, entry.tex.m_iTexID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+#ifndef GLES2
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+#endif
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    entry.tex.m_vSize = size;
+
+    m_mEntries[key] = m_lEntries.begin();
+    m_iBytes += entry.bytes;
+
+    // never evict what we're about to return
+    while (m_iBytes > MAX_CACHE_BYTES && m_lEntries.size() > 1) {
+        auto& last = m_lEntries.back();
+        last.tex.destroyTexture();
+        m_iBytes -= last.bytes;
+        m_mEntries.erase(last.key);
+        m_lEntries.pop_back();
+        m_iEvictions++;
+    }
+
+    return &entry.tex;
+}
+
+CTexture* CGroupBarTextureCache::title(const std::string& title, const Vector2D& bufferSize) {
+    static auto PTITLEFONTFAMILY = CConfigValue<std::string>("group:groupbar:font_family");
+    static auto PTITLEFONTSIZE   = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
+    static auto PTEXTCOLOR       = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
+
+    const auto  SIZE = Vector2D{std::max(1.0, std::round(bufferSize.x)), std::max(1.0, std::round(bufferSize.y))};
+
+    // the buffer size carries the monitor scale
+    const auto KEY = std::format("title:{}:{}:{:x}:{}x{}:{}", *PTITLEFONTFAMILY, *PTITLEFONTSIZE, (uint32_t)*PTEXTCOLOR, (int)SIZE.x, (int)SIZE.y, title);
+
+    if (const auto TEX = lookup(KEY); TEX)
+        return TEX;
+
+    const CColor COLOR = CColor(*PTEXTCOLOR);
+
+    const auto   CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, SIZE.x, SIZE.y);
+    const auto   CAIRO        = cairo_create(CAIROSURFACE);
+
+    // clear the pixmap
+    cairo_save(CAIRO);
+    cairo_set_operator(CAIRO, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(CAIRO);
+    cairo_restore(CAIRO);
+
+    // draw title using Pango
+    PangoLayout* layout = pango_cairo_create_layout(CAIRO);
+    pango_layout_set_text(layout, title.c_str(), -1);
+
+    PangoFontDescription* fontDesc = pango_font_description_from_string((*PTITLEFONTFAMILY).c_str());
+    pango_font_description_set_size(fontDesc, *PTITLEFONTSIZE * PANGO_SCALE);
+    pango_layout_set_font_description(layout, fontDesc);
+    pango_font_description_free(fontDesc);
+
+    const int maxWidth = SIZE.x;
+
+    pango_layout_set_width(layout, maxWidth * PANGO_SCALE);
+    pango_layout_set_ellipsize(layout, PANGO_ELLIPSIZE_END);
+
+    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+
+    int layoutWidth, layoutHeight;
+    pango_layout_get_size(layout, &layoutWidth, &layoutHeight);
+    const int xOffset = std::round((SIZE.x / 2.0 - layoutWidth / PANGO_SCALE / 2.0));
+    const int yOffset = std::round((SIZE.y / 2.0 - layoutHeight / PANGO_SCALE / 2.0));
+
+    cairo_move_to(CAIRO, xOffset, yOffset);
+    pango_cairo_show_layout(CAIRO, layout);
+
+    g_object_unref(layout);
+
+    const auto TEX = insert(KEY, CAIROSURFACE, SIZE);
+
+    // delete cairo
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+
+    return TEX;
+}
+
+CTexture* CGroupBarTextureCache::gradient(const CGradientValueData& grad, int height) {
+    height = std::max(height, 1);
+
+    // the bar is drawn top to bottom whatever the angle, so only the colors go in the key
+    std::string key = std::format("gradient:{}:", height);
+    for (auto& c : grad.m_vColors) {
+        key += std::format("{},{},{},{} ", c.r, c.g, c.b, c.a);
+    }
+
+    if (const auto TEX = lookup(key); TEX)
+        return TEX;
+
+    // the gradient is vertical, one column stretched over the bar looks the same as a full width one
+    const Vector2D SIZE = {1, (double)height};
+
+    const auto     CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, SIZE.x, SIZE.y);
+    const auto     CAIRO        = cairo_create(CAIROSURFACE);
+
+    // clear the pixmap
+    cairo_save(CAIRO);
+    cairo_set_operator(CAIRO, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(CAIRO);
+    cairo_restore(CAIRO);
+
+    cairo_pattern_t* pattern;
+    pattern = cairo_pattern_create_linear(0, 0, 0, SIZE.y);
+
+    for (unsigned long i = 0; i < grad.m_vColors.size(); i++) {
+        cairo_pattern_add_color_stop_rgba(pattern, 1 - (double)(i + 1) / (grad.m_vColors.size() + 1), grad.m_vColors[i].r, grad.m_vColors[i].g, grad.m_vColors[i].b,
+                                          grad.m_vColors[i].a);
+    }
+
+    cairo_rectangle(CAIRO, 0, 0, SIZE.x, SIZE.y);
+    cairo_set_source(CAIRO, pattern);
+    cairo_fill(CAIRO);
+    cairo_pattern_destroy(pattern);
+
+    const auto TEX = insert(key, CAIROSURFACE, SIZE);
+
+    // delete cairo
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+
+    return TEX;
+}
+
+void CGroupBarTextureCache::clear() {
+    if (m_lEntries.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    for (auto& entry : m_lEntries) {
+        entry.tex.destroyTexture();
+    }
+
+    m_lEntries.clear();
+    m_mEntries.clear();
+    m_iBytes = 0;
+}
+
+CGroupBarTextureCache::SStats CGroupBarTextureCache::stats() const {
+    return SStats{m_iHits, m_iMisses, m_iEvictions, m_lEntries.size(), m_iBytes, MAX_CACHE_BYTES};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../../defines.hpp"
+#include "../Texture.hpp"
+#include <cairo/cairo.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+class CGradientValueData;
+
+/*
+    Rasterized group bar titles and gradients, shared by all group bars on all monitors.
+    Entries are keyed by everything that affects how they look, so identical titles are only
+    rasterized once. The least recently used entries are dropped once the cache grows over its budget.
+*/
+class CGroupBarTextureCache {
+  public:
+    ~CGroupBarTextureCache();
+
+    // The returned texture is valid until the next lookup, as that might evict it.
+    CTexture* title(const std::string& title, const Vector2D& bufferSize);
+    CTexture* gradient(const CGradientValueData& grad, int height);
+
+    // drops everything, e.g. after a config reload
+    void clear();
+
+    struct SStats {
+        uint64_t hits      = 0;
+        uint64_t misses    = 0;
+        uint64_t evictions = 0;
+        size_t   entries   = 0;
+        size_t   bytes     = 0;
+        size_t   budget    = 0;
+    };
+
+    SStats stats() const;
+
+  private:
+    struct SEntry {
+        std::string key;
+        CTexture    tex;
+        size_t      bytes = 0;
+    };
+
+    CTexture*                                                    lookup(const std::string& key);
+    CTexture*                                                    insert(const std::string& key, cairo_surface_t* surface, const Vector2D& size);
+
+    std::list<SEntry>                                            m_lEntries; // most recently used first
+    std::unordered_map<std::string, std::list<SEntry>::iterator> m_mEntries;
+    size_t                                                       m_iBytes = 0;
+
+    uint64_t                                                     m_iHits      = 0;
+    uint64_t                                                     m_iMisses    = 0;
+    uint64_t                                                     m_iEvictions = 0;
+};
+
+inline std::unique_ptr<CGroupBarTextureCache> g_pGroupBarTextureCache;
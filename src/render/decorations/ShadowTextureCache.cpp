@@ -0,0 +1,127 @@
+#include "ShadowTextureCache.hpp"
+#include "../../Compositor.hpp"
+
+// a texture is a few KB at most, this is plenty for every rounding / monitor scale combination in use
+constexpr size_t MAX_CACHE_ENTRIES = 32;
+
+CShadowTextureCache::~CShadowTextureCache() {
+    clear();
+}
+
+CTexture* CShadowTextureCache::get(int range, int rounding, int power, bool hole) {
+    const auto IT = std::find_if(m_lEntries.begin(), m_lEntries.end(),
+                                 [&](const auto& e) { return e.range == range && e.rounding == rounding && e.power == power && e.hole == hole; });
+
+    if (IT != m_lEntries.end()) {
+        m_lEntries.splice(m_lEntries.begin(), m_lEntries, IT);
+        return &m_lEntries.front().tex;
+    }
+
+    auto& entry    = m_lEntries.emplace_front();
+    entry.range    = range;
+    entry.rounding = rounding;
+    entry.power    = power;
+    entry.hole     = hole;
+
+    rasterize(entry);
+
+    while (m_lEntries.size() > MAX_CACHE_ENTRIES) {
+        m_lEntries.back().tex.destroyTexture();
+        m_lEntries.pop_back();
+    }
+
+    return &entry.tex;
+}
+
+void CShadowTextureCache::rasterize(SEntry& entry) {
+    const double RANGE  = entry.range;
+    const double RADIUS = entry.range + entry.rounding;
+    const int    CORNER = entry.range + entry.rounding;
+    const int    SIZE   = 2 * CORNER + 1;
+
+    // same falloff as the shadow shader, with the corners at CORNER and a 1px stretchable middle
+    const auto alphaFromDistance = [&](double distanceToCorner) -> double {
+        if (distanceToCorner > RADIUS)
+            return 0.0;
+
+        if (distanceToCorner > RADIUS - RANGE)
+            return std::pow((RADIUS - distanceToCorner) / RANGE, entry.power);
+
+        return 1.0;
+    };
+
+    const auto shadowAlpha = [&](const Vector2D& pos) -> double {
+        const double TL = CORNER, BR = CORNER + 1;
+
+        if (pos.x < TL || pos.x > BR) {
+            const double CX = pos.x < TL ? TL : BR;
+
+            if (pos.y < TL)
+                return alphaFromDistance(pos.distance({CX, TL}));
+            if (pos.y > BR)
+                return alphaFromDistance(pos.distance({CX, BR}));
+        }
+
+        const double SMALLEST = std::min(std::min(pos.y, SIZE - pos.y), std::min(pos.x, SIZE - pos.x));
+
+        if (SMALLEST < RANGE)
+            return std::pow(SMALLEST / RANGE, entry.power);
+
+        return 1.0;
+    };
+
+    // how much of the pixel is covered by the window's rounded box, antialiased over 1px
+    const auto holeCoverage = [&](const Vector2D& pos) -> double {
+        const double HALF = SIZE / 2.0 - RANGE - entry.rounding;
+        const double QX   = std::abs(pos.x - SIZE / 2.0) - HALF;
+        const double QY   = std::abs(pos.y - SIZE / 2.0) - HALF;
+        const double DIST = Vector2D{std::max(QX, 0.0), std::max(QY, 0.0)}.size() + std::min(std::max(QX, QY), 0.0) - entry.rounding;
+
+        return std::clamp(0.5 - DIST, 0.0, 1.0);
+    };
+
+    std::vector<uint8_t> data(SIZE * SIZE * 4);
+
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            const Vector2D POS = {x + 0.5, y + 0.5};
+
+            double         alpha = shadowAlpha(POS);
+            if (entry.hole)
+                alpha *= 1.0 - holeCoverage(POS);
+
+            // premultiplied white, the color comes from the tint when drawing
+            std::fill_n(&data[(y * SIZE + x) * 4], 4, (uint8_t)std::round(std::clamp(alpha, 0.0, 1.0) * 255.0));
+        }
+    }
+
+    entry.tex.allocate();
+    glBindTexture(GL_TEXTURE_2D, entry.tex.m_iTexID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SIZE, SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    entry.tex.m_vSize = {SIZE, SIZE};
+}
+
+void CShadowTextureCache::clear() {
+    if (m_lEntries.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    for (auto& entry : m_lEntries) {
+        entry.tex.destroyTexture();
+    }
+
+    m_lEntries.clear();
+}
+
+size_t CShadowTextureCache::bytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : m_lEntries) {
+        bytes += entry.tex.m_vSize.x * entry.tex.m_vSize.y * 4;
+    }
+    return bytes;
+}
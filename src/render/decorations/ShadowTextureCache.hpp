@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../../defines.hpp"
+#include "../Texture.hpp"
+#include <list>
+
+/*
+    Nine-slice textures of the drop shadow, white with the shadow's alpha falloff.
+    A texture only depends on the range, rounding and power, so windows sharing those share one texture,
+    and drawing it is a single small textured draw instead of running the shadow shader over the whole box.
+*/
+class CShadowTextureCache {
+  public:
+    ~CShadowTextureCache();
+
+    // range and rounding are in pixels. With hole, the window's rounded box (inset by range) is cut out.
+    // The corners are range + rounding pixels, the texture is 2 * corner + 1 in size.
+    // The returned texture is valid until the next get, as that might evict it.
+    CTexture* get(int range, int rounding, int power, bool hole);
+
+    // drops everything, e.g. after a config reload
+    void   clear();
+
+    size_t bytes() const;
+
+  private:
+    struct SEntry {
+        int      range    = 0;
+        int      rounding = 0;
+        int      power    = 0;
+        bool     hole     = false;
+        CTexture tex;
+    };
+
+    void              rasterize(SEntry& entry);
+
+    std::list<SEntry> m_lEntries; // most recently used first
+};
+
+inline std::unique_ptr<CShadowTextureCache> g_pShadowTextureCache;